@@ -207,6 +207,15 @@ int AppShell::run(int argc, char** argv)
 
     PROFILER_PRINT;
 
+    if (framework::Tracer::isEnabled()) {
+        std::string tracePath = framework::Tracer::instance()->outputPath();
+        if (framework::Tracer::instance()->stop()) {
+            LOGI() << "trace written to: " << tracePath;
+        } else {
+            LOGE() << "failed write trace to: " << tracePath;
+        }
+    }
+
     // Wait Thread Poll
 #ifndef Q_OS_WASM
     QThreadPool* globalThreadPool = QThreadPool::globalInstance();
@@ -231,7 +240,12 @@ int AppShell::run(int argc, char** argv)
 int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 {
     Ret ret;
-    if (task.isBatchMode) {
+    if (task.isBenchmarkMode) {
+        ret = converter()->benchmark(task.inputFile, task.outputFile, task.baselineFile, task.threshold);
+        if (!ret) {
+            LOGE() << "benchmark failed, error: " << ret.toString();
+        }
+    } else if (task.isBatchMode) {
         ret = converter()->batchConvert(task.inputFile);
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
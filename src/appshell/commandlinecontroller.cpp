@@ -35,11 +35,17 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
     m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    m_parser.addOption(QCommandLineOption("trace", "Record a performance trace in Chrome trace format (chrome://tracing, ui.perfetto.dev)",
+                                          "file"));
 
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption("benchmark", "Benchmark the scores of a job file, the report is written to 'file' given by -o "
+                                                       "(default: benchmark.json)", "file"));
+    m_parser.addOption(QCommandLineOption("benchmark-baseline", "Compare the benchmark with a baseline report", "file"));
+    m_parser.addOption(QCommandLineOption("benchmark-threshold", "Slowdown in percent reported as regression (default: 10)", "percent"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
 
@@ -70,6 +76,10 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("trace")) {
+        Tracer::instance()->start(m_parser.value("trace").toStdString());
+    }
+
     // Converter mode
     if (m_parser.isSet("r")) {
         std::optional<float> val = floatValue("r");
@@ -80,7 +90,7 @@ void CommandLineController::apply()
         }
     }
 
-    if (m_parser.isSet("o")) {
+    if (m_parser.isSet("o") && !m_parser.isSet("benchmark")) {
         application()->setRunMode(IApplication::RunMode::Converter);
         if (scorefiles.size() < 1) {
             LOGE() << "Option: -o no input file specified";
@@ -99,6 +109,22 @@ void CommandLineController::apply()
         m_converterTask.inputFile = m_parser.value("j");
     }
 
+    if (m_parser.isSet("benchmark")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.isBenchmarkMode = true;
+        m_converterTask.inputFile = m_parser.value("benchmark");
+        m_converterTask.outputFile = m_parser.isSet("o") ? m_parser.value("o") : QString("benchmark.json");
+        m_converterTask.baselineFile = m_parser.value("benchmark-baseline");
+        if (m_parser.isSet("benchmark-threshold")) {
+            std::optional<float> val = floatValue("benchmark-threshold");
+            if (val) {
+                m_converterTask.threshold = val.value();
+            } else {
+                LOGE() << "Option: --benchmark-threshold not recognized value: " << m_parser.value("benchmark-threshold");
+            }
+        }
+    }
+
     if (m_parser.isSet("F") || m_parser.isSet("R")) {
         configuration()->revertToFactorySettings(m_parser.isSet("R"));
     }
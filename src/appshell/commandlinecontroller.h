@@ -44,8 +44,11 @@ public:
 
     struct ConverterTask {
         bool isBatchMode = false;
+        bool isBenchmarkMode = false;
         QString inputFile;
         QString outputFile;
+        QString baselineFile;
+        double threshold = 10.0;
     };
 
     void parse(const QStringList& args);
@@ -44,6 +44,14 @@ void GeneralPreferencesModel::load()
     telemetryConfiguration()->isTelemetryAllowed().ch.onReceive(this, [this](bool) {
         emit isTelemetryAllowedChanged(isTelemetryAllowed());
     });
+
+    userScoresConfiguration()->autoSaveEnabledChanged().onReceive(this, [this](bool enabled) {
+        emit isAutoSaveChanged(enabled);
+    });
+
+    userScoresConfiguration()->autoSaveIntervalChanged().onReceive(this, [this](int minutes) {
+        emit autoSavePeriodChanged(minutes);
+    });
 }
 
 void GeneralPreferencesModel::openUpdateTranslationsPage()
@@ -89,12 +97,12 @@ bool GeneralPreferencesModel::isTelemetryAllowed() const
 
 bool GeneralPreferencesModel::isAutoSave() const
 {
-    return false;
+    return userScoresConfiguration()->isAutoSaveEnabled();
 }
 
 int GeneralPreferencesModel::autoSavePeriod() const
 {
-    return 0;
+    return userScoresConfiguration()->autoSaveIntervalMinutes();
 }
 
 bool GeneralPreferencesModel::isOSCRemoteControl() const
@@ -129,13 +137,21 @@ void GeneralPreferencesModel::setIsTelemetryAllowed(bool isTelemetryAllowed)
 
 void GeneralPreferencesModel::setIsAutoSave(bool isAutoSave)
 {
-    NOT_IMPLEMENTED;
+    if (isAutoSave == this->isAutoSave()) {
+        return;
+    }
+
+    userScoresConfiguration()->setAutoSaveEnabled(isAutoSave);
     emit isAutoSaveChanged(isAutoSave);
 }
 
 void GeneralPreferencesModel::setAutoSavePeriod(int autoSavePeriod)
 {
-    NOT_IMPLEMENTED;
+    if (autoSavePeriod == this->autoSavePeriod()) {
+        return;
+    }
+
+    userScoresConfiguration()->setAutoSaveInterval(autoSavePeriod);
     emit autoSavePeriodChanged(autoSavePeriod);
 }
 
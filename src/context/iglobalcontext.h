@@ -25,6 +25,7 @@
 #include "modularity/imoduleexport.h"
 #include "notation/imasternotation.h"
 #include "async/notification.h"
+#include "async/channel.h"
 
 namespace mu::context {
 class IGlobalContext : MODULE_EXPORT_INTERFACE
@@ -38,6 +39,7 @@ public:
     virtual void removeMasterNotation(const notation::IMasterNotationPtr& notation) = 0;
     virtual const std::vector<notation::IMasterNotationPtr>& masterNotations() const = 0;
     virtual bool containsMasterNotation(const io::path& path) const = 0;
+    virtual async::Channel<notation::IMasterNotationPtr> masterNotationRemoved() const = 0;
 
     virtual void setCurrentMasterNotation(const notation::IMasterNotationPtr& notation) = 0;
     virtual notation::IMasterNotationPtr currentMasterNotation() const = 0;
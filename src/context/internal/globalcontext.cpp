@@ -33,6 +33,7 @@ void GlobalContext::addMasterNotation(const IMasterNotationPtr& notation)
 void GlobalContext::removeMasterNotation(const IMasterNotationPtr& notation)
 {
     m_masterNotations.erase(std::remove(m_masterNotations.begin(), m_masterNotations.end(), notation), m_masterNotations.end());
+    m_masterNotationRemoved.send(notation);
 }
 
 const std::vector<IMasterNotationPtr>& GlobalContext::masterNotations() const
@@ -40,6 +41,11 @@ const std::vector<IMasterNotationPtr>& GlobalContext::masterNotations() const
     return m_masterNotations;
 }
 
+Channel<IMasterNotationPtr> GlobalContext::masterNotationRemoved() const
+{
+    return m_masterNotationRemoved;
+}
+
 bool GlobalContext::containsMasterNotation(const io::path& path) const
 {
     for (const auto& n : m_masterNotations) {
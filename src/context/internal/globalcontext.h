@@ -32,6 +32,7 @@ public:
     void removeMasterNotation(const notation::IMasterNotationPtr& notation) override;
     const std::vector<notation::IMasterNotationPtr>& masterNotations() const override;
     bool containsMasterNotation(const io::path& path) const override;
+    async::Channel<notation::IMasterNotationPtr> masterNotationRemoved() const override;
 
     void setCurrentMasterNotation(const notation::IMasterNotationPtr& notation) override;
     notation::IMasterNotationPtr currentMasterNotation() const override;
@@ -45,6 +46,7 @@ private:
     void doSetCurrentNotation(const notation::INotationPtr& notation);
 
     std::vector<notation::IMasterNotationPtr> m_masterNotations;
+    async::Channel<notation::IMasterNotationPtr> m_masterNotationRemoved;
 
     notation::IMasterNotationPtr m_currentMasterNotation;
     async::Notification m_currentMasterNotationChanged;
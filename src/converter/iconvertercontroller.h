@@ -35,6 +35,12 @@ public:
 
     virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
     virtual Ret batchConvert(const io::path& batchJobFile) = 0;
+
+    //! NOTE Benchmarks the scores of a job file (the "in" of each job, or a list of paths)
+    //! and writes the results as JSON. If a baseline is given, steps slower than it
+    //! by more than the threshold (in percent) are reported as regressions.
+    virtual Ret benchmark(const io::path& jobFile, const io::path& reportFile,
+                          const io::path& baselineFile = io::path(), double threshold = 10.0) = 0;
 };
 }
 
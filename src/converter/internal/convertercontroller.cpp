@@ -30,9 +30,12 @@
 #include "log.h"
 #include "convertercodes.h"
 #include "stringutils.h"
+#include "scorebenchmark.h"
 
 using namespace mu::converter;
 
+static constexpr int BENCHMARK_REPORT_VERSION = 2;
+
 mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
 {
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
@@ -79,7 +82,13 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
         return make_ret(Err::OutFileFailedOpen);
     }
 
-    ret = writer->write(masterNotation->notation(), file);
+    {
+        framework::TraceSpan span("export");
+        if (span.isActive()) {
+            span.arg("path", out.toStdString());
+        }
+        ret = writer->write(masterNotation->notation(), file);
+    }
     if (!ret) {
         LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
         return make_ret(Err::OutFileFailedWrite);
@@ -90,7 +99,71 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
     return make_ret(Ret::Code::Ok);
 }
 
-mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile) const
+mu::Ret ConverterController::benchmark(const io::path& jobFile, const io::path& reportFile,
+                                       const io::path& baselineFile, double threshold)
+{
+    TRACEFUNC;
+
+    RetVal<BatchJob> batchJob = parseBatchJob(jobFile, false);
+    if (!batchJob.ret) {
+        LOGE() << "failed parse benchmark job file, err: " << batchJob.ret.toString();
+        return batchJob.ret;
+    }
+
+    ScoreBenchmark scoreBenchmark;
+    QJsonArray scores;
+    for (const Job& job : batchJob.val) {
+        LOGI() << "benchmark: " << job.in;
+        scores.append(scoreBenchmark.run(job.in));
+    }
+
+    QJsonObject report;
+    report["version"] = BENCHMARK_REPORT_VERSION;
+    report["scores"] = scores;
+    report["peakRssKb"] = static_cast<qint64>(ScoreBenchmark::peakRssKb());
+
+    Ret ret = make_ret(Ret::Code::Ok);
+    if (!baselineFile.empty()) {
+        QFile baseline(baselineFile.toQString());
+        if (!baseline.open(QIODevice::ReadOnly)) {
+            return make_ret(Err::BenchmarkBaselineFailedOpen);
+        }
+
+        QJsonObject baselineReport = QJsonDocument::fromJson(baseline.readAll()).object();
+        if (baselineReport["version"].toInt() != BENCHMARK_REPORT_VERSION) {
+            LOGW() << "benchmark baseline has a different version, results may not be comparable";
+        }
+
+        QJsonArray regressions = ScoreBenchmark::compare(baselineReport, report, threshold);
+        for (const QJsonValue r : regressions) {
+            QJsonObject obj = r.toObject();
+            LOGW() << "regression: " << obj["file"].toString() << " " << obj["step"].toString()
+                   << ", baseline: " << obj["baselineMs"].toDouble() << " ms"
+                   << ", current: " << obj["currentMs"].toDouble() << " ms";
+        }
+
+        report["baseline"] = baselineFile.toQString();
+        report["threshold"] = threshold;
+        report["regressions"] = regressions;
+
+        if (!regressions.isEmpty()) {
+            ret = make_ret(Err::BenchmarkRegression);
+        }
+    }
+
+    QFile file(reportFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    if (file.write(QJsonDocument(report).toJson()) < 0) {
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return ret;
+}
+
+mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile, bool requireOut) const
 {
     RetVal<BatchJob> rv;
     QFile file(batchJobFile.toQString());
@@ -110,13 +183,16 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     QJsonArray arr = doc.array();
 
     for (const QJsonValue v : arr) {
-        QJsonObject obj = v.toObject();
-
         Job job;
-        job.in = obj["in"].toString();
-        job.out = obj["out"].toString();
+        if (v.isString()) {
+            job.in = v.toString();
+        } else {
+            QJsonObject obj = v.toObject();
+            job.in = obj["in"].toString();
+            job.out = obj["out"].toString();
+        }
 
-        if (!job.in.empty() && !job.out.empty()) {
+        if (!job.in.empty() && (!job.out.empty() || !requireOut)) {
             rv.val.push_back(std::move(job));
         }
     }
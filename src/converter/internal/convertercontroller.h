@@ -43,6 +43,8 @@ public:
 
     Ret fileConvert(const io::path& in, const io::path& out) override;
     Ret batchConvert(const io::path& batchJobFile) override;
+    Ret benchmark(const io::path& jobFile, const io::path& reportFile,
+                  const io::path& baselineFile = io::path(), double threshold = 10.0) override;
 
 private:
 
@@ -53,7 +55,7 @@ private:
 
     using BatchJob = std::list<Job>;
 
-    RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+    RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile, bool requireOut = true) const;
 };
 }
 
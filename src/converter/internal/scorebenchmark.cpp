@@ -0,0 +1,239 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scorebenchmark.h"
+
+#include <functional>
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#if defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/synthesizerstate.h"
+#include "framework/midi_old/event.h"
+
+#include "log.h"
+
+using namespace mu::converter;
+using namespace mu::notation;
+
+//! NOTE Differences below this are noise for a single run
+static constexpr double MIN_REGRESSION_MS = 5.0;
+
+quint64 ScoreBenchmark::currentRssKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize / 1024;
+    }
+    return 0;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size / 1024;
+#else
+    //! NOTE The second field of statm is the number of resident pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return 0;
+    }
+    return fields.at(1).toULongLong() * static_cast<quint64>(sysconf(_SC_PAGESIZE)) / 1024;
+#endif
+}
+
+quint64 ScoreBenchmark::peakRssKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss / 1024; // bytes
+#else
+    return usage.ru_maxrss; // kilobytes
+#endif
+#endif
+}
+
+QJsonObject ScoreBenchmark::run(const io::path& scorePath) const
+{
+    QJsonObject result;
+    result["file"] = scorePath.toQString();
+
+    QJsonObject steps;
+    auto measure = [&steps](const char* name, const std::function<bool()>& func) {
+        quint64 rssBefore = currentRssKb();
+        QElapsedTimer timer;
+        timer.start();
+        bool ok = func();
+        QJsonObject step;
+        step["timeMs"] = timer.nsecsElapsed() / 1000000.0;
+        step["rssBeforeKb"] = static_cast<qint64>(rssBefore);
+        step["rssAfterKb"] = static_cast<qint64>(currentRssKb());
+        if (!ok) {
+            step["failed"] = true;
+        }
+        steps[name] = step;
+        return ok;
+    };
+
+    IMasterNotationPtr masterNotation = notationCreator()->newMasterNotation();
+    IF_ASSERT_FAILED(masterNotation) {
+        result["error"] = "failed create notation";
+        return result;
+    }
+
+    bool loaded = measure("load", [masterNotation, scorePath]() {
+        return bool(masterNotation->load(scorePath));
+    });
+
+    if (!loaded) {
+        result["error"] = "failed load";
+        result["steps"] = steps;
+        return result;
+    }
+
+    INotationPtr notation = masterNotation->notation();
+    Ms::MasterScore* score = notation->elements()->msScore()->masterScore();
+
+    result["measures"] = score->nmeasures();
+    result["staves"] = score->nstaves();
+
+    measure("layout", [score]() {
+        score->doLayout();
+        return true;
+    });
+
+    measure("midi", [score]() {
+        Ms::EventMap events;
+        score->renderMidi(&events, Ms::SynthesizerState());
+        return true;
+    });
+
+    for (const char* suffix : { "png", "pdf", "musicxml" }) {
+        INotationWriterPtr writer = writers()->writer(suffix);
+        if (!writer) {
+            LOGW() << "not found writer for: " << suffix;
+            continue;
+        }
+
+        std::string name = std::string("export_") + suffix;
+        measure(name.c_str(), [writer, notation]() {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            return bool(writer->write(notation, buffer));
+        });
+    }
+
+    //! NOTE Scripted edit: change the stretch of the first measure,
+    //! this relayouts from the first system on
+    measure("relayout", [score]() {
+        Ms::Measure* m = score->firstMeasure();
+        if (!m) {
+            return false;
+        }
+        score->startCmd();
+        m->undoChangeProperty(Ms::Pid::USER_STRETCH, m->userStretch() * 1.5);
+        score->endCmd();
+        return true;
+    });
+
+    measure("save", [score, scorePath]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QString name = QFileInfo(scorePath.toQString()).completeBaseName() + ".mscx";
+        return score->saveCompressedFile(&buffer, name, false);
+    });
+
+    result["steps"] = steps;
+    return result;
+}
+
+QJsonArray ScoreBenchmark::compare(const QJsonObject& baseline, const QJsonObject& current, double threshold)
+{
+    QHash<QString, QJsonObject> baselineScores;
+    for (const QJsonValue s : baseline["scores"].toArray()) {
+        QJsonObject obj = s.toObject();
+        baselineScores.insert(obj["file"].toString(), obj["steps"].toObject());
+    }
+
+    QJsonArray regressions;
+    for (const QJsonValue s : current["scores"].toArray()) {
+        QJsonObject obj = s.toObject();
+        QString file = obj["file"].toString();
+        if (!baselineScores.contains(file)) {
+            continue;
+        }
+
+        QJsonObject baselineSteps = baselineScores.value(file);
+        QJsonObject steps = obj["steps"].toObject();
+        for (auto it = steps.begin(); it != steps.end(); ++it) {
+            if (!baselineSteps.contains(it.key())) {
+                continue;
+            }
+
+            double baseMs = baselineSteps[it.key()].toObject()["timeMs"].toDouble();
+            double curMs = it.value().toObject()["timeMs"].toDouble();
+            if (curMs - baseMs < MIN_REGRESSION_MS || curMs <= baseMs * (1.0 + threshold / 100.0)) {
+                continue;
+            }
+
+            QJsonObject r;
+            r["file"] = file;
+            r["step"] = it.key();
+            r["baselineMs"] = baseMs;
+            r["currentMs"] = curMs;
+            r["ratio"] = baseMs > 0 ? curMs / baseMs : 0.0;
+            regressions.append(r);
+        }
+    }
+
+    return regressions;
+}
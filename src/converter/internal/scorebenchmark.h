@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_SCOREBENCHMARK_H
+#define MU_CONVERTER_SCOREBENCHMARK_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "modularity/ioc.h"
+#include "notation/inotationcreator.h"
+#include "notation/inotationwritersregister.h"
+
+#include "retval.h"
+
+namespace mu::converter {
+//! NOTE Measures wall time and resident memory of the main operations on a score:
+//! load, full layout, MIDI render, export (png, pdf, musicxml), relayout after an edit and save.
+//! Each step records the current RSS before and after it. Peak RSS is the high water mark
+//! of the whole process, so it is only meaningful once per run.
+class ScoreBenchmark
+{
+    INJECT(converter, notation::INotationCreator, notationCreator)
+    INJECT(converter, notation::INotationWritersRegister, writers)
+
+public:
+    ScoreBenchmark() = default;
+
+    QJsonObject run(const io::path& scorePath) const;
+
+    //! NOTE Returns steps that are slower than the baseline by more than threshold (in percent)
+    static QJsonArray compare(const QJsonObject& baseline, const QJsonObject& current, double threshold);
+
+    static quint64 currentRssKb();
+    static quint64 peakRssKb();
+};
+}
+
+#endif // MU_CONVERTER_SCOREBENCHMARK_H
@@ -159,6 +159,12 @@ void Mixer::process(float* outBuffer, unsigned int samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    framework::TraceSpan span("Mixer::process");
+    if (span.isActive()) {
+        span.arg("samples", samplesPerChannel);
+        span.arg("inputs", static_cast<int64_t>(m_inputList.size()));
+    }
+
     if (m_clock) {
         m_clock->forward(samplesPerChannel);
     }
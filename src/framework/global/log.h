@@ -24,6 +24,7 @@
 #define MU_FRAMEWORK_LOG_H
 
 #include "thirdparty/haw_profiler/src/profiler.h"
+#include "tracer.h"
 
 #ifndef HAW_LOGGER_QT_SUPPORT
 #define HAW_LOGGER_QT_SUPPORT
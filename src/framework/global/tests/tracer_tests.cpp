@@ -0,0 +1,118 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "tracer.h"
+
+using namespace mu::framework;
+
+class TracerTests : public ::testing::Test
+{
+public:
+};
+
+static QJsonArray readTraceEvents(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonArray();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object().value("traceEvents").toArray();
+}
+
+TEST_F(TracerTests, Tracer_Disabled)
+{
+    //! GIVEN Tracer is not started
+
+    //! WHEN Span is created
+    TraceSpan span("disabled");
+    span.arg("value", 1);
+
+    //! THEN Span does nothing
+    EXPECT_FALSE(Tracer::isEnabled());
+    EXPECT_FALSE(span.isActive());
+}
+
+TEST_F(TracerTests, Tracer_NestedSpans)
+{
+    //! GIVEN Tracer is recording to a file
+    QTemporaryDir dir;
+    QString path = dir.filePath("trace.json");
+    Tracer::instance()->start(path.toStdString());
+
+    //! WHEN Nested spans are created on two threads
+    {
+        TraceSpan outer("outer");
+        outer.arg("staves", 4).arg("score", std::string("Test \"score\""));
+        {
+            TRACESPAN("inner");
+        }
+    }
+
+    std::thread thread([]() {
+        TRACESPAN("worker");
+    });
+    thread.join();
+
+    EXPECT_TRUE(Tracer::instance()->stop());
+    EXPECT_FALSE(Tracer::isEnabled());
+
+    //! THEN The trace contains all spans, the inner one inside the outer one
+    QJsonArray events = readTraceEvents(path);
+
+    QJsonObject outer, inner, worker;
+    for (const QJsonValue v : events) {
+        QJsonObject e = v.toObject();
+        QString name = e.value("name").toString();
+        if (name == "outer") {
+            outer = e;
+        } else if (name == "inner") {
+            inner = e;
+        } else if (name == "worker") {
+            worker = e;
+        }
+    }
+
+    ASSERT_FALSE(outer.isEmpty());
+    ASSERT_FALSE(inner.isEmpty());
+    ASSERT_FALSE(worker.isEmpty());
+
+    EXPECT_EQ(outer.value("ph").toString(), QString("X"));
+    EXPECT_EQ(outer.value("tid"), inner.value("tid"));
+    EXPECT_NE(outer.value("tid"), worker.value("tid"));
+    EXPECT_LE(outer.value("ts").toDouble(), inner.value("ts").toDouble());
+    //! NOTE Timestamps are written with 0.1 us precision
+    EXPECT_GE(outer.value("ts").toDouble() + outer.value("dur").toDouble() + 0.2,
+              inner.value("ts").toDouble() + inner.value("dur").toDouble());
+
+    QJsonObject args = outer.value("args").toObject();
+    EXPECT_EQ(args.value("staves").toInt(), 4);
+    EXPECT_EQ(args.value("score").toString(), QString("Test \"score\""));
+}
@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "tracer.h"
+
+#include <chrono>
+#include <fstream>
+
+#include "runtime.h"
+
+using namespace mu::framework;
+
+static std::atomic<bool> s_enabled { false };
+
+//! NOTE Events are stored in chunks, the owner thread is the only writer.
+//! The number of events is published with release semantics, so the trace
+//! can be written while other threads are still recording.
+struct Tracer::ThreadBuffer {
+    struct Event {
+        const char* name = nullptr;
+        int64_t begin = 0;
+        int64_t end = 0;
+        std::string args;
+    };
+
+    struct Chunk {
+        static constexpr size_t SIZE = 1024;
+        Event events[SIZE];
+        std::atomic<size_t> count { 0 };
+        std::atomic<Chunk*> next { nullptr };
+    };
+
+    uint32_t generation = 0;
+    uint32_t threadId = 0;
+    std::string threadName;
+    Chunk* first = nullptr;
+    Chunk* last = nullptr;
+
+    ThreadBuffer()
+    {
+        first = last = new Chunk();
+    }
+
+    ~ThreadBuffer()
+    {
+        Chunk* c = first;
+        while (c) {
+            Chunk* next = c->next.load(std::memory_order_relaxed);
+            delete c;
+            c = next;
+        }
+    }
+
+    void append(const char* name, int64_t begin, int64_t end, std::string&& args)
+    {
+        size_t n = last->count.load(std::memory_order_relaxed);
+        if (n == Chunk::SIZE) {
+            Chunk* c = new Chunk();
+            last->next.store(c, std::memory_order_release);
+            last = c;
+            n = 0;
+        }
+
+        Event& e = last->events[n];
+        e.name = name;
+        e.begin = begin;
+        e.end = end;
+        e.args = std::move(args);
+        last->count.store(n + 1, std::memory_order_release);
+    }
+};
+
+static std::string escapeJson(const std::string& str)
+{
+    std::string out;
+    out.reserve(str.size());
+    for (char c : str) {
+        switch (c) {
+        case '"': out += "\\\"";
+            break;
+        case '\\': out += "\\\\";
+            break;
+        case '\n': out += "\\n";
+            break;
+        case '\t': out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += ' ';
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+Tracer* Tracer::instance()
+{
+    static Tracer t;
+    return &t;
+}
+
+bool Tracer::isEnabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+int64_t Tracer::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::start(const std::string& outputPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_outputPath = outputPath;
+    m_buffers.clear();
+    m_generation.fetch_add(1);
+    s_enabled.store(true);
+}
+
+bool Tracer::stop()
+{
+    s_enabled.store(false);
+
+    std::string path = outputPath();
+    if (path.empty()) {
+        return true;
+    }
+
+    return writeChromeTrace(path);
+}
+
+std::string Tracer::outputPath() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_outputPath;
+}
+
+Tracer::ThreadBuffer* Tracer::threadBuffer()
+{
+    //! NOTE The buffer is shared with the tracer, so the events survive the thread
+    static thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+    uint32_t generation = m_generation.load(std::memory_order_acquire);
+    if (!buffer || buffer->generation != generation) {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->generation = generation;
+        buffer->threadId = ++m_lastThreadId;
+        buffer->threadName = mu::runtime::threadName();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffers.push_back(buffer);
+    }
+
+    return buffer.get();
+}
+
+void Tracer::addEvent(const char* name, int64_t begin, int64_t end, std::string&& args)
+{
+    threadBuffer()->append(name, begin, end, std::move(args));
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) const
+{
+    std::vector<std::shared_ptr<ThreadBuffer> > buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffers = m_buffers;
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool firstEvent = true;
+    auto separator = [&out, &firstEvent]() {
+        if (!firstEvent) {
+            out << ",";
+        }
+        out << "\n";
+        firstEvent = false;
+    };
+
+    for (const std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"" << escapeJson(buffer->threadName) << "\"}}";
+
+        for (ThreadBuffer::Chunk* c = buffer->first; c; c = c->next.load(std::memory_order_acquire)) {
+            size_t count = c->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const ThreadBuffer::Event& e = c->events[i];
+                separator();
+                out << "{\"name\":\"" << escapeJson(e.name) << "\",\"cat\":\"mu\",\"ph\":\"X\",\"pid\":1"
+                    << ",\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << (e.begin / 1000) << "." << (e.begin % 1000 / 100)
+                    << ",\"dur\":" << ((e.end - e.begin) / 1000) << "." << ((e.end - e.begin) % 1000 / 100);
+                if (!e.args.empty()) {
+                    out << ",\"args\":{" << e.args << "}";
+                }
+                out << "}";
+            }
+        }
+    }
+
+    out << "\n]}\n";
+    return out.good();
+}
+
+TraceSpan& TraceSpan::arg(const char* key, int64_t value)
+{
+    if (!m_name) {
+        return *this;
+    }
+
+    if (!m_args.empty()) {
+        m_args += ',';
+    }
+    m_args += '"';
+    m_args += key;
+    m_args += "\":";
+    m_args += std::to_string(value);
+    return *this;
+}
+
+TraceSpan& TraceSpan::arg(const char* key, const std::string& value)
+{
+    if (!m_name) {
+        return *this;
+    }
+
+    if (!m_args.empty()) {
+        m_args += ',';
+    }
+    m_args += '"';
+    m_args += key;
+    m_args += "\":\"";
+    m_args += escapeJson(value);
+    m_args += '"';
+    return *this;
+}
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_FRAMEWORK_TRACER_H
+#define MU_FRAMEWORK_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//! NOTE Hierarchical tracing of spans (begin, duration, arguments) per thread.
+//! Recording is off by default; a disabled span costs one atomic load.
+//! Events are appended to thread local buffers without locks and are written
+//! as Chrome trace JSON, which can be opened in chrome://tracing or ui.perfetto.dev
+//!
+//! Usage:
+//!     TRACESPAN("layout");
+//! or, with arguments:
+//!     mu::framework::TraceSpan span("doLayoutRange");
+//!     span.arg("startTick", tick).arg("score", name);
+
+namespace mu::framework {
+class Tracer
+{
+public:
+    static Tracer* instance();
+
+    static bool isEnabled();
+    static int64_t now(); // ns
+
+    //! NOTE Starts a new recording, previous events are dropped
+    void start(const std::string& outputPath = std::string());
+    //! NOTE Stops the recording and writes it to the output path, if set
+    bool stop();
+
+    bool writeChromeTrace(const std::string& path) const;
+    std::string outputPath() const;
+
+    void addEvent(const char* name, int64_t begin, int64_t end, std::string&& args);
+
+private:
+    Tracer() = default;
+
+    struct ThreadBuffer;
+    ThreadBuffer* threadBuffer();
+
+    mutable std::mutex m_mutex; // guards buffers list and output path, not the events
+    std::vector<std::shared_ptr<ThreadBuffer> > m_buffers;
+    std::string m_outputPath;
+    std::atomic<uint32_t> m_generation { 0 };
+    std::atomic<uint32_t> m_lastThreadId { 0 };
+};
+
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* name)
+        : m_name(Tracer::isEnabled() ? name : nullptr)
+    {
+        if (m_name) {
+            m_begin = Tracer::now();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (m_name) {
+            Tracer::instance()->addEvent(m_name, m_begin, Tracer::now(), std::move(m_args));
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    bool isActive() const { return m_name != nullptr; }
+
+    TraceSpan& arg(const char* key, int64_t value);
+    TraceSpan& arg(const char* key, const std::string& value);
+
+private:
+    const char* m_name = nullptr;
+    int64_t m_begin = 0;
+    std::string m_args;
+};
+}
+
+#define TRACESPAN_CAT_(a, b) a##b
+#define TRACESPAN_CAT(a, b) TRACESPAN_CAT_(a, b)
+#define TRACESPAN(name) mu::framework::TraceSpan TRACESPAN_CAT(__traceSpan, __LINE__)(name)
+
+#endif // MU_FRAMEWORK_TRACER_H
@@ -46,11 +46,25 @@ Item {
 
     signal valueEdited(var newValue)
 
+    //! NOTE: emitted around a continuous adjustment (press and hold of the arrows,
+    //! held Up/Down keys, typing in the text field), the values edited in between
+    //! may be previewed without undo recording. Canceled means the edit is dropped
+    signal valueEditingStarted()
+    signal valueEditingFinished()
+    signal valueEditingCanceled()
+
     implicitHeight: 30
     implicitWidth: parent.width
 
     navigation.name: root.objectName != "" ? root.objectName : "IncrementalControl"
 
+    QtObject {
+        id: prv
+
+        property bool isTextEditing: false
+        property bool isKeyAdjusting: false
+    }
+
     function increment() {
         var value = root.isIndeterminate ? 0.0 : currentValue
         var newValue = value + step
@@ -72,13 +86,30 @@ Item {
     }
 
     Keys.onPressed: {
-        switch (event.key) {
-        case Qt.Key_Up:
+        if (event.key !== Qt.Key_Up && event.key !== Qt.Key_Down) {
+            return
+        }
+
+        if (event.isAutoRepeat && !prv.isKeyAdjusting) {
+            prv.isKeyAdjusting = true
+            root.valueEditingStarted()
+        }
+
+        if (event.key === Qt.Key_Up) {
             increment()
-            break
-        case Qt.Key_Down:
+        } else {
             decrement()
-            break
+        }
+    }
+
+    Keys.onReleased: {
+        if (event.key !== Qt.Key_Up && event.key !== Qt.Key_Down) {
+            return
+        }
+
+        if (!event.isAutoRepeat && prv.isKeyAdjusting) {
+            prv.isKeyAdjusting = false
+            root.valueEditingFinished()
         }
     }
 
@@ -142,6 +173,12 @@ Item {
             onIncreaseButtonClicked: increment()
 
             onDecreaseButtonClicked: decrement()
+
+            onContinuousAdjustmentStarted: root.valueEditingStarted()
+
+            onContinuousAdjustmentFinished: root.valueEditingFinished()
+
+            onContinuousAdjustmentCanceled: root.valueEditingCanceled()
         }
 
         onCurrentTextEdited: {
@@ -151,8 +188,27 @@ Item {
                 newVal = 0
             }
 
+            if (textInputField.isEditing && !prv.isTextEditing) {
+                prv.isTextEditing = true
+                root.valueEditingStarted()
+            }
+
             root.valueEdited(+newVal.toFixed(decimals))
         }
+
+        onTextEditingFinished: {
+            if (prv.isTextEditing) {
+                prv.isTextEditing = false
+                root.valueEditingFinished()
+            }
+        }
+
+        onTextEditingCanceled: {
+            if (prv.isTextEditing) {
+                prv.isTextEditing = false
+                root.valueEditingCanceled()
+            }
+        }
     }
 
     states: [
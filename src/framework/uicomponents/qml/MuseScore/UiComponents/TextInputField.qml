@@ -39,10 +39,16 @@ FocusableControl {
 
     property bool hasText: valueInput.text.length > 0
     property alias readOnly: valueInput.readOnly
+    readonly property bool isEditing: valueInput.activeFocus
 
     signal currentTextEdited(var newTextValue)
     signal textCleared()
 
+    //! NOTE: emitted when the text field loses focus,
+    //! either after Enter/Return or focus moving elsewhere, or after Escape
+    signal textEditingFinished()
+    signal textEditingCanceled()
+
     function selectAll() {
         valueInput.selectAll()
     }
@@ -107,17 +113,30 @@ FocusableControl {
 
             text: root.currentText === undefined ? "" : root.currentText
 
+            property bool isCanceling: false
+
             Keys.onPressed: {
                 if (event.key === Qt.Key_Enter || event.key === Qt.Key_Return) {
                     valueInput.focus = false
+                } else if (event.key === Qt.Key_Escape) {
+                    valueInput.isCanceling = true
+                    valueInput.focus = false
                 }
             }
 
             onActiveFocusChanged: {
                 if (activeFocus) {
                     selectAll()
+                    return
+                }
+
+                deselect()
+
+                if (isCanceling) {
+                    isCanceling = false
+                    root.textEditingCanceled()
                 } else {
-                    deselect()
+                    root.textEditingFinished()
                 }
             }
 
@@ -30,6 +30,10 @@ Item {
     signal increaseButtonClicked
     signal decreaseButtonClicked
 
+    signal continuousAdjustmentStarted
+    signal continuousAdjustmentFinished
+    signal continuousAdjustmentCanceled
+
     height: childrenRect.height
     width: childrenRect.width
 
@@ -63,11 +67,22 @@ Item {
                 }
 
                 onPressAndHold: {
+                    root.continuousAdjustmentStarted()
                     continuousIncreaseTimer.running = true
                 }
 
                 onReleased: {
-                    continuousIncreaseTimer.running = false
+                    if (continuousIncreaseTimer.running) {
+                        continuousIncreaseTimer.running = false
+                        root.continuousAdjustmentFinished()
+                    }
+                }
+
+                onCanceled: {
+                    if (continuousIncreaseTimer.running) {
+                        continuousIncreaseTimer.running = false
+                        root.continuousAdjustmentCanceled()
+                    }
                 }
 
                 Timer {
@@ -106,11 +121,22 @@ Item {
                 }
 
                 onPressAndHold: {
+                    root.continuousAdjustmentStarted()
                     continuousDecreaseTimer.running = true
                 }
 
                 onReleased: {
-                    continuousDecreaseTimer.running = false
+                    if (continuousDecreaseTimer.running) {
+                        continuousDecreaseTimer.running = false
+                        root.continuousAdjustmentFinished()
+                    }
+                }
+
+                onCanceled: {
+                    if (continuousDecreaseTimer.running) {
+                        continuousDecreaseTimer.running = false
+                        root.continuousAdjustmentCanceled()
+                    }
                 }
 
                 Timer {
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QBuffer>
+
 #include "testing/qtestsuite.h"
 
 #include "testbase.h"
@@ -41,6 +43,7 @@ using namespace mu::iex::musicxml;
 
 namespace Ms {
 extern bool saveMxl(Score*, const QString&);
+extern bool saveXml(Score*, QIODevice*);
 }
 
 static const QString XML_IO_DATA_DIR("data/");
@@ -238,6 +241,8 @@ private slots:
     void wedge3() { mxmlIoTest("testWedge3"); }
     void words1() { mxmlIoTest("testWords1"); }
     void words2() { mxmlIoTest("testWords2"); }
+
+    void benchmarkExport();
 };
 
 //---------------------------------------------------------
@@ -453,5 +458,30 @@ void TestMxmlIO::mxmlReadWriteTestCompr(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   benchmarkExport
+//   MusicXML export of a larger score into memory
+//---------------------------------------------------------
+
+void TestMxmlIO::benchmarkExport()
+{
+    MScore::debugMode = false;
+
+    MasterScore* score = readScore(XML_IO_DATA_DIR + "testTrackHandling.xml");
+    QVERIFY(score);
+    fixupScore(score);
+    score->doLayout();
+
+    QByteArray data;
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        QVERIFY(saveXml(score, &buffer));
+        buffer.close();
+    }
+    QVERIFY(data.startsWith("<?xml"));
+    delete score;
+}
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
@@ -27,6 +27,9 @@
 using namespace mu::inspector;
 using namespace mu::notation;
 
+//! NOTE: during live preview the layout is done at most once per interval
+static constexpr int LIVE_PREVIEW_LAYOUT_INTERVAL_MS = 50;
+
 static const QList<Ms::ElementType> NOTATION_ELEMENT_TYPES = {
     Ms::ElementType::NOTE,
     Ms::ElementType::STEM,
@@ -84,6 +87,10 @@ AbstractInspectorModel::AbstractInspectorModel(QObject* parent, IElementReposito
 {
     m_repository = repository;
 
+    m_livePreviewLayoutTimer.setSingleShot(true);
+    m_livePreviewLayoutTimer.setInterval(LIVE_PREVIEW_LAYOUT_INTERVAL_MS);
+    connect(&m_livePreviewLayoutTimer, &QTimer::timeout, this, &AbstractInspectorModel::updateLivePreviewLayout);
+
     if (!m_repository) {
         return;
     }
@@ -171,6 +178,11 @@ void AbstractInspectorModel::onPropertyValueChanged(const Ms::Pid pid, const QVa
         return;
     }
 
+    if (pid == m_livePreviewPid) {
+        applyLivePreviewValue(pid, newValue);
+        return;
+    }
+
     beginCommand();
 
     QVariant convertedValue;
@@ -197,6 +209,119 @@ void AbstractInspectorModel::onPropertyValueChanged(const Ms::Pid pid, const QVa
     emit elementsModified();
 }
 
+void AbstractInspectorModel::onLivePreviewStarted(const Ms::Pid pid)
+{
+    if (m_livePreviewPid != Ms::Pid::END) {
+        onLivePreviewFinished(m_livePreviewPid);
+    }
+
+    if (!hasAcceptableElements()) {
+        return;
+    }
+
+    m_livePreviewPid = pid;
+    m_hasLivePreviewValue = false;
+
+    for (Ms::Element* element : m_elementList) {
+        IF_ASSERT_FAILED(element) {
+            continue;
+        }
+
+        m_livePreviewOriginalValues.append({ element, element->getProperty(pid), element->propertyFlags(pid) });
+    }
+}
+
+void AbstractInspectorModel::onLivePreviewFinished(const Ms::Pid pid)
+{
+    if (pid != m_livePreviewPid) {
+        return;
+    }
+
+    m_livePreviewLayoutTimer.stop();
+    m_livePreviewPid = Ms::Pid::END;
+
+    //! NOTE: the preview values were applied without undo,
+    //! so restore the original values and apply the final one as a single command
+    restoreLivePreviewOriginalValues(pid);
+    m_livePreviewOriginalValues.clear();
+
+    if (m_hasLivePreviewValue) {
+        m_hasLivePreviewValue = false;
+        onPropertyValueChanged(pid, m_livePreviewValue);
+    }
+}
+
+void AbstractInspectorModel::onLivePreviewCanceled(const Ms::Pid pid)
+{
+    if (pid != m_livePreviewPid) {
+        return;
+    }
+
+    m_livePreviewLayoutTimer.stop();
+    m_livePreviewPid = Ms::Pid::END;
+
+    //! NOTE: nothing is committed, the elements get their original values back
+    //! and the property items are reloaded from them
+    if (m_hasLivePreviewValue) {
+        restoreLivePreviewOriginalValues(pid);
+        updateLivePreviewLayout();
+    }
+
+    m_livePreviewOriginalValues.clear();
+    m_hasLivePreviewValue = false;
+
+    loadProperties();
+}
+
+void AbstractInspectorModel::applyLivePreviewValue(const Ms::Pid pid, const QVariant& newValue)
+{
+    for (const LivePreviewOriginalValue& original : m_livePreviewOriginalValues) {
+        Ms::Element* element = original.element;
+
+        Ms::PropertyFlags ps = original.flags;
+
+        if (ps == Ms::PropertyFlags::STYLED) {
+            ps = Ms::PropertyFlags::UNSTYLED;
+        }
+
+        element->setProperty(pid, valueToElementUnits(pid, newValue, element));
+        element->setPropertyFlags(pid, ps);
+    }
+
+    m_livePreviewValue = newValue;
+    m_hasLivePreviewValue = true;
+
+    if (!m_livePreviewLayoutTimer.isActive()) {
+        m_livePreviewLayoutTimer.start();
+    }
+}
+
+void AbstractInspectorModel::restoreLivePreviewOriginalValues(const Ms::Pid pid)
+{
+    if (!m_hasLivePreviewValue) {
+        return;
+    }
+
+    for (const LivePreviewOriginalValue& original : m_livePreviewOriginalValues) {
+        original.element->setProperty(pid, original.value);
+        original.element->setPropertyFlags(pid, original.flags);
+    }
+}
+
+void AbstractInspectorModel::updateLivePreviewLayout()
+{
+    if (m_livePreviewOriginalValues.isEmpty()) {
+        return;
+    }
+
+    Ms::Score* score = m_livePreviewOriginalValues.first().element->score();
+    if (score) {
+        score->update();
+    }
+
+    updateNotation();
+}
+
 void AbstractInspectorModel::setIsEmpty(bool isEmpty)
 {
     if (m_isEmpty == isEmpty) {
@@ -209,6 +334,10 @@ void AbstractInspectorModel::setIsEmpty(bool isEmpty)
 
 void AbstractInspectorModel::updateProperties()
 {
+    if (m_livePreviewPid != Ms::Pid::END) {
+        onLivePreviewFinished(m_livePreviewPid);
+    }
+
     requestElements();
 
     setIsEmpty(!hasAcceptableElements());
@@ -382,6 +511,15 @@ PropertyItem* AbstractInspectorModel::buildPropertyItem(const Ms::Pid& propertyI
     }
 
     connect(newPropertyItem, &PropertyItem::propertyModified, this, callback);
+    connect(newPropertyItem, &PropertyItem::livePreviewStarted, this, [this](const int propertyId) {
+        onLivePreviewStarted(static_cast<Ms::Pid>(propertyId));
+    });
+    connect(newPropertyItem, &PropertyItem::livePreviewFinished, this, [this](const int propertyId) {
+        onLivePreviewFinished(static_cast<Ms::Pid>(propertyId));
+    });
+    connect(newPropertyItem, &PropertyItem::livePreviewCanceled, this, [this](const int propertyId) {
+        onLivePreviewCanceled(static_cast<Ms::Pid>(propertyId));
+    });
     connect(newPropertyItem, &PropertyItem::applyToStyleRequested, this, [this](const int sid, const QVariant& newStyleValue) {
         updateStyleValue(static_cast<Ms::Sid>(sid), newStyleValue);
 
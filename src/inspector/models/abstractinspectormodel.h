@@ -23,6 +23,7 @@
 #define MU_INSPECTOR_ABSTRACTINSPECTORMODEL_H
 
 #include <QList>
+#include <QTimer>
 #include <functional>
 #include "libmscore/element.h"
 #include "libmscore/score.h"
@@ -165,11 +166,30 @@ protected:
 protected slots:
     void onResetToDefaults(const QList<Ms::Pid>& pidList);
     void onPropertyValueChanged(const Ms::Pid pid, const QVariant& newValue);
+    void onLivePreviewStarted(const Ms::Pid pid);
+    void onLivePreviewFinished(const Ms::Pid pid);
+    void onLivePreviewCanceled(const Ms::Pid pid);
     void updateProperties();
 
 private:
     Ms::Sid styleIdByPropertyId(const Ms::Pid pid) const;
 
+    void applyLivePreviewValue(const Ms::Pid pid, const QVariant& newValue);
+    void restoreLivePreviewOriginalValues(const Ms::Pid pid);
+    void updateLivePreviewLayout();
+
+    struct LivePreviewOriginalValue {
+        Ms::Element* element = nullptr;
+        QVariant value;
+        Ms::PropertyFlags flags = Ms::PropertyFlags::NOSTYLE;
+    };
+
+    Ms::Pid m_livePreviewPid = Ms::Pid::END;
+    QVariant m_livePreviewValue;
+    bool m_hasLivePreviewValue = false;
+    QList<LivePreviewOriginalValue> m_livePreviewOriginalValues;
+    QTimer m_livePreviewLayoutTimer;
+
     QString m_title;
     InspectorSectionType m_sectionType = InspectorSectionType::SECTION_UNDEFINED;
     InspectorModelType m_modelType = InspectorModelType::TYPE_UNDEFINED;
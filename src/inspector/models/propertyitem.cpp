@@ -56,6 +56,21 @@ void PropertyItem::applyToStyle()
     emit applyToStyleRequested(m_styleId, m_currentValue);
 }
 
+void PropertyItem::beginLivePreview()
+{
+    emit livePreviewStarted(m_propertyId);
+}
+
+void PropertyItem::endLivePreview()
+{
+    emit livePreviewFinished(m_propertyId);
+}
+
+void PropertyItem::cancelLivePreview()
+{
+    emit livePreviewCanceled(m_propertyId);
+}
+
 int PropertyItem::propertyId() const
 {
     return m_propertyId;
@@ -46,6 +46,10 @@ public:
     Q_INVOKABLE void resetToDefault();
     Q_INVOKABLE void applyToStyle();
 
+    Q_INVOKABLE void beginLivePreview();
+    Q_INVOKABLE void endLivePreview();
+    Q_INVOKABLE void cancelLivePreview();
+
     int propertyId() const;
     QVariant value() const;
     QVariant defaultValue() const;
@@ -73,6 +77,10 @@ signals:
     void propertyModified(int propertyId, QVariant newValue);
     void applyToStyleRequested(int styledId, QVariant newStyleValue);
 
+    void livePreviewStarted(int propertyId);
+    void livePreviewFinished(int propertyId);
+    void livePreviewCanceled(int propertyId);
+
 private:
     int m_propertyId = -1;
     int m_styleId = -1;
@@ -70,6 +70,9 @@ Item {
             currentValue: leadingSpace ? leadingSpace.value : 0
 
             onValueEdited: { leadingSpace.value = newValue }
+            onValueEditingStarted: { leadingSpace.beginLivePreview() }
+            onValueEditingFinished: { leadingSpace.endLivePreview() }
+            onValueEditingCanceled: { leadingSpace.cancelLivePreview() }
         }
     }
 
@@ -97,6 +100,9 @@ Item {
             currentValue: barWidth ? barWidth.value : 0
 
             onValueEdited: { barWidth.value = newValue }
+            onValueEditingStarted: { barWidth.beginLivePreview() }
+            onValueEditingFinished: { barWidth.endLivePreview() }
+            onValueEditingCanceled: { barWidth.cancelLivePreview() }
         }
     }
 }
@@ -75,6 +75,9 @@ Column {
                 currentValue: horizontalOffset ? horizontalOffset.value : 0
 
                 onValueEdited: { horizontalOffset.value = newValue }
+                onValueEditingStarted: { horizontalOffset.beginLivePreview() }
+                onValueEditingFinished: { horizontalOffset.endLivePreview() }
+                onValueEditingCanceled: { horizontalOffset.cancelLivePreview() }
             }
 
             IncrementalPropertyControl {
@@ -93,6 +96,9 @@ Column {
                 currentValue: verticalOffset ? verticalOffset.value : 0
 
                 onValueEdited: { verticalOffset.value = newValue }
+                onValueEditingStarted: { verticalOffset.beginLivePreview() }
+                onValueEditingFinished: { verticalOffset.endLivePreview() }
+                onValueEditingCanceled: { verticalOffset.cancelLivePreview() }
             }
         }
     }
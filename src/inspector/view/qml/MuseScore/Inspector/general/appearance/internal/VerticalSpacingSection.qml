@@ -55,5 +55,8 @@ InspectorPropertyView {
         currentValue: minimumDistance ? minimumDistance.value : 0
 
         onValueEdited: { minimumDistance.value = newValue }
+        onValueEditingStarted: { minimumDistance.beginLivePreview() }
+        onValueEditingFinished: { minimumDistance.endLivePreview() }
+        onValueEditingCanceled: { minimumDistance.cancelLivePreview() }
     }
 }
@@ -62,6 +62,9 @@ ExpandableBlank {
             minValue: 0
 
             onValueEdited: { model.stretch.value = newValue }
+            onValueEditingStarted: { model.stretch.beginLivePreview() }
+            onValueEditingFinished: { model.stretch.endLivePreview() }
+            onValueEditingCanceled: { model.stretch.cancelLivePreview() }
         }
     }
 }
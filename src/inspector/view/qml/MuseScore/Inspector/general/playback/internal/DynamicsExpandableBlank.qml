@@ -117,6 +117,9 @@ ExpandableBlank {
                     currentValue: model ? model.velocity.value : 0
 
                     onValueEdited: { model.velocity.value = newValue }
+                    onValueEditingStarted: { model.velocity.beginLivePreview() }
+                    onValueEditingFinished: { model.velocity.endLivePreview() }
+                    onValueEditingCanceled: { model.velocity.cancelLivePreview() }
                 }
             }
 
@@ -157,6 +160,9 @@ ExpandableBlank {
                     currentValue: model ? model.velocityChange.value : 0
 
                     onValueEdited: { model.velocityChange.value = newValue }
+                    onValueEditingStarted: { model.velocityChange.beginLivePreview() }
+                    onValueEditingFinished: { model.velocityChange.endLivePreview() }
+                    onValueEditingCanceled: { model.velocityChange.cancelLivePreview() }
                 }
             }
         }
@@ -72,6 +72,9 @@ ExpandableBlank {
             }
 
             onValueEdited: { model.timeStretch.value = newValue }
+            onValueEditingStarted: { model.timeStretch.beginLivePreview() }
+            onValueEditingFinished: { model.timeStretch.endLivePreview() }
+            onValueEditingCanceled: { model.timeStretch.cancelLivePreview() }
         }
     }
 }
@@ -76,6 +76,9 @@ ExpandableBlank {
                 currentValue: model ? model.velocityChange.value : 0
 
                 onValueEdited: { model.velocityChange.value = newValue }
+                onValueEditingStarted: { model.velocityChange.beginLivePreview() }
+                onValueEditingFinished: { model.velocityChange.endLivePreview() }
+                onValueEditingCanceled: { model.velocityChange.cancelLivePreview() }
             }
         }
 
@@ -81,6 +81,9 @@ ExpandableBlank {
                     currentValue: model ? model.velocity.value : 0
 
                     onValueEdited: { model.velocity.value = newValue }
+                    onValueEditingStarted: { model.velocity.beginLivePreview() }
+                    onValueEditingFinished: { model.velocity.endLivePreview() }
+                    onValueEditingCanceled: { model.velocity.cancelLivePreview() }
                 }
             }
 
@@ -109,6 +112,9 @@ ExpandableBlank {
                     currentValue: model ? model.tuning.value : 0
 
                     onValueEdited: { model.tuning.value = newValue }
+                    onValueEditingStarted: { model.tuning.beginLivePreview() }
+                    onValueEditingFinished: { model.tuning.endLivePreview() }
+                    onValueEditingCanceled: { model.tuning.cancelLivePreview() }
                 }
             }
         }
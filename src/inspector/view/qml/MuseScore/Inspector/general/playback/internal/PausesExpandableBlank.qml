@@ -63,6 +63,9 @@ ExpandableBlank {
             maxValue: 60.0
 
             onValueEdited: { model.pauseTime.value = newValue }
+            onValueEditingStarted: { model.pauseTime.beginLivePreview() }
+            onValueEditingFinished: { model.pauseTime.endLivePreview() }
+            onValueEditingCanceled: { model.pauseTime.cancelLivePreview() }
         }
     }
 }
@@ -157,6 +157,9 @@ StyledPopupView {
                         }
 
                         onValueEdited: { root.model.topOctave.value = newValue }
+                        onValueEditingStarted: { root.model.topOctave.beginLivePreview() }
+                        onValueEditingFinished: { root.model.topOctave.endLivePreview() }
+                        onValueEditingCanceled: { root.model.topOctave.cancelLivePreview() }
                     }
                 }
             }
@@ -204,6 +207,9 @@ StyledPopupView {
                     }
 
                     onValueEdited: { root.model.bottomOctave.value = newValue }
+                    onValueEditingStarted: { root.model.bottomOctave.beginLivePreview() }
+                    onValueEditingFinished: { root.model.bottomOctave.endLivePreview() }
+                    onValueEditingCanceled: { root.model.bottomOctave.cancelLivePreview() }
                 }
             }
 
@@ -311,6 +317,9 @@ StyledPopupView {
                             decimals: 2
 
                             onValueEdited: { root.model.lineThickness.value = newValue }
+                            onValueEditingStarted: { root.model.lineThickness.beginLivePreview() }
+                            onValueEditingFinished: { root.model.lineThickness.endLivePreview() }
+                            onValueEditingCanceled: { root.model.lineThickness.cancelLivePreview() }
                         }
                     }
                 }
@@ -141,6 +141,9 @@ StyledPopupView {
                     currentValue: barlineSettingsModel ? barlineSettingsModel.spanFrom.value : 0
 
                     onValueEdited: { barlineSettingsModel.spanFrom.value = newValue }
+                    onValueEditingStarted: { barlineSettingsModel.spanFrom.beginLivePreview() }
+                    onValueEditingFinished: { barlineSettingsModel.spanFrom.endLivePreview() }
+                    onValueEditingCanceled: { barlineSettingsModel.spanFrom.cancelLivePreview() }
                 }
             }
 
@@ -163,6 +166,9 @@ StyledPopupView {
                     currentValue: barlineSettingsModel ? barlineSettingsModel.spanTo.value : 0
 
                     onValueEdited: { barlineSettingsModel.spanTo.value = newValue }
+                    onValueEditingStarted: { barlineSettingsModel.spanTo.beginLivePreview() }
+                    onValueEditingFinished: { barlineSettingsModel.spanTo.endLivePreview() }
+                    onValueEditingCanceled: { barlineSettingsModel.spanTo.cancelLivePreview() }
                 }
             }
         }
@@ -104,6 +104,9 @@ StyledPopupView {
                 decimals: 2
 
                 onValueEdited: { model.lineThickness.value = newValue }
+                onValueEditingStarted: { model.lineThickness.beginLivePreview() }
+                onValueEditingFinished: { model.lineThickness.endLivePreview() }
+                onValueEditingCanceled: { model.lineThickness.cancelLivePreview() }
             }
         }
     }
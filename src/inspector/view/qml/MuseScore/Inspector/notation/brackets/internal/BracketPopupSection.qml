@@ -48,6 +48,9 @@ InspectorPropertyView {
         currentValue: intBracketProperty ? intBracketProperty.value : 0
 
         onValueEdited: { intBracketProperty.value = newValue }
+        onValueEditingStarted: { intBracketProperty.beginLivePreview() }
+        onValueEditingFinished: { intBracketProperty.endLivePreview() }
+        onValueEditingCanceled: { intBracketProperty.cancelLivePreview() }
     }
 }
 
@@ -153,6 +153,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.dashLineLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashLineLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashLineLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashLineLength.cancelLivePreview() }
                 }
             }
 
@@ -178,6 +181,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.dashGapLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashGapLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashGapLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashGapLength.cancelLivePreview() }
                 }
             }
         }
@@ -220,6 +226,9 @@ FocusableItem {
                             decimals: 2
 
                             onValueEdited: { root.model.thickness.value = newValue }
+                            onValueEditingStarted: { root.model.thickness.beginLivePreview() }
+                            onValueEditingFinished: { root.model.thickness.endLivePreview() }
+                            onValueEditingCanceled: { root.model.thickness.cancelLivePreview() }
                         }
                     }
 
@@ -245,6 +254,9 @@ FocusableItem {
                             decimals: 2
 
                             onValueEdited: { root.model.hookHeight.value = newValue }
+                            onValueEditingStarted: { root.model.hookHeight.beginLivePreview() }
+                            onValueEditingFinished: { root.model.hookHeight.endLivePreview() }
+                            onValueEditingCanceled: { root.model.hookHeight.cancelLivePreview() }
                         }
                     }
                 }
@@ -86,6 +86,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.beginningTextHorizontalOffset.value : 0
 
                     onValueEdited: { root.model.beginningTextHorizontalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.beginningTextHorizontalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.beginningTextHorizontalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.beginningTextHorizontalOffset.cancelLivePreview() }
                 }
 
                 IncrementalPropertyControl {
@@ -98,6 +101,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.beginningTextVerticalOffset.value : 0
 
                     onValueEdited: { root.model.beginningTextVerticalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.beginningTextVerticalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.beginningTextVerticalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.beginningTextVerticalOffset.cancelLivePreview() }
                 }
             }
         }
@@ -153,6 +159,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.continiousTextHorizontalOffset.value : 0
 
                     onValueEdited: { root.model.continiousTextHorizontalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.continiousTextHorizontalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.continiousTextHorizontalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.continiousTextHorizontalOffset.cancelLivePreview() }
                 }
 
                 IncrementalPropertyControl {
@@ -165,6 +174,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.continiousTextVerticalOffset.value : 0
 
                     onValueEdited: { root.model.continiousTextVerticalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.continiousTextVerticalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.continiousTextVerticalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.continiousTextVerticalOffset.cancelLivePreview() }
                 }
             }
         }
@@ -43,5 +43,8 @@ InspectorPropertyView {
         currentValue: heightProperty ? heightProperty.value : 0
 
         onValueEdited: { heightProperty.value = newValue }
+        onValueEditingStarted: { heightProperty.beginLivePreview() }
+        onValueEditingFinished: { heightProperty.endLivePreview() }
+        onValueEditingCanceled: { heightProperty.cancelLivePreview() }
     }
 }
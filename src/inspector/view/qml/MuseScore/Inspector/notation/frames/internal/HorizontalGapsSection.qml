@@ -50,6 +50,9 @@ Item {
             currentValue: leftGap ? leftGap.value : 0
 
             onValueEdited: { leftGap.value = newValue }
+            onValueEditingStarted: { leftGap.beginLivePreview() }
+            onValueEditingFinished: { leftGap.endLivePreview() }
+            onValueEditingCanceled: { leftGap.cancelLivePreview() }
         }
     }
 
@@ -69,6 +72,9 @@ Item {
             currentValue: rightGap ? rightGap.value : 0
 
             onValueEdited: { rightGap.value = newValue }
+            onValueEditingStarted: { rightGap.beginLivePreview() }
+            onValueEditingFinished: { rightGap.endLivePreview() }
+            onValueEditingCanceled: { rightGap.cancelLivePreview() }
         }
     }
 }
@@ -51,6 +51,9 @@ Item {
             currentValue: frameLeftMargin ? frameLeftMargin.value : 0
 
             onValueEdited: { frameLeftMargin.value = newValue }
+            onValueEditingStarted: { frameLeftMargin.beginLivePreview() }
+            onValueEditingFinished: { frameLeftMargin.endLivePreview() }
+            onValueEditingCanceled: { frameLeftMargin.cancelLivePreview() }
         }
     }
 
@@ -72,6 +75,9 @@ Item {
             currentValue: frameRightMargin ? frameRightMargin.value : 0
 
             onValueEdited: { frameRightMargin.value = newValue }
+            onValueEditingStarted: { frameRightMargin.beginLivePreview() }
+            onValueEditingFinished: { frameRightMargin.endLivePreview() }
+            onValueEditingCanceled: { frameRightMargin.cancelLivePreview() }
         }
     }
 }
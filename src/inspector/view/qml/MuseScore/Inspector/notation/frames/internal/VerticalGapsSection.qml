@@ -49,6 +49,9 @@ Item {
             currentValue: gapAbove ? gapAbove.value : 0
 
             onValueEdited: { gapAbove.value = newValue }
+            onValueEditingStarted: { gapAbove.beginLivePreview() }
+            onValueEditingFinished: { gapAbove.endLivePreview() }
+            onValueEditingCanceled: { gapAbove.cancelLivePreview() }
         }
     }
 
@@ -68,6 +71,9 @@ Item {
             currentValue: gapBelow ? gapBelow.value : 0
 
             onValueEdited: { gapBelow.value = newValue }
+            onValueEditingStarted: { gapBelow.beginLivePreview() }
+            onValueEditingFinished: { gapBelow.endLivePreview() }
+            onValueEditingCanceled: { gapBelow.cancelLivePreview() }
         }
     }
 }
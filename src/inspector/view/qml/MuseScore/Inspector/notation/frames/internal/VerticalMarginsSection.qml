@@ -51,6 +51,9 @@ Item {
             currentValue: frameTopMargin ? frameTopMargin.value : 0
 
             onValueEdited: { frameTopMargin.value = newValue }
+            onValueEditingStarted: { frameTopMargin.beginLivePreview() }
+            onValueEditingFinished: { frameTopMargin.endLivePreview() }
+            onValueEditingCanceled: { frameTopMargin.cancelLivePreview() }
         }
     }
 
@@ -72,6 +75,9 @@ Item {
             currentValue: frameBottomMargin ? frameBottomMargin.value : 0
 
             onValueEdited: { frameBottomMargin.value = newValue }
+            onValueEditingStarted: { frameBottomMargin.beginLivePreview() }
+            onValueEditingFinished: { frameBottomMargin.endLivePreview() }
+            onValueEditingCanceled: { frameBottomMargin.cancelLivePreview() }
         }
     }
 }
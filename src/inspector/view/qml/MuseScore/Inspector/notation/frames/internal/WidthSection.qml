@@ -43,5 +43,8 @@ InspectorPropertyView {
         currentValue: widthProperty ? widthProperty.value : 0
 
         onValueEdited: { widthProperty.value = newValue }
+        onValueEditingStarted: { widthProperty.beginLivePreview() }
+        onValueEditingFinished: { widthProperty.endLivePreview() }
+        onValueEditingCanceled: { widthProperty.cancelLivePreview() }
     }
 }
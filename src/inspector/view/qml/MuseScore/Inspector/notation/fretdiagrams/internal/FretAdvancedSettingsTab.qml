@@ -70,6 +70,9 @@ FocusableItem {
                     }
 
                     onValueEdited: { root.model.scale.value = newValue }
+                    onValueEditingStarted: { root.model.scale.beginLivePreview() }
+                    onValueEditingFinished: { root.model.scale.endLivePreview() }
+                    onValueEditingCanceled: { root.model.scale.cancelLivePreview() }
                 }
             }
 
@@ -98,6 +101,9 @@ FocusableItem {
                     }
 
                     onValueEdited: { root.model.stringsCount.value = newValue }
+                    onValueEditingStarted: { root.model.stringsCount.beginLivePreview() }
+                    onValueEditingFinished: { root.model.stringsCount.endLivePreview() }
+                    onValueEditingCanceled: { root.model.stringsCount.cancelLivePreview() }
                 }
             }
         }
@@ -131,6 +137,9 @@ FocusableItem {
                     }
 
                     onValueEdited: { root.model.fretsCount.value = newValue }
+                    onValueEditingStarted: { root.model.fretsCount.beginLivePreview() }
+                    onValueEditingFinished: { root.model.fretsCount.endLivePreview() }
+                    onValueEditingCanceled: { root.model.fretsCount.cancelLivePreview() }
                 }
             }
 
@@ -159,6 +168,9 @@ FocusableItem {
                     }
 
                     onValueEdited: { root.model.startingFretNumber.value = newValue }
+                    onValueEditingStarted: { root.model.startingFretNumber.beginLivePreview() }
+                    onValueEditingFinished: { root.model.startingFretNumber.endLivePreview() }
+                    onValueEditingCanceled: { root.model.startingFretNumber.cancelLivePreview() }
                 }
             }
         }
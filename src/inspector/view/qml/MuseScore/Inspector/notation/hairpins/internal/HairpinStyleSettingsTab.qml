@@ -132,6 +132,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.dashLineLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashLineLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashLineLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashLineLength.cancelLivePreview() }
                 }
             }
 
@@ -157,6 +160,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.dashGapLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashGapLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashGapLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashGapLength.cancelLivePreview() }
                 }
             }
         }
@@ -186,6 +192,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.thickness.value = newValue }
+                    onValueEditingStarted: { root.model.thickness.beginLivePreview() }
+                    onValueEditingFinished: { root.model.thickness.endLivePreview() }
+                    onValueEditingCanceled: { root.model.thickness.cancelLivePreview() }
                 }
             }
 
@@ -209,6 +218,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.height.value = newValue }
+                    onValueEditingStarted: { root.model.height.beginLivePreview() }
+                    onValueEditingFinished: { root.model.height.endLivePreview() }
+                    onValueEditingCanceled: { root.model.height.cancelLivePreview() }
                 }
             }
         }
@@ -236,6 +248,9 @@ FocusableItem {
                     decimals: 2
 
                     onValueEdited: { root.model.continiousHeight.value = newValue }
+                    onValueEditingStarted: { root.model.continiousHeight.beginLivePreview() }
+                    onValueEditingFinished: { root.model.continiousHeight.endLivePreview() }
+                    onValueEditingCanceled: { root.model.continiousHeight.cancelLivePreview() }
                 }
             }
         }
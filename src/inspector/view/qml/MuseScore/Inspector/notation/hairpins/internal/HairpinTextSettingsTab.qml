@@ -78,6 +78,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.beginingTextHorizontalOffset.value : 0
 
                     onValueEdited: { root.model.beginingTextHorizontalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.beginingTextHorizontalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.beginingTextHorizontalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.beginingTextHorizontalOffset.cancelLivePreview() }
                 }
 
                 IncrementalPropertyControl {
@@ -90,6 +93,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.beginingTextVerticalOffset.value : 0
 
                     onValueEdited: { root.model.beginingTextVerticalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.beginingTextVerticalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.beginingTextVerticalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.beginingTextVerticalOffset.cancelLivePreview() }
                 }
             }
         }
@@ -133,6 +139,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.continiousTextHorizontalOffset.value : 0
 
                     onValueEdited: { root.model.continiousTextHorizontalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.continiousTextHorizontalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.continiousTextHorizontalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.continiousTextHorizontalOffset.cancelLivePreview() }
                 }
 
                 IncrementalPropertyControl {
@@ -145,6 +154,9 @@ FocusableItem {
                     currentValue: root.model ? root.model.continiousTextVerticalOffset.value : 0
 
                     onValueEdited: { root.model.continiousTextVerticalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.continiousTextVerticalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.continiousTextVerticalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.continiousTextVerticalOffset.cancelLivePreview() }
                 }
             }
         }
@@ -62,6 +62,9 @@ StyledPopupView {
                     currentValue: model ? model.height.value : 0
 
                     onValueEdited: { model.height.value = newValue }
+                    onValueEditingStarted: { model.height.beginLivePreview() }
+                    onValueEditingFinished: { model.height.endLivePreview() }
+                    onValueEditingCanceled: { model.height.cancelLivePreview() }
                 }
             }
 
@@ -99,6 +102,9 @@ StyledPopupView {
                     currentValue: model ? model.width.value : 0
 
                     onValueEdited: { model.width.value = newValue }
+                    onValueEditingStarted: { model.width.beginLivePreview() }
+                    onValueEditingFinished: { model.width.endLivePreview() }
+                    onValueEditingCanceled: { model.width.cancelLivePreview() }
                 }
             }
         }
@@ -54,6 +54,9 @@ StyledPopupView {
                 decimals: 2
 
                 onValueEdited: { model.numberPosition.value = newValue }
+                onValueEditingStarted: { model.numberPosition.beginLivePreview() }
+                onValueEditingFinished: { model.numberPosition.endLivePreview() }
+                onValueEditingCanceled: { model.numberPosition.cancelLivePreview() }
             }
         }
     }
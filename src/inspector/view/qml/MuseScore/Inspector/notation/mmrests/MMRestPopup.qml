@@ -94,6 +94,9 @@ StyledPopupView {
                         minValue: -99.00
 
                         onValueEdited: { root.model.numberPosition.value = newValue }
+                        onValueEditingStarted: { root.model.numberPosition.beginLivePreview() }
+                        onValueEditingFinished: { root.model.numberPosition.endLivePreview() }
+                        onValueEditingCanceled: { root.model.numberPosition.cancelLivePreview() }
                     }
                 }
             }
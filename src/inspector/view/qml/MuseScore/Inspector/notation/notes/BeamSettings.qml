@@ -137,6 +137,9 @@ FocusableItem {
                             step: 0.1
 
                             onValueEdited: { model.featheringHeightLeft.value = newValue }
+                            onValueEditingStarted: { model.featheringHeightLeft.beginLivePreview() }
+                            onValueEditingFinished: { model.featheringHeightLeft.endLivePreview() }
+                            onValueEditingCanceled: { model.featheringHeightLeft.cancelLivePreview() }
                         }
                     }
 
@@ -159,6 +162,9 @@ FocusableItem {
                             step: 0.1
 
                             onValueEdited: { model.featheringHeightRight.value = newValue }
+                            onValueEditingStarted: { model.featheringHeightRight.beginLivePreview() }
+                            onValueEditingFinished: { model.featheringHeightRight.endLivePreview() }
+                            onValueEditingCanceled: { model.featheringHeightRight.cancelLivePreview() }
                         }
                     }
                 }
@@ -216,6 +222,9 @@ FocusableItem {
                                 currentValue: model ? model.beamVectorX.value : 0
 
                                 onValueEdited: { model.beamVectorX.value = newValue }
+                                onValueEditingStarted: { model.beamVectorX.beginLivePreview() }
+                                onValueEditingFinished: { model.beamVectorX.endLivePreview() }
+                                onValueEditingCanceled: { model.beamVectorX.cancelLivePreview() }
                             }
 
                             FlatToggleButton {
@@ -247,6 +256,9 @@ FocusableItem {
                                 currentValue: model ? model.beamVectorY.value : 0
 
                                 onValueEdited: { model.beamVectorY.value = newValue }
+                                onValueEditingStarted: { model.beamVectorY.beginLivePreview() }
+                                onValueEditingFinished: { model.beamVectorY.endLivePreview() }
+                                onValueEditingCanceled: { model.beamVectorY.cancelLivePreview() }
                             }
                         }
                     }
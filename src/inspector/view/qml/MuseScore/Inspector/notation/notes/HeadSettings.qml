@@ -210,6 +210,9 @@ FocusableItem {
                             currentValue: model ? model.horizontalOffset.value : 0
 
                             onValueEdited: { model.horizontalOffset.value = newValue }
+                            onValueEditingStarted: { model.horizontalOffset.beginLivePreview() }
+                            onValueEditingFinished: { model.horizontalOffset.endLivePreview() }
+                            onValueEditingCanceled: { model.horizontalOffset.cancelLivePreview() }
                         }
 
                         IncrementalPropertyControl {
@@ -223,6 +226,9 @@ FocusableItem {
                             currentValue: model ? model.verticalOffset.value : 0
 
                             onValueEdited: { model.verticalOffset.value = newValue }
+                            onValueEditingStarted: { model.verticalOffset.beginLivePreview() }
+                            onValueEditingFinished: { model.verticalOffset.endLivePreview() }
+                            onValueEditingCanceled: { model.verticalOffset.cancelLivePreview() }
                         }
                     }
                 }
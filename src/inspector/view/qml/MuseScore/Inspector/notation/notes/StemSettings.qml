@@ -130,6 +130,9 @@ FocusableItem {
                             step: 0.01
 
                             onValueEdited: { stemModel.thickness.value = newValue }
+                            onValueEditingStarted: { stemModel.thickness.beginLivePreview() }
+                            onValueEditingFinished: { stemModel.thickness.endLivePreview() }
+                            onValueEditingCanceled: { stemModel.thickness.cancelLivePreview() }
                         }
                     }
 
@@ -151,6 +154,9 @@ FocusableItem {
                             minValue: 0.01
 
                             onValueEdited: { stemModel.length.value = newValue }
+                            onValueEditingStarted: { stemModel.length.beginLivePreview() }
+                            onValueEditingFinished: { stemModel.length.endLivePreview() }
+                            onValueEditingCanceled: { stemModel.length.cancelLivePreview() }
                         }
                     }
                 }
@@ -176,6 +182,9 @@ FocusableItem {
                             currentValue: stemModel ? stemModel.horizontalOffset.value : 0
 
                             onValueEdited: { stemModel.horizontalOffset.value = newValue }
+                            onValueEditingStarted: { stemModel.horizontalOffset.beginLivePreview() }
+                            onValueEditingFinished: { stemModel.horizontalOffset.endLivePreview() }
+                            onValueEditingCanceled: { stemModel.horizontalOffset.cancelLivePreview() }
                         }
 
                         IncrementalPropertyControl {
@@ -189,6 +198,9 @@ FocusableItem {
                             currentValue: stemModel ? stemModel.verticalOffset.value : 0
 
                             onValueEdited: { stemModel.verticalOffset.value = newValue }
+                            onValueEditingStarted: { stemModel.verticalOffset.beginLivePreview() }
+                            onValueEditingFinished: { stemModel.verticalOffset.endLivePreview() }
+                            onValueEditingCanceled: { stemModel.verticalOffset.cancelLivePreview() }
                         }
                     }
                 }
@@ -214,6 +226,9 @@ FocusableItem {
                             currentValue: hookModel ? hookModel.horizontalOffset.value : 0.00
 
                             onValueEdited: { hookModel.horizontalOffset.value = newValue }
+                            onValueEditingStarted: { hookModel.horizontalOffset.beginLivePreview() }
+                            onValueEditingFinished: { hookModel.horizontalOffset.endLivePreview() }
+                            onValueEditingCanceled: { hookModel.horizontalOffset.cancelLivePreview() }
                         }
 
                         IncrementalPropertyControl {
@@ -227,6 +242,9 @@ FocusableItem {
                             currentValue: hookModel ? hookModel.verticalOffset.value : 0.00
 
                             onValueEdited: { hookModel.verticalOffset.value = newValue }
+                            onValueEditingStarted: { hookModel.verticalOffset.beginLivePreview() }
+                            onValueEditingFinished: { hookModel.verticalOffset.endLivePreview() }
+                            onValueEditingCanceled: { hookModel.verticalOffset.cancelLivePreview() }
                         }
                     }
                 }
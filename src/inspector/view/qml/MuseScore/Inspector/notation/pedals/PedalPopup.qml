@@ -96,6 +96,9 @@ StyledPopupView {
                     currentValue: root.model ? root.model.thickness.value : 0
 
                     onValueEdited: { root.model.thickness.value = newValue }
+                    onValueEditingStarted: { root.model.thickness.beginLivePreview() }
+                    onValueEditingFinished: { root.model.thickness.endLivePreview() }
+                    onValueEditingCanceled: { root.model.thickness.cancelLivePreview() }
                 }
             }
 
@@ -117,6 +120,9 @@ StyledPopupView {
                     currentValue: root.model ? root.model.hookHeight.value : 0
 
                     onValueEdited: { root.model.hookHeight.value = newValue }
+                    onValueEditingStarted: { root.model.hookHeight.beginLivePreview() }
+                    onValueEditingFinished: { root.model.hookHeight.endLivePreview() }
+                    onValueEditingCanceled: { root.model.hookHeight.cancelLivePreview() }
                 }
             }
         }
@@ -183,6 +189,9 @@ StyledPopupView {
                     currentValue: root.model ? root.model.dashLineLength.value : 0
 
                     onValueEdited: { root.model.dashLineLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashLineLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashLineLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashLineLength.cancelLivePreview() }
                 }
             }
 
@@ -204,6 +213,9 @@ StyledPopupView {
                     currentValue: root.model ? root.model.dashGapLength.value : 0
 
                     onValueEdited: { root.model.dashGapLength.value = newValue }
+                    onValueEditingStarted: { root.model.dashGapLength.beginLivePreview() }
+                    onValueEditingFinished: { root.model.dashGapLength.endLivePreview() }
+                    onValueEditingCanceled: { root.model.dashGapLength.cancelLivePreview() }
                 }
             }
         }
@@ -53,6 +53,9 @@ StyledPopupView {
                 measureUnitsSymbol: qsTrc("inspector", "s")
 
                 onValueEdited: { model.pauseDuration.value = newValue }
+                onValueEditingStarted: { model.pauseDuration.beginLivePreview() }
+                onValueEditingFinished: { model.pauseDuration.endLivePreview() }
+                onValueEditingCanceled: { model.pauseDuration.cancelLivePreview() }
             }
         }
 
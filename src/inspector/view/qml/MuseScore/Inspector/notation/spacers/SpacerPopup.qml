@@ -52,6 +52,9 @@ StyledPopupView {
                 step: 0.5
 
                 onValueEdited: { model.spacerHeight.value = newValue }
+                onValueEditingStarted: { model.spacerHeight.beginLivePreview() }
+                onValueEditingFinished: { model.spacerHeight.endLivePreview() }
+                onValueEditingCanceled: { model.spacerHeight.cancelLivePreview() }
             }
         }
     }
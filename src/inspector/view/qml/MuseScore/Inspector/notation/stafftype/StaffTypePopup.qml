@@ -71,6 +71,9 @@ StyledPopupView {
                     maxValue: 5
 
                     onValueEdited: { root.model.verticalOffset.value = newValue }
+                    onValueEditingStarted: { root.model.verticalOffset.beginLivePreview() }
+                    onValueEditingFinished: { root.model.verticalOffset.endLivePreview() }
+                    onValueEditingCanceled: { root.model.verticalOffset.cancelLivePreview() }
                 }
             }
 
@@ -96,6 +99,9 @@ StyledPopupView {
                     minValue: 20
 
                     onValueEdited: { root.model.scale.value = newValue }
+                    onValueEditingStarted: { root.model.scale.beginLivePreview() }
+                    onValueEditingFinished: { root.model.scale.endLivePreview() }
+                    onValueEditingCanceled: { root.model.scale.cancelLivePreview() }
                 }
             }
         }
@@ -131,6 +137,9 @@ StyledPopupView {
                     }
 
                     onValueEdited: { root.model.lineCount.value = newValue }
+                    onValueEditingStarted: { root.model.lineCount.beginLivePreview() }
+                    onValueEditingFinished: { root.model.lineCount.endLivePreview() }
+                    onValueEditingCanceled: { root.model.lineCount.cancelLivePreview() }
                 }
             }
 
@@ -154,6 +163,9 @@ StyledPopupView {
                     minValue: 0
 
                     onValueEdited: { root.model.lineDistance.value = newValue }
+                    onValueEditingStarted: { root.model.lineDistance.beginLivePreview() }
+                    onValueEditingFinished: { root.model.lineDistance.endLivePreview() }
+                    onValueEditingCanceled: { root.model.lineDistance.cancelLivePreview() }
                 }
             }
         }
@@ -183,6 +195,9 @@ StyledPopupView {
                 }
 
                 onValueEdited: { root.model.stepOffset.value = newValue }
+                onValueEditingStarted: { root.model.stepOffset.beginLivePreview() }
+                onValueEditingFinished: { root.model.stepOffset.endLivePreview() }
+                onValueEditingCanceled: { root.model.stepOffset.cancelLivePreview() }
             }
         }
 
@@ -61,6 +61,9 @@ StyledPopupView {
                 measureUnitsSymbol: qsTrc("inspector", "BPM")
 
                 onValueEdited: { model.tempo.value = newValue }
+                onValueEditingStarted: { model.tempo.beginLivePreview() }
+                onValueEditingFinished: { model.tempo.endLivePreview() }
+                onValueEditingCanceled: { model.tempo.cancelLivePreview() }
             }
         }
     }
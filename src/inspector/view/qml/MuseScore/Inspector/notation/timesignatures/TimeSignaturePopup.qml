@@ -72,6 +72,9 @@ StyledPopupView {
                     }
 
                     onValueEdited: { root.model.horizontalScale.value = newValue }
+                    onValueEditingStarted: { root.model.horizontalScale.beginLivePreview() }
+                    onValueEditingFinished: { root.model.horizontalScale.endLivePreview() }
+                    onValueEditingCanceled: { root.model.horizontalScale.cancelLivePreview() }
                 }
 
                 IncrementalPropertyControl {
@@ -96,6 +99,9 @@ StyledPopupView {
                     }
 
                     onValueEdited: { root.model.verticalScale.value = newValue }
+                    onValueEditingStarted: { root.model.verticalScale.beginLivePreview() }
+                    onValueEditingFinished: { root.model.verticalScale.endLivePreview() }
+                    onValueEditingCanceled: { root.model.verticalScale.cancelLivePreview() }
                 }
             }
         }
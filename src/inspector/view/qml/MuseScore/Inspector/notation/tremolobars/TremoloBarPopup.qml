@@ -122,6 +122,9 @@ StyledPopupView {
                     decimals: 2
 
                     onValueEdited: { model.lineThickness.value = newValue }
+                    onValueEditingStarted: { model.lineThickness.beginLivePreview() }
+                    onValueEditingFinished: { model.lineThickness.endLivePreview() }
+                    onValueEditingCanceled: { model.lineThickness.cancelLivePreview() }
                 }
             }
 
@@ -144,6 +147,9 @@ StyledPopupView {
                     decimals: 2
 
                     onValueEdited: { model.scale.value = newValue }
+                    onValueEditingStarted: { model.scale.beginLivePreview() }
+                    onValueEditingFinished: { model.scale.endLivePreview() }
+                    onValueEditingCanceled: { model.scale.cancelLivePreview() }
                 }
             }
         }
@@ -260,6 +260,9 @@ StyledPopupView {
                     maxValue: 5
 
                     onValueEdited: { root.model.frameThickness.value = newValue }
+                    onValueEditingStarted: { root.model.frameThickness.beginLivePreview() }
+                    onValueEditingFinished: { root.model.frameThickness.endLivePreview() }
+                    onValueEditingCanceled: { root.model.frameThickness.cancelLivePreview() }
                 }
             }
 
@@ -295,6 +298,9 @@ StyledPopupView {
                     maxValue: 5
 
                     onValueEdited: { root.model.frameMargin.value = newValue }
+                    onValueEditingStarted: { root.model.frameMargin.beginLivePreview() }
+                    onValueEditingFinished: { root.model.frameMargin.endLivePreview() }
+                    onValueEditingCanceled: { root.model.frameMargin.cancelLivePreview() }
                 }
             }
         }
@@ -329,6 +335,9 @@ StyledPopupView {
                 maxValue: 5
 
                 onValueEdited: { root.model.frameCornerRadius.value = newValue }
+                onValueEditingStarted: { root.model.frameCornerRadius.beginLivePreview() }
+                onValueEditingFinished: { root.model.frameCornerRadius.endLivePreview() }
+                onValueEditingCanceled: { root.model.frameCornerRadius.cancelLivePreview() }
             }
         }
 
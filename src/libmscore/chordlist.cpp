@@ -27,7 +27,45 @@
 #include "pitchspelling.h"
 #include "mscore.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Ms {
+namespace {
+//---------------------------------------------------------
+//   ParseKey
+//---------------------------------------------------------
+
+struct ParseKey {
+    QString text;
+    uint64_t chordList;         // identity of the chord list, 0 for none
+    bool syntaxOnly;
+    bool preferMinor;
+
+    bool operator==(const ParseKey& k) const
+    {
+        return chordList == k.chordList && syntaxOnly == k.syntaxOnly && preferMinor == k.preferMinor && text == k.text;
+    }
+};
+
+uint qHash(const ParseKey& k, uint seed = 0)
+{
+    return ::qHash(k.text, seed) ^ ::qHash(quint64(k.chordList)) ^ (uint(k.syntaxOnly) << 1) ^ uint(k.preferMinor);
+}
+
+static std::mutex parseCacheMutex;
+static QHash<ParseKey, ParsedChord> parseCache;
+
+static std::mutex sharedListsMutex;
+static QHash<QString, ChordList> sharedLists;
+
+static std::atomic<uint64_t> parseHits   { 0 };
+static std::atomic<uint64_t> parseMisses { 0 };
+static std::atomic<uint64_t> listHits    { 0 };
+static std::atomic<uint64_t> listMisses  { 0 };
+static std::atomic<uint64_t> identities  { 0 };
+}
+
 //---------------------------------------------------------
 //   HChord
 //---------------------------------------------------------
@@ -508,9 +546,39 @@ void ParsedChord::correctXmlText(const QString& s)
 //---------------------------------------------------------
 //  parse
 //    returns true if chord was parseable
+//    Must be called on a newly created ParsedChord; the
+//    result is taken from the parse cache if the same
+//    name was parsed before with the same chord list.
 //---------------------------------------------------------
 
 bool ParsedChord::parse(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
+{
+    const ParseKey key { s, cl ? cl->identity() : 0, syntaxOnly, preferMinor };
+    {
+        std::lock_guard<std::mutex> lock(parseCacheMutex);
+        auto i = parseCache.constFind(key);
+        if (i != parseCache.cend()) {
+            *this = i.value();
+            parseHits.fetch_add(1, std::memory_order_relaxed);
+            return _parseable;
+        }
+    }
+    parseMisses.fetch_add(1, std::memory_order_relaxed);
+    doParse(s, cl, syntaxOnly, preferMinor);
+
+    std::lock_guard<std::mutex> lock(parseCacheMutex);
+    if (parseCache.size() >= ChordList::MaxParsedChords) {
+        parseCache.clear();
+    }
+    parseCache.insert(key, *this);
+    return _parseable;
+}
+
+//---------------------------------------------------------
+//  doParse
+//---------------------------------------------------------
+
+bool ParsedChord::doParse(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
 {
     QString tok1, tok1L, tok2, tok2L;
     QString extensionDigits = "123456789";
@@ -1454,7 +1522,8 @@ QString ParsedChord::fromXml(const QString& rawKind, const QString& rawKindText,
     }
 
     // parse name to construct handle & tokenList
-    parse(_name, cl, true);
+    // (not cached, the modifier list is already set up)
+    doParse(_name, cl, true, false);
 
     // record original MusicXML
     _xmlKind = kind;
@@ -1721,6 +1790,7 @@ int ChordList::privateID = -1000;
 
 void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal madjust)
 {
+    _identity = newIdentity();
     _emag = emag;
     _eadjust = eadjust;
     _mmag = mmag;
@@ -1746,6 +1816,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 
 void ChordList::read(XmlReader& e)
 {
+    _identity = newIdentity();
     int fontIdx = fonts.size();
     _autoAdjust = false;
     while (e.readNextStartElement()) {
@@ -2010,6 +2081,92 @@ void ChordList::unload()
     renderListBase.clear();
     chordTokenList.clear();
     _autoAdjust = false;
+    _identity = newIdentity();
+}
+
+//---------------------------------------------------------
+//   readShared
+//    read chords.xml (optional) and the description file,
+//    or share the chord list of another style which did
+//    the same with the same auto adjust settings
+//---------------------------------------------------------
+
+void ChordList::readShared(const QString& descriptionFile, bool chordsXml)
+{
+    if (!empty() || !fonts.empty()) {
+        // merge into the existing list
+        if (chordsXml) {
+            read("chords.xml");
+        }
+        read(descriptionFile);
+        return;
+    }
+    QString key = QString("%1|%2|%3|%4|%5|%6").arg(descriptionFile).arg(chordsXml)
+                  .arg(_emag).arg(_eadjust).arg(_mmag).arg(_madjust);
+    QFileInfo fi(descriptionFile);
+    if (fi.isAbsolute()) {
+        // user files may change while we are running
+        key += "|" + fi.lastModified().toString(Qt::ISODateWithMs);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sharedListsMutex);
+        auto i = sharedLists.constFind(key);
+        if (i != sharedLists.cend()) {
+            *this = i.value();
+            listHits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    listMisses.fetch_add(1, std::memory_order_relaxed);
+    if (chordsXml) {
+        read("chords.xml");
+    }
+    read(descriptionFile);
+    if (!loaded()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sharedListsMutex);
+    if (sharedLists.size() >= MaxSharedLists) {
+        sharedLists.clear();
+    }
+    sharedLists.insert(key, *this);
+}
+
+//---------------------------------------------------------
+//   cacheStatistics
+//---------------------------------------------------------
+
+ChordCacheStatistics ChordList::cacheStatistics()
+{
+    ChordCacheStatistics s;
+    s.parseHits   = parseHits.load(std::memory_order_relaxed);
+    s.parseMisses = parseMisses.load(std::memory_order_relaxed);
+    s.listHits    = listHits.load(std::memory_order_relaxed);
+    s.listMisses  = listMisses.load(std::memory_order_relaxed);
+    return s;
+}
+
+//---------------------------------------------------------
+//   clearCaches
+//---------------------------------------------------------
+
+void ChordList::clearCaches()
+{
+    {
+        std::lock_guard<std::mutex> lock(parseCacheMutex);
+        parseCache.clear();
+    }
+    std::lock_guard<std::mutex> lock(sharedListsMutex);
+    sharedLists.clear();
+}
+
+//---------------------------------------------------------
+//   newIdentity
+//---------------------------------------------------------
+
+uint64_t ChordList::newIdentity()
+{
+    return identities.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 //---------------------------------------------------------
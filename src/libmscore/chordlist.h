@@ -23,6 +23,8 @@
 #ifndef __CHORDLIST_H__
 #define __CHORDLIST_H__
 
+#include <cstdint>
+
 #include <QMap>
 
 namespace Ms {
@@ -186,6 +188,7 @@ private:
     HChord chord;
     bool _parseable;
     bool _understandable;
+    bool doParse(const QString&, const ChordList*, bool syntaxOnly, bool preferMinor);
     void configure(const ChordList*);
     void correctXmlText(const QString& s = "");
     void addToken(QString, ChordTokenClass);
@@ -247,13 +250,31 @@ struct ChordFont {
     qreal mag;
 };
 
+//---------------------------------------------------------
+//   ChordCacheStatistics
+//---------------------------------------------------------
+
+struct ChordCacheStatistics {
+    uint64_t parseHits   { 0 };     // chord names found in the parse cache
+    uint64_t parseMisses { 0 };     // chord names which had to be parsed
+    uint64_t listHits    { 0 };     // chord lists shared with another style
+    uint64_t listMisses  { 0 };     // chord lists read from a description file
+};
+
 //---------------------------------------------------------
 //   ChordList
+//    Parsed chords are cached process-wide, keyed by the
+//    chord name, the identity of the chord list and the
+//    parse options. Chord lists read from description
+//    files are shared between all styles using the same
+//    files and settings; ChordList copies are cheap as
+//    the Qt containers are implicitly shared.
 //---------------------------------------------------------
 
 class ChordList : public QMap<int, ChordDescription>
 {
     QMap<QString, ChordSymbol> symbols;
+    uint64_t _identity { newIdentity() };     // changes whenever the list is (re)loaded
     bool _autoAdjust = false;
     qreal _nmag = 1.0, _nadjust = 0.0;
     qreal _emag = 1.0, _eadjust = 0.0;
@@ -271,15 +292,26 @@ public:
     qreal nominalMag() const { return _nmag; }
     qreal nominalAdjust() const { return _nadjust; }
     void configureAutoAdjust(qreal emag = 1.0, qreal eadjust = 0.0, qreal mmag = 1.0, qreal madjust = 0.0);
+    uint64_t identity() const { return _identity; }
     qreal position(const QStringList& names, ChordTokenClass ctc) const;
 
     void write(XmlWriter& xml) const;
     void read(XmlReader&);
     bool read(const QString&);
     bool write(const QString&) const;
+    void readShared(const QString& descriptionFile, bool chordsXml);
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    static ChordCacheStatistics cacheStatistics();
+    static void clearCaches();
+
+    static constexpr int MaxParsedChords = 16384;
+    static constexpr int MaxSharedLists  = 32;
+
+private:
+    static uint64_t newIdentity();
 };
 }     // namespace Ms
 #endif
@@ -24,6 +24,7 @@
 #define __ELEMENT_H__
 
 #include "elementgroup.h"
+#include "elementpool.h"
 #include "spatium.h"
 #include "fraction.h"
 #include "scoreElement.h"
@@ -208,6 +209,11 @@ public:
     virtual ~Element();
 
     Element& operator=(const Element&) = delete;
+
+    // elements are allocated from size class pools, see elementpool.h
+    static void* operator new(size_t size) { return ElementPool::allocate(size); }
+    static void operator delete(void* p, size_t size) { ElementPool::deallocate(p, size); }
+
     //@ create a copy of the element
     Q_INVOKABLE virtual Ms::Element* clone() const = 0;
     virtual Element* linkedClone();
@@ -0,0 +1,329 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "elementpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <QtGlobal>
+
+namespace Ms {
+namespace {
+//---------------------------------------------------------
+//   SizeClass
+//---------------------------------------------------------
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// header of a chunk, padded to Granularity
+struct Chunk {
+    Chunk* next;
+};
+static_assert(sizeof(Chunk) <= ElementPool::Granularity, "chunk header too big");
+
+struct SizeClass {
+    FreeBlock* freeList { nullptr };
+    Chunk* chunks       { nullptr };     // newest first
+    char* chunk         { nullptr };     // unused rest of the newest chunk
+    size_t chunkLeft    { 0 };
+    size_t live         { 0 };           // blocks handed out
+};
+
+static constexpr size_t NumSizeClasses = ElementPool::MaxPooledSize / ElementPool::Granularity;
+
+static SizeClass sizeClasses[NumSizeClasses];
+
+static std::atomic<uint64_t> allocations   { 0 };
+static std::atomic<uint64_t> deallocations { 0 };
+static std::atomic<uint64_t> bytes         { 0 };
+static std::atomic<uint64_t> reused        { 0 };
+static std::atomic<uint64_t> chunks        { 0 };
+static std::atomic<uint64_t> released      { 0 };
+static std::atomic<uint64_t> arenaBytes    { 0 };
+
+static thread_local LayoutArena* currentArena = nullptr;
+
+static size_t sizeClassIndex(size_t size)
+{
+    return (size + ElementPool::Granularity - 1) / ElementPool::Granularity - 1;
+}
+
+//---------------------------------------------------------
+//   isPoolThread
+//    the first thread using the pool owns it
+//---------------------------------------------------------
+
+static bool isPoolThread()
+{
+    static const std::thread::id owner = std::this_thread::get_id();
+    return std::this_thread::get_id() == owner;
+}
+
+//---------------------------------------------------------
+//   releaseIdle
+//    give back all chunks of an idle size class but the
+//    newest one, so a class which is used again does not
+//    request a chunk right away
+//---------------------------------------------------------
+
+static void releaseIdle(SizeClass& sc)
+{
+    Chunk* keep = sc.chunks;
+    if (!keep || !keep->next) {
+        return;
+    }
+    const char* begin = reinterpret_cast<const char*>(keep);
+    const char* end   = begin + ElementPool::ChunkSize;
+    FreeBlock* freeList = nullptr;
+    for (FreeBlock* b = sc.freeList; b;) {
+        FreeBlock* next = b->next;
+        const char* p = reinterpret_cast<const char*>(b);
+        if (p >= begin && p < end) {
+            b->next  = freeList;
+            freeList = b;
+        }
+        b = next;
+    }
+    sc.freeList = freeList;
+    for (Chunk* c = keep->next; c;) {
+        Chunk* next = c->next;
+        ::operator delete(c);
+        released.fetch_add(1, std::memory_order_relaxed);
+        c = next;
+    }
+    keep->next = nullptr;
+}
+}
+
+//---------------------------------------------------------
+//   operator-
+//---------------------------------------------------------
+
+AllocationStatistics AllocationStatistics::operator-(const AllocationStatistics& s) const
+{
+    AllocationStatistics d;
+    d.allocations   = allocations - s.allocations;
+    d.deallocations = deallocations - s.deallocations;
+    d.bytes         = bytes - s.bytes;
+    d.reused        = reused - s.reused;
+    d.chunks        = chunks - s.chunks;
+    d.released      = released - s.released;
+    d.arenaBytes    = arenaBytes - s.arenaBytes;
+    return d;
+}
+
+//---------------------------------------------------------
+//   allocate
+//---------------------------------------------------------
+
+void* ElementPool::allocate(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (size == 0 || size > MaxPooledSize) {
+        return ::operator new(size);
+    }
+    Q_ASSERT(isPoolThread());
+    const size_t idx       = sizeClassIndex(size);
+    const size_t blockSize = (idx + 1) * Granularity;
+    SizeClass& sc          = sizeClasses[idx];
+
+    ++sc.live;
+    if (sc.freeList) {
+        FreeBlock* b = sc.freeList;
+        sc.freeList  = b->next;
+        reused.fetch_add(1, std::memory_order_relaxed);
+        return b;
+    }
+    if (sc.chunkLeft < blockSize) {
+        // the rest of the old chunk is too small for another block and is lost
+        Chunk* c     = static_cast<Chunk*>(::operator new(ChunkSize));
+        c->next      = sc.chunks;
+        sc.chunks    = c;
+        sc.chunk     = reinterpret_cast<char*>(c) + Granularity;
+        sc.chunkLeft = ChunkSize - Granularity;
+        chunks.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* p = sc.chunk;
+    sc.chunk     += blockSize;
+    sc.chunkLeft -= blockSize;
+    return p;
+}
+
+//---------------------------------------------------------
+//   deallocate
+//---------------------------------------------------------
+
+void ElementPool::deallocate(void* p, size_t size)
+{
+    if (!p) {
+        return;
+    }
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0 || size > MaxPooledSize) {
+        ::operator delete(p);
+        return;
+    }
+    Q_ASSERT(isPoolThread());
+    SizeClass& sc = sizeClasses[sizeClassIndex(size)];
+    FreeBlock* b  = static_cast<FreeBlock*>(p);
+
+    b->next     = sc.freeList;
+    sc.freeList = b;
+    if (--sc.live == 0) {
+        releaseIdle(sc);
+    }
+}
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+AllocationStatistics ElementPool::statistics()
+{
+    AllocationStatistics s;
+    s.allocations   = allocations.load(std::memory_order_relaxed);
+    s.deallocations = deallocations.load(std::memory_order_relaxed);
+    s.bytes         = bytes.load(std::memory_order_relaxed);
+    s.reused        = reused.load(std::memory_order_relaxed);
+    s.chunks        = chunks.load(std::memory_order_relaxed);
+    s.released      = released.load(std::memory_order_relaxed);
+    s.arenaBytes    = arenaBytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+//---------------------------------------------------------
+//   addArenaBytes
+//---------------------------------------------------------
+
+void ElementPool::addArenaBytes(size_t n)
+{
+    arenaBytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+//   ~LayoutArena
+//---------------------------------------------------------
+
+LayoutArena::~LayoutArena()
+{
+    if (currentArena == this) {
+        currentArena = nullptr;
+    }
+    for (const Block& b : _blocks) {
+        ::operator delete(b.data);
+    }
+}
+
+//---------------------------------------------------------
+//   allocate
+//---------------------------------------------------------
+
+void* LayoutArena::allocate(size_t size, size_t align)
+{
+    for (;;) {
+        if (_block < _blocks.size()) {
+            Block& b = _blocks[_block];
+            size_t offset = (_offset + align - 1) & ~(align - 1);
+            if (offset + size <= b.size) {
+                _offset = offset + size;
+                _used  += size;
+                ElementPool::addArenaBytes(size);
+                return b.data + offset;
+            }
+            if (_block + 1 < _blocks.size()) {
+                ++_block;
+                _offset = 0;
+                continue;
+            }
+        }
+        size_t blockSize = std::max(BlockSize, size + align);
+        _blocks.push_back({ static_cast<char*>(::operator new(blockSize)), blockSize });
+        _block  = _blocks.size() - 1;
+        _offset = 0;
+    }
+}
+
+//---------------------------------------------------------
+//   rewind
+//    forget all allocations; the memory blocks are kept
+//    up to MaxKeptSize, so one big layout does not pin
+//    its peak memory
+//---------------------------------------------------------
+
+void LayoutArena::rewind()
+{
+    size_t kept = 0;
+    size_t n    = 0;
+    for (; n < _blocks.size() && kept + _blocks[n].size <= MaxKeptSize; ++n) {
+        kept += _blocks[n].size;
+    }
+    for (size_t i = n; i < _blocks.size(); ++i) {
+        ::operator delete(_blocks[i].data);
+    }
+    _blocks.resize(n);
+    _block  = 0;
+    _offset = 0;
+    _used   = 0;
+}
+
+//---------------------------------------------------------
+//   capacity
+//    size of the memory blocks held by the arena
+//---------------------------------------------------------
+
+size_t LayoutArena::capacity() const
+{
+    size_t n = 0;
+    for (const Block& b : _blocks) {
+        n += b.size;
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   current
+//---------------------------------------------------------
+
+LayoutArena* LayoutArena::current()
+{
+    return currentArena;
+}
+
+//---------------------------------------------------------
+//   setCurrent
+//    return the previous arena
+//---------------------------------------------------------
+
+LayoutArena* LayoutArena::setCurrent(LayoutArena* a)
+{
+    LayoutArena* prev = currentArena;
+    currentArena = a;
+    return prev;
+}
+}
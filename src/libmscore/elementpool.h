@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ELEMENTPOOL_H__
+#define __ELEMENTPOOL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace Ms {
+//---------------------------------------------------------
+//   AllocationStatistics
+//    counters of the element pool; a snapshot taken before
+//    and after an operation can be subtracted to get the
+//    allocations done by this operation
+//---------------------------------------------------------
+
+struct AllocationStatistics {
+    uint64_t allocations   { 0 };     // objects handed out
+    uint64_t deallocations { 0 };     // objects given back
+    uint64_t bytes         { 0 };     // bytes handed out
+    uint64_t reused        { 0 };     // allocations served from a free list
+    uint64_t chunks        { 0 };     // chunks requested from the system
+    uint64_t released      { 0 };     // chunks given back to the system
+    uint64_t arenaBytes    { 0 };     // bytes handed out by layout arenas
+
+    AllocationStatistics operator-(const AllocationStatistics& s) const;
+};
+
+//---------------------------------------------------------
+//   ElementPool
+//    size class allocator for Element and its subclasses
+//    - objects are grouped into size classes of
+//      Granularity bytes
+//    - memory is requested from the system in chunks;
+//      freed objects are kept in a free list of their
+//      size class and reused
+//    - when all objects of a size class are freed, all
+//      its chunks but the newest are given back
+//    - objects bigger than MaxPooledSize are allocated
+//      by the global operator new
+//    The pool is not synchronized: elements are created
+//    and deleted on the main thread only, this is asserted
+//    in debug builds.
+//---------------------------------------------------------
+
+class ElementPool
+{
+public:
+    static constexpr size_t Granularity   = 16;
+    static constexpr size_t MaxPooledSize = 1024;
+    static constexpr size_t ChunkSize     = 64 * 1024;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* p, size_t size);
+
+    static AllocationStatistics statistics();
+    static void addArenaBytes(size_t bytes);
+};
+
+//---------------------------------------------------------
+//   LayoutArena
+//    bump allocator for transient layout data
+//    Memory is released all at once when the arena is
+//    rewound or destroyed. Up to MaxKeptSize bytes of
+//    memory blocks are kept on rewind and reused by the
+//    next layout, the rest is given back.
+//---------------------------------------------------------
+
+class LayoutArena
+{
+    struct Block {
+        char* data;
+        size_t size;
+    };
+    std::vector<Block> _blocks;
+    size_t _block   { 0 };          // index of current block
+    size_t _offset  { 0 };          // offset in current block
+    size_t _used    { 0 };
+
+public:
+    static constexpr size_t BlockSize   = 64 * 1024;
+    static constexpr size_t MaxKeptSize = 16 * BlockSize;
+
+    LayoutArena() = default;
+    LayoutArena(const LayoutArena&) = delete;
+    LayoutArena& operator=(const LayoutArena&) = delete;
+    ~LayoutArena();
+
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+    void rewind();
+    size_t used() const { return _used; }
+    size_t capacity() const;
+
+    static LayoutArena* current();
+    static LayoutArena* setCurrent(LayoutArena*);
+};
+
+//---------------------------------------------------------
+//   LayoutArenaScope
+//    makes an arena the current arena for the lifetime
+//    of the scope; the arena is rewound on exit
+//---------------------------------------------------------
+
+class LayoutArenaScope
+{
+    LayoutArena* _arena;
+    LayoutArena* _prev;
+
+public:
+    LayoutArenaScope(LayoutArena* a)
+        : _arena(a), _prev(LayoutArena::setCurrent(a)) {}
+    ~LayoutArenaScope()
+    {
+        LayoutArena::setCurrent(_prev);
+        if (_arena != _prev) {
+            _arena->rewind();
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   ArenaAllocator
+//    STL allocator using the current LayoutArena;
+//    falls back to the heap if no arena is active
+//---------------------------------------------------------
+
+template<typename T>
+class ArenaAllocator
+{
+    LayoutArena* _arena;
+
+public:
+    typedef T value_type;
+
+    ArenaAllocator()
+        : _arena(LayoutArena::current()) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& a)
+        : _arena(a.arena()) {}
+
+    LayoutArena* arena() const { return _arena; }
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        if (_arena) {
+            return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        if (!_arena) {
+            ::operator delete(p);
+        }
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& a) const { return _arena == a.arena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& a) const { return _arena != a.arena(); }
+};
+}     // namespace Ms
+#endif
@@ -31,6 +31,7 @@
 #include "score.h"
 #include "sym.h"
 #include "xml.h"
+#include "fontmetricscache.h"
 
 // trying to do without it
 //#include <QQmlEngine>
@@ -503,7 +504,7 @@ void FiguredBassItem::layout()
     // (use the same font selection as used in draw() below)
     qreal m = score()->styleD(Sid::figuredBassFontSize) * spatium() / SPATIUM20;
     f.setPointSizeF(m);
-    QFontMetricsF fm(f, MScore::paintDevice());
+    CachedFontMetrics fm(f, MScore::paintDevice());
 
     QString str;
     x  = symWidth(SymId::noteheadBlack) * .5;
@@ -0,0 +1,279 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fontmetricscache.h"
+
+#include <atomic>
+#include <mutex>
+
+#include <QGuiApplication>
+#include <QHash>
+
+namespace Ms {
+//---------------------------------------------------------
+//   FontKey
+//---------------------------------------------------------
+
+namespace {
+struct FontKey {
+    QFont font;
+    const QPaintDevice* device;
+
+    bool operator==(const FontKey& k) const { return device == k.device && font == k.font; }
+};
+
+inline uint qHash(const FontKey& k, uint seed = 0)
+{
+    return ::qHash(k.font, seed) ^ ::qHash(quintptr(k.device), seed);
+}
+
+static std::mutex cacheMutex;
+static QHash<FontKey, std::shared_ptr<FontMetricsCache::Entry> > cache;
+static uint64_t cacheGeneration { 0 };          // generation of the entries in cache
+static bool watchingFonts { false };
+
+// changed when fonts are added or removed, the entries of
+// an older generation are dropped on the next lookup
+static std::atomic<uint64_t> fontGeneration { 0 };
+
+static std::atomic<uint64_t> fontHits   { 0 };
+static std::atomic<uint64_t> fontMisses { 0 };
+static std::atomic<uint64_t> textHits   { 0 };
+static std::atomic<uint64_t> textMisses { 0 };
+}
+
+//---------------------------------------------------------
+//   Entry
+//    the QFontMetricsF is only used with the entry
+//    mutex locked
+//---------------------------------------------------------
+
+struct FontMetricsCache::Entry {
+    QFontMetricsF fm;
+    qreal ascent;
+    qreal descent;
+    qreal height;
+    qreal lineSpacing;
+    qreal xHeight;
+
+    std::mutex mutex;
+    QHash<QString, qreal> widths;
+    QHash<QString, QRectF> rects;
+    QHash<QString, QRectF> tightRects;
+
+    Entry(const QFont& f, const QPaintDevice* device)
+        : fm(device ? QFontMetricsF(f, const_cast<QPaintDevice*>(device)) : QFontMetricsF(f))
+    {
+        ascent      = fm.ascent();
+        descent     = fm.descent();
+        height      = fm.height();
+        lineSpacing = fm.lineSpacing();
+        xHeight     = fm.xHeight();
+    }
+
+    //---------------------------------------------------------
+    //   lookup
+    //    value of s in hash, measured by f on a miss
+    //---------------------------------------------------------
+
+    template<typename T, typename F>
+    T lookup(QHash<QString, T>& hash, const QString& s, F f)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto i = hash.constFind(s);
+        if (i != hash.constEnd()) {
+            textHits.fetch_add(1, std::memory_order_relaxed);
+            return i.value();
+        }
+        textMisses.fetch_add(1, std::memory_order_relaxed);
+        if (hash.size() >= FontMetricsCache::MaxStrings) {
+            hash.clear();
+        }
+        T v = f(s);
+        hash.insert(s, v);
+        return v;
+    }
+};
+
+//---------------------------------------------------------
+//   watchFontDatabase
+//    clear the cache whenever Qt reports a change of the
+//    font database, e.g. QFontDatabase::addApplicationFont()
+//    Returns false if there is no application yet.
+//---------------------------------------------------------
+
+static bool watchFontDatabase()
+{
+    QGuiApplication* app = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+    if (!app) {
+        return false;
+    }
+    // emitted with the font database locked, clear() does not lock
+    QObject::connect(app, &QGuiApplication::fontDatabaseChanged, app, []() { FontMetricsCache::clear(); }, Qt::DirectConnection);
+    return true;
+}
+
+//---------------------------------------------------------
+//   entry
+//---------------------------------------------------------
+
+std::shared_ptr<FontMetricsCache::Entry> FontMetricsCache::entry(const QFont& font, const QPaintDevice* device)
+{
+    FontKey key { font, device };
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!watchingFonts) {
+        watchingFonts = watchFontDatabase();
+    }
+    const uint64_t generation = fontGeneration.load(std::memory_order_acquire);
+    if (generation != cacheGeneration) {
+        cache.clear();          // entries still in use are kept alive by their users
+        cacheGeneration = generation;
+    }
+    auto i = cache.constFind(key);
+    if (i != cache.constEnd()) {
+        fontHits.fetch_add(1, std::memory_order_relaxed);
+        return i.value();
+    }
+    fontMisses.fetch_add(1, std::memory_order_relaxed);
+    if (cache.size() >= MaxFonts) {
+        cache.clear();          // entries still in use are kept alive by their users
+    }
+    std::shared_ptr<Entry> e = std::make_shared<Entry>(font, device);
+    cache.insert(key, e);
+    return e;
+}
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+FontMetricsCache::Statistics FontMetricsCache::statistics()
+{
+    Statistics s;
+    s.fontHits   = fontHits.load(std::memory_order_relaxed);
+    s.fontMisses = fontMisses.load(std::memory_order_relaxed);
+    s.textHits   = textHits.load(std::memory_order_relaxed);
+    s.textMisses = textMisses.load(std::memory_order_relaxed);
+    return s;
+}
+
+//---------------------------------------------------------
+//   clear
+//    drop all entries, e.g. after fonts were added; the
+//    entries go on the next lookup, so this never waits
+//    for a lookup that is resolving a font
+//---------------------------------------------------------
+
+void FontMetricsCache::clear()
+{
+    fontGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   CachedFontMetrics
+//---------------------------------------------------------
+
+CachedFontMetrics::CachedFontMetrics(const QFont& font, const QPaintDevice* device)
+    : _entry(FontMetricsCache::entry(font, device))
+{
+}
+
+qreal CachedFontMetrics::ascent() const
+{
+    return _entry->ascent;
+}
+
+qreal CachedFontMetrics::descent() const
+{
+    return _entry->descent;
+}
+
+qreal CachedFontMetrics::height() const
+{
+    return _entry->height;
+}
+
+qreal CachedFontMetrics::lineSpacing() const
+{
+    return _entry->lineSpacing;
+}
+
+qreal CachedFontMetrics::xHeight() const
+{
+    return _entry->xHeight;
+}
+
+//---------------------------------------------------------
+//   width
+//---------------------------------------------------------
+
+qreal CachedFontMetrics::width(const QString& s) const
+{
+    const QFontMetricsF& fm = _entry->fm;
+    return _entry->lookup(_entry->widths, s, [&fm](const QString& str) { return fm.width(str); });
+}
+
+qreal CachedFontMetrics::width(QChar c) const
+{
+    return width(QString(c));
+}
+
+//---------------------------------------------------------
+//   boundingRect
+//---------------------------------------------------------
+
+QRectF CachedFontMetrics::boundingRect(const QString& s) const
+{
+    const QFontMetricsF& fm = _entry->fm;
+    return _entry->lookup(_entry->rects, s, [&fm](const QString& str) { return fm.boundingRect(str); });
+}
+
+//---------------------------------------------------------
+//   tightBoundingRect
+//---------------------------------------------------------
+
+QRectF CachedFontMetrics::tightBoundingRect(const QString& s) const
+{
+    const QFontMetricsF& fm = _entry->fm;
+    return _entry->lookup(_entry->tightRects, s, [&fm](const QString& str) { return fm.tightBoundingRect(str); });
+}
+
+//---------------------------------------------------------
+//   inFont
+//---------------------------------------------------------
+
+bool CachedFontMetrics::inFont(QChar c) const
+{
+    std::lock_guard<std::mutex> lock(_entry->mutex);
+    return _entry->fm.inFont(c);
+}
+
+//---------------------------------------------------------
+//   inFontUcs4
+//---------------------------------------------------------
+
+bool CachedFontMetrics::inFontUcs4(uint ucs4) const
+{
+    std::lock_guard<std::mutex> lock(_entry->mutex);
+    return _entry->fm.inFontUcs4(ucs4);
+}
+}
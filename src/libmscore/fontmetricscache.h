@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FONTMETRICSCACHE_H__
+#define __FONTMETRICSCACHE_H__
+
+#include <cstdint>
+#include <memory>
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QRectF>
+#include <QString>
+
+class QPaintDevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   FontMetricsCache
+//    metrics of the fonts used by text layout, shared by
+//    all texts of all scores
+//    Entries are keyed by the font (family, size, style
+//    flags) and the paint device. Every entry caches the
+//    widths and bounding rects of the strings measured
+//    with it. The cache can be used from any thread.
+//    It is cleared when the font database changes, as
+//    metrics resolved before a font was added are those
+//    of a fallback font.
+//---------------------------------------------------------
+
+class FontMetricsCache
+{
+public:
+    struct Statistics {
+        uint64_t fontHits   { 0 };      // fonts found in the cache
+        uint64_t fontMisses { 0 };      // fonts which had to be resolved
+        uint64_t textHits   { 0 };      // string measurements found in the cache
+        uint64_t textMisses { 0 };      // strings which had to be measured
+    };
+
+    struct Entry;
+
+    static std::shared_ptr<Entry> entry(const QFont&, const QPaintDevice*);
+    static Statistics statistics();
+    static void clear();
+
+    static constexpr int MaxFonts   = 512;
+    static constexpr int MaxStrings = 8192;   // per font
+};
+
+//---------------------------------------------------------
+//   CachedFontMetrics
+//    QFontMetricsF replacement for text layout;
+//    cheap to create if the font was used before
+//---------------------------------------------------------
+
+class CachedFontMetrics
+{
+    std::shared_ptr<FontMetricsCache::Entry> _entry;
+
+public:
+    CachedFontMetrics(const QFont& font, const QPaintDevice* device);
+    explicit CachedFontMetrics(const QFont& font)
+        : CachedFontMetrics(font, nullptr) {}
+
+    qreal ascent() const;
+    qreal descent() const;
+    qreal height() const;
+    qreal lineSpacing() const;
+    qreal xHeight() const;
+
+    qreal width(const QString&) const;
+    qreal width(QChar) const;
+    QRectF boundingRect(const QString&) const;
+    QRectF tightBoundingRect(const QString&) const;
+    bool inFont(QChar) const;
+    bool inFontUcs4(uint ucs4) const;
+};
+}     // namespace Ms
+#endif
@@ -29,28 +29,65 @@
 #include "mscore.h"
 
 namespace Ms {
+//---------------------------------------------------------
+//   countTrailingZeros
+//    a must not be 0
+//---------------------------------------------------------
+
+constexpr int countTrailingZeros(uint_least64_t a)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(a);
+#else
+    int n = 0;
+    while (!(a & 1)) {
+        a >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
 //---------------------------------------------------------
 //   gcd
 //    greatest common divisor. always returns a positive val
 //    however, since int / uint = uint by C++ rules,
 //    return int to avoid accidental implicit unsigned cast
+//    Binary (Stein's) algorithm: only shifts and subtractions,
+//    no divisions
 //---------------------------------------------------------
 
-static int_least64_t gcd(int_least64_t a, int_least64_t b)
+static constexpr int_least64_t gcd(int_least64_t a, int_least64_t b)
 {
-    int bp;
-    if (b > a) {
-        bp = b;
-        b = a;
-        a = bp;
-    }                                       // Saves one % if true
-    while (b != 0) {
-        bp = b;
-        b = a % b;
-        a = bp;
+    uint_least64_t u = a < 0 ? -uint_least64_t(a) : uint_least64_t(a);
+    uint_least64_t v = b < 0 ? -uint_least64_t(b) : uint_least64_t(b);
+    if (u == 0) {
+        return int_least64_t(v);
+    }
+    if (v == 0) {
+        return int_least64_t(u);
     }
+    const int shift = countTrailingZeros(u | v);
+    u >>= countTrailingZeros(u);
+    do {
+        v >>= countTrailingZeros(v);
+        if (u > v) {
+            const uint_least64_t t = v;
+            v = u;
+            u = t;
+        }
+        v -= u;
+    } while (v != 0);
+    return int_least64_t(u << shift);
+}
 
-    return a >= 0 ? a : -a;
+//---------------------------------------------------------
+//   isPowerOfTwo
+//---------------------------------------------------------
+
+constexpr bool isPowerOfTwo(int_least64_t a)
+{
+    return a > 0 && (a & (a - 1)) == 0;
 }
 
 //---------------------------------------------------------
@@ -75,8 +112,8 @@ public:
     constexpr Fraction(int z, int n)
         : _numerator{n < 0 ? -z : z}, _denominator{n < 0 ? -n : n} { }
 #endif
-    int numerator() const { return _numerator; }
-    int denominator() const { return _denominator; }
+    constexpr int numerator() const { return _numerator; }
+    constexpr int denominator() const { return _denominator; }
     int_least64_t& rnumerator() { return _numerator; }
     int_least64_t& rdenominator() { return _denominator; }
 
@@ -102,15 +139,15 @@ public:
         }
     }
 
-    bool isZero() const { return _numerator == 0; }
-    bool isNotZero() const { return _numerator != 0; }
-    bool negative() const { return _numerator < 0; }
+    constexpr bool isZero() const { return _numerator == 0; }
+    constexpr bool isNotZero() const { return _numerator != 0; }
+    constexpr bool negative() const { return _numerator < 0; }
 
-    bool isValid() const { return _denominator != 0; }
+    constexpr bool isValid() const { return _denominator != 0; }
 
     // check if two fractions are identical (numerator & denominator)
     // == operator checks for equal value:
-    bool identical(const Fraction& v) const
+    constexpr bool identical(const Fraction& v) const
     {
         return (_numerator == v._numerator)
                && (_denominator == v._denominator);
@@ -128,80 +165,103 @@ public:
 
     // --- reduction --- //
 
-    void reduce()
+    constexpr void reduce()
     {
-        const int g = gcd(_numerator, _denominator);
-        _numerator /= g;
-        _denominator /= g;
+        const int_least64_t g = gcd(_numerator, _denominator);
+        if (g > 1) {
+            _numerator /= g;
+            _denominator /= g;
+        }
     }
 
-    Fraction reduced() const
+    constexpr Fraction reduced() const
     {
-        const int g = gcd(_numerator, _denominator);
-        return Fraction(_numerator / g, _denominator / g);
+        Fraction f(*this);
+        f.reduce();
+        return f;
     }
 
     // --- comparison --- //
+    // Fractions are compared by cross multiplication, no reduction is
+    // needed. Values with the same denominator (the usual case for ticks
+    // of one measure) are compared directly.
 
-    bool operator<(const Fraction& val) const
+    constexpr bool operator<(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator < val._numerator;
+        }
         return _numerator * val._denominator < val._numerator * _denominator;
     }
 
-    bool operator<=(const Fraction& val) const
+    constexpr bool operator<=(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator <= val._numerator;
+        }
         return _numerator * val._denominator <= val._numerator * _denominator;
     }
 
-    bool operator>=(const Fraction& val) const
+    constexpr bool operator>=(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator >= val._numerator;
+        }
         return _numerator * val._denominator >= val._numerator * _denominator;
     }
 
-    bool operator>(const Fraction& val) const
+    constexpr bool operator>(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator > val._numerator;
+        }
         return _numerator * val._denominator > val._numerator * _denominator;
     }
 
-    bool operator==(const Fraction& val) const
+    constexpr bool operator==(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator == val._numerator;
+        }
         return _numerator * val._denominator == val._numerator * _denominator;
     }
 
-    bool operator!=(const Fraction& val) const
+    constexpr bool operator!=(const Fraction& val) const
     {
-        return _numerator * val._denominator != val._numerator * _denominator;
+        return !(*this == val);
     }
 
     // --- arithmetic --- //
+    // Sums and differences are not reduced (deferred normalization).
+    // The common denominator of two powers of two (all durations
+    // without tuplets) is the bigger one, no gcd is needed.
 
-    Fraction& operator+=(const Fraction& val)
+    constexpr Fraction& operator+=(const Fraction& val)
     {
         if (_denominator == val._denominator) {
             _numerator += val._numerator;        // Common enough use case to be handled separately for efficiency
+        } else if (isPowerOfTwo(_denominator) && isPowerOfTwo(val._denominator)) {
+            if (_denominator > val._denominator) {
+                _numerator += val._numerator * (_denominator / val._denominator);
+            } else {
+                _numerator = _numerator * (val._denominator / _denominator) + val._numerator;
+                _denominator = val._denominator;
+            }
         } else {
-            const int g = gcd(_denominator, val._denominator);
-            const int m1 = val._denominator / g;       // This saves one division over straight lcm
+            const int_least64_t g = gcd(_denominator, val._denominator);
+            const int_least64_t m1 = val._denominator / g;       // This saves one division over straight lcm
             _numerator = _numerator * m1 + val._numerator * (_denominator / g);
             _denominator = m1 * _denominator;
         }
         return *this;
     }
 
-    Fraction& operator-=(const Fraction& val)
+    constexpr Fraction& operator-=(const Fraction& val)
     {
-        if (_denominator == val._denominator) {
-            _numerator -= val._numerator;       // Common enough use case to be handled separately for efficiency
-        } else {
-            const int g = gcd(_denominator, val._denominator);
-            const int m1 = val._denominator / g;       // This saves one division over straight lcm
-            _numerator = _numerator * m1 - val._numerator * (_denominator / g);
-            _denominator = m1 * _denominator;
-        }
-        return *this;
+        return *this += Fraction(-val);
     }
 
-    Fraction& operator*=(const Fraction& val)
+    constexpr Fraction& operator*=(const Fraction& val)
     {
         _numerator *= val._numerator;
         _denominator *= val._denominator;
@@ -211,13 +271,13 @@ public:
         return *this;
     }
 
-    Fraction& operator*=(int val)
+    constexpr Fraction& operator*=(int val)
     {
         _numerator *= val;
         return *this;
     }
 
-    Fraction& operator/=(const Fraction& val)
+    constexpr Fraction& operator/=(const Fraction& val)
     {
         const int sign = (val._numerator >= 0 ? 1 : -1);
         _numerator   *= (sign * val._denominator);
@@ -228,7 +288,7 @@ public:
         return *this;
     }
 
-    Fraction& operator/=(int val)
+    constexpr Fraction& operator/=(int val)
     {
         _denominator *= val;
         if (_denominator < 0) {
@@ -239,12 +299,12 @@ public:
         return *this;
     }
 
-    Fraction operator+(const Fraction& v) const { return Fraction(*this) += v; }
-    Fraction operator-(const Fraction& v) const { return Fraction(*this) -= v; }
-    Fraction operator-() const { return Fraction(-_numerator, _denominator); }
-    Fraction operator*(const Fraction& v) const { return Fraction(*this) *= v; }
-    Fraction operator/(const Fraction& v) const { return Fraction(*this) /= v; }
-    Fraction operator/(int v)             const { return Fraction(*this) /= v; }
+    constexpr Fraction operator+(const Fraction& v) const { return Fraction(*this) += v; }
+    constexpr Fraction operator-(const Fraction& v) const { return Fraction(*this) -= v; }
+    constexpr Fraction operator-() const { Fraction f(*this); f._numerator = -f._numerator; return f; }
+    constexpr Fraction operator*(const Fraction& v) const { return Fraction(*this) *= v; }
+    constexpr Fraction operator/(const Fraction& v) const { return Fraction(*this) /= v; }
+    constexpr Fraction operator/(int v)             const { return Fraction(*this) /= v; }
 
     //---------------------------------------------------------
     //   fromTicks
@@ -305,8 +365,8 @@ public:
     }
 };
 
-inline Fraction operator*(const Fraction& f, int v) { return Fraction(f) *= v; }
-inline Fraction operator*(int v, const Fraction& f) { return Fraction(f) *= v; }
+constexpr Fraction operator*(const Fraction& f, int v) { return Fraction(f) *= v; }
+constexpr Fraction operator*(int v, const Fraction& f) { return Fraction(f) *= v; }
 }     // namespace Ms
 
 Q_DECLARE_METATYPE(Ms::Fraction)
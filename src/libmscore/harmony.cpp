@@ -22,9 +22,13 @@
 
 #include "harmony.h"
 
+#include <atomic>
+#include <mutex>
+
 #include <QStack>
 
 #include "chordlist.h"
+#include "fontmetricscache.h"
 #include "fret.h"
 #include "measure.h"
 #include "mscore.h"
@@ -40,6 +44,50 @@
 #include "xml.h"
 
 namespace Ms {
+namespace {
+//---------------------------------------------------------
+//   RenderKey
+//    everything Harmony::render() depends on
+//---------------------------------------------------------
+
+struct RenderKey {
+    uint64_t chordList;
+    int id;
+    int rootTpc, baseTpc;
+    int capo;
+    NoteSpellingType rootSpelling, baseSpelling;
+    NoteCaseType rootRenderCase, baseRenderCase;
+    HarmonyType harmonyType;
+    bool leftParen, rightParen;
+    qreal moveScale;            // spatium * mag for MOVE actions
+    QFont font;
+    QString textName;
+    QString function;
+
+    bool operator==(const RenderKey& k) const
+    {
+        return chordList == k.chordList && id == k.id && rootTpc == k.rootTpc && baseTpc == k.baseTpc
+               && capo == k.capo && rootSpelling == k.rootSpelling && baseSpelling == k.baseSpelling
+               && rootRenderCase == k.rootRenderCase && baseRenderCase == k.baseRenderCase
+               && harmonyType == k.harmonyType && leftParen == k.leftParen && rightParen == k.rightParen
+               && moveScale == k.moveScale && font == k.font && textName == k.textName && function == k.function;
+    }
+};
+
+uint qHash(const RenderKey& k, uint seed = 0)
+{
+    uint h = ::qHash(quint64(k.chordList), seed) ^ ::qHash(k.textName) ^ ::qHash(k.font);
+    h ^= uint(k.id) * 31u + uint(k.rootTpc) * 997u + uint(k.baseTpc) * 7919u + uint(k.capo);
+    return h ^ ::qHash(k.moveScale) ^ uint(k.harmonyType);
+}
+
+static std::mutex renderCacheMutex;
+static QHash<RenderKey, QList<TextSegment> > renderCache;      // compiled runs, never modified
+
+static std::atomic<uint64_t> renderHits   { 0 };
+static std::atomic<uint64_t> renderMisses { 0 };
+}
+
 //---------------------------------------------------------
 //   harmonyName
 //---------------------------------------------------------
@@ -1606,7 +1654,7 @@ TextSegment::TextSegment(const QString& s, const QFont& f, qreal x, qreal y)
 
 qreal TextSegment::width() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
+    CachedFontMetrics fm(font, MScore::paintDevice());
 #if 1
     return fm.width(text);
 #else
@@ -1628,7 +1676,7 @@ qreal TextSegment::width() const
 
 QRectF TextSegment::boundingRect() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
+    CachedFontMetrics fm(font, MScore::paintDevice());
     return fm.boundingRect(text);
 }
 
@@ -1638,7 +1686,7 @@ QRectF TextSegment::boundingRect() const
 
 QRectF TextSegment::tightBoundingRect() const
 {
-    QFontMetricsF fm(font, MScore::paintDevice());
+    CachedFontMetrics fm(font, MScore::paintDevice());
     return fm.tightBoundingRect(text);
 }
 
@@ -1775,6 +1823,8 @@ void Harmony::render(const QList<RenderAction>& renderList, qreal& x, qreal& y,
 //---------------------------------------------------------
 //   render
 //    construct Chord Symbol
+//    The text segments are compiled once per chord, spelling
+//    and font and taken from the render cache afterwards.
 //---------------------------------------------------------
 
 void Harmony::render()
@@ -1783,6 +1833,37 @@ void Harmony::render()
 
     ChordList* chordList = score()->style().chordList();
 
+    for (const TextSegment* s : qAsConst(textList)) {
+        delete s;
+    }
+    textList.clear();
+
+    determineRootBaseSpelling();
+
+    // may generate a description and so change _id and _textName
+    const ChordDescription* cd = nullptr;
+    if (_rootTpc != Tpc::TPC_INVALID || _harmonyType == HarmonyType::NASHVILLE) {
+        cd = getDescription();
+    }
+
+    const RenderKey key {
+        chordList->identity(), _id, _rootTpc, _baseTpc, capo, _rootSpelling, _baseSpelling,
+        _rootRenderCase, _baseRenderCase, _harmonyType, _leftParen, _rightParen,
+        magS() * spatium(), font(), _textName, _function
+    };
+    {
+        std::lock_guard<std::mutex> lock(renderCacheMutex);
+        auto i = renderCache.constFind(key);
+        if (i != renderCache.cend()) {
+            for (const TextSegment& ts : i.value()) {
+                textList.append(new TextSegment(ts));
+            }
+            renderHits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    renderMisses.fetch_add(1, std::memory_order_relaxed);
+
     fontList.clear();
     for (const ChordFont& cf : qAsConst(chordList->fonts)) {
         QFont ff(font());
@@ -1796,14 +1877,8 @@ void Harmony::render()
         fontList.append(font());
     }
 
-    for (const TextSegment* s : qAsConst(textList)) {
-        delete s;
-    }
-    textList.clear();
     qreal x = 0.0, y = 0.0;
 
-    determineRootBaseSpelling();
-
     if (_leftParen) {
         render("( ", x, y);
     }
@@ -1812,7 +1887,6 @@ void Harmony::render()
         // render root
         render(chordList->renderListRoot, x, y, _rootTpc, _rootSpelling, _rootRenderCase);
         // render extension
-        const ChordDescription* cd = getDescription();
         if (cd) {
             render(cd->renderList, x, y, 0);
         }
@@ -1822,7 +1896,6 @@ void Harmony::render()
         qreal adjust = chordList->nominalAdjust();
         y += adjust * magS() * spatium() * .2;
         // render extension
-        const ChordDescription* cd = getDescription();
         if (cd) {
             render(cd->renderList, x, y, 0);
         }
@@ -1864,7 +1937,6 @@ void Harmony::render()
         render(chordList->renderListRoot, x, y, capoRootTpc, _rootSpelling, _rootRenderCase);
 
         // render extension
-        const ChordDescription* cd = getDescription();
         if (cd) {
             render(cd->renderList, x, y, 0);
         }
@@ -1878,6 +1950,38 @@ void Harmony::render()
     if (_rightParen) {
         render(" )", x, y);
     }
+
+    QList<TextSegment> run;
+    for (const TextSegment* ts : qAsConst(textList)) {
+        run.append(*ts);
+    }
+    std::lock_guard<std::mutex> lock(renderCacheMutex);
+    if (renderCache.size() >= MaxRenderedChords) {
+        renderCache.clear();
+    }
+    renderCache.insert(key, run);
+}
+
+//---------------------------------------------------------
+//   renderStatistics
+//---------------------------------------------------------
+
+HarmonyRenderStatistics Harmony::renderStatistics()
+{
+    HarmonyRenderStatistics s;
+    s.hits   = renderHits.load(std::memory_order_relaxed);
+    s.misses = renderMisses.load(std::memory_order_relaxed);
+    return s;
+}
+
+//---------------------------------------------------------
+//   clearRenderCache
+//---------------------------------------------------------
+
+void Harmony::clearRenderCache()
+{
+    std::lock_guard<std::mutex> lock(renderCacheMutex);
+    renderCache.clear();
 }
 
 //---------------------------------------------------------
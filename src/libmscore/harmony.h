@@ -55,6 +55,15 @@ struct TextSegment {
     void setText(const QString& t) { text = t; }
 };
 
+//---------------------------------------------------------
+//   HarmonyRenderStatistics
+//---------------------------------------------------------
+
+struct HarmonyRenderStatistics {
+    uint64_t hits   { 0 };        // chord symbols taken from the render cache
+    uint64_t misses { 0 };        // chord symbols rendered from the chord list
+};
+
 //---------------------------------------------------------
 //   @@ Harmony
 ///    root note and bass note are notated as "tonal pitch class":
@@ -193,6 +202,9 @@ public:
     void read(XmlReader&) override;
     QString harmonyName() const;
     void render();
+    static HarmonyRenderStatistics renderStatistics();
+    static void clearRenderCache();
+    static constexpr int MaxRenderedChords = 4096;
 
     const ChordDescription* parseHarmony(const QString& s, int* root, int* base, bool syntaxOnly = false);
 
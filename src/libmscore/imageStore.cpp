@@ -78,6 +78,7 @@ bool ImageStoreItem::isUsed(Score* score) const
 
 void ImageStoreItem::load()
 {
+    decode();
     if (!_buffer.isEmpty()) {
         return;
     }
@@ -93,6 +94,28 @@ void ImageStoreItem::load()
     _hash = h.result();
 }
 
+//---------------------------------------------------------
+//   decode
+//    get the data of a lazily added image; the hash was
+//    taken from the name, data not matching it is dropped
+//    as add() would not find it under that name either
+//---------------------------------------------------------
+
+void ImageStoreItem::decode() const
+{
+    if (!_loader) {
+        return;
+    }
+    _buffer = _loader();
+    _loader = nullptr;
+    QCryptographicHash h(QCryptographicHash::Md4);
+    h.addData(_buffer);
+    if (h.result() != _hash) {
+        qDebug("ImageStoreItem::decode(%s): content does not match the name", qPrintable(_path));
+        _buffer.clear();
+    }
+}
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -132,6 +155,31 @@ inline static int toInt(char c)
     return c - 'a' + 10;
 }
 
+//---------------------------------------------------------
+//   hashFromName
+//    images are stored under their hash name, see
+//    ImageStoreItem::hashName(); return an empty array
+//    if the base name is not a hash
+//---------------------------------------------------------
+
+static QByteArray hashFromName(const QString& s)
+{
+    if (s.size() != 32) {
+        return QByteArray();
+    }
+    QByteArray hash(16, 0);
+    for (int i = 0; i < 32; ++i) {
+        const QChar c = s[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return QByteArray();
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+    }
+    return hash;
+}
+
 #if 0
 //---------------------------------------------------------
 //   dumpHash
@@ -184,10 +232,7 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
 
         return 0;
     }
-    QByteArray hash(16, 0);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
-    }
+    QByteArray hash = hashFromName(s);
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
             return item;
@@ -217,6 +262,31 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addLazy
+//    add an image whose data is produced by loader when
+//    it is first used; the hash is taken from the name and
+//    verified on first use, images with other names are
+//    loaded immediately
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addLazy(const QString& path, std::function<QByteArray()> loader)
+{
+    QByteArray hash = hashFromName(QFileInfo(path).completeBaseName());
+    if (hash.isEmpty()) {
+        return add(path, loader());
+    }
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setLoader(loader, hash);
+    _items.push_back(item);
+    return item;
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
@@ -23,6 +23,8 @@
 #ifndef __IMAGE_CACHE_H__
 #define __IMAGE_CACHE_H__
 
+#include <functional>
+
 #include <QList>
 #include <QString>
 #include <QByteArray>
@@ -40,8 +42,11 @@ class ImageStoreItem
     QList<Image*> _references;
     QString _path;                  // original location of image
     QString _type;                  // image type (file extension)
-    QByteArray _buffer;
+    mutable QByteArray _buffer;
     QByteArray _hash;               // 16 byte md4 hash of _buffer
+    mutable std::function<QByteArray()> _loader;    // produces _buffer on first use
+
+    void decode() const;
 
 public:
     ImageStoreItem(const QString& p);
@@ -49,16 +54,17 @@ public:
     void reference(Image*);
 
     const QString& path() const { return _path; }
-    QByteArray& buffer() { return _buffer; }
-    const QByteArray& buffer() const { return _buffer; }
-    bool loaded() const { return !_buffer.isEmpty(); }
+    QByteArray& buffer() { decode(); return _buffer; }
+    const QByteArray& buffer() const { decode(); return _buffer; }
+    bool loaded() const { return !_buffer.isEmpty() || _loader; }
     void setPath(const QString& val);
     bool isUsed(Score*) const;
     bool isUsed() const { return !_references.empty(); }
     void load();
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
-    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; _loader = nullptr; }
+    void setLoader(std::function<QByteArray()> l, const QByteArray& h) { _buffer.clear(); _hash = h; _loader = l; }
 };
 
 //---------------------------------------------------------
@@ -78,6 +84,7 @@ public:
 
     ImageStoreItem* getImage(const QString& path) const;
     ImageStoreItem* add(const QString& path, const QByteArray&);
+    ImageStoreItem* addLazy(const QString& path, std::function<QByteArray()> loader);
     void clearUnused();
 
     typedef ItemList::iterator iterator;
@@ -81,6 +81,8 @@
 #include "fermata.h"
 #include "measurenumber.h"
 
+#include "log.h"
+
 namespace Ms {
 // #define PAGE_DEBUG
 
@@ -1389,6 +1391,10 @@ void Score::hideEmptyStaves(System* system, bool isFirstSystem)
     int staffIdx = 0;
     bool systemIsEmpty = true;
 
+    // united occupancy of all measures of the system, built on first use
+    StaffOccupancy occupancy;
+    bool occupancyBuilt = false;
+
     for (Staff* staff : qAsConst(_staves)) {
         SysStaff* ss  = system->staff(staffIdx);
 
@@ -1399,55 +1405,32 @@ void Score::hideEmptyStaves(System* system, bool isFirstSystem)
                 && (staves > 1)
                 && !(isFirstSystem && styleB(Sid::dontHideStavesInFirstSystem))
                 && hideMode != Staff::HideMode::NEVER)) {
-            bool hideStaff = true;
-            for (MeasureBase* m : system->measures()) {
-                if (!m->isMeasure()) {
-                    continue;
-                }
-                Measure* measure = toMeasure(m);
-                if (!measure->isEmpty(staffIdx)) {
-                    hideStaff = false;
-                    break;
+            if (!occupancyBuilt) {
+                occupancy.reset(staves);
+                for (MeasureBase* m : system->measures()) {
+                    if (m->isMeasure()) {
+                        occupancy.unite(toMeasure(m)->staffOccupancy());
+                    }
                 }
+                occupancyBuilt = true;
             }
+            bool hideStaff = !occupancy.occupied(staffIdx);
             // check if notes moved into this staff
             Part* part = staff->part();
             int n = part->nstaves();
             if (hideStaff && (n > 1)) {
-                int idx = part->staves()->front()->idx();
-                for (int i = 0; i < part->nstaves(); ++i) {
-                    int st = idx + i;
-
-                    for (MeasureBase* mb : system->measures()) {
-                        if (!mb->isMeasure()) {
-                            continue;
-                        }
-                        Measure* m = toMeasure(mb);
-                        if (staff->hideWhenEmpty() == Staff::HideMode::INSTRUMENT && !m->isEmpty(st)) {
+                if (staff->hideWhenEmpty() == Staff::HideMode::INSTRUMENT) {
+                    int idx = part->staves()->front()->idx();
+                    for (int i = 0; i < n; ++i) {
+                        if (occupancy.occupied(idx + i)) {
                             hideStaff = false;
                             break;
                         }
-                        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-                            for (int voice = 0; voice < VOICES; ++voice) {
-                                ChordRest* cr = s->cr(st * VOICES + voice);
-                                if (cr == 0 || cr->isRest()) {
-                                    continue;
-                                }
-                                int staffMove = cr->staffMove();
-                                if (staffIdx == st + staffMove) {
-                                    hideStaff = false;
-                                    break;
-                                }
-                            }
-                        }
-                        if (!hideStaff) {
-                            break;
-                        }
-                    }
-                    if (!hideStaff) {
-                        break;
                     }
                 }
+                if (occupancy.movedInto(staffIdx)) {
+                    hideStaff = false;
+                }
             }
             ss->setShow(hideStaff ? false : staff->show());
             if (ss->show()) {
@@ -1663,6 +1646,7 @@ static void distributeStaves(Page* page)
 {
     Score* score { page->score() };
     VerticalGapDataList vgdl;
+    vgdl.reserve(page->systems().size() * score->nstaves());
 
     // Find and classify all gaps between staves.
     int ngaps { 0 };
@@ -1675,12 +1659,11 @@ static void distributeStaves(Page* page)
     bool transferCurlyBracket  { false };
     for (System* system : page->systems()) {
         if (system->vbox()) {
-            VerticalGapData* vgd = new VerticalGapData(!ngaps++, system, nullptr, nullptr, nullptr, prevYBottom);
-            vgd->addSpaceAroundVBox(true);
+            vgdl.emplace_back(!ngaps++, system, nullptr, nullptr, nullptr, prevYBottom);
+            vgdl.back().addSpaceAroundVBox(true);
             prevYBottom = system->y();
             yBottom     = system->y() + system->height();
             vbox        = true;
-            vgdl.append(vgd);
             transferNormalBracket = false;
             transferCurlyBracket  = false;
         } else {
@@ -1708,7 +1691,8 @@ static void distributeStaves(Page* page)
                     continue;
                 }
 
-                VerticalGapData* vgd = new VerticalGapData(!ngaps++, system, staff, sysStaff, nextSpacer, prevYBottom);
+                vgdl.emplace_back(!ngaps++, system, staff, sysStaff, nextSpacer, prevYBottom);
+                VerticalGapData* vgd = &vgdl.back();
                 nextSpacer = system->downSpacer(staff->idx());
 
                 if (newSystem) {
@@ -1736,7 +1720,6 @@ static void distributeStaves(Page* page)
                 prevYBottom  = system->y() + sysStaff->y() + sysStaff->bbox().height();
                 yBottom      = system->y() + sysStaff->y() + sysStaff->skyline().south().max();
                 spacerOffset = sysStaff->skyline().south().max() - sysStaff->bbox().height();
-                vgdl.append(vgd);
             }
             transferNormalBracket = endNormalBracket >= 0;
             transferCurlyBracket  = endCurlyBracket >= 0;
@@ -1753,34 +1736,38 @@ static void distributeStaves(Page* page)
     }
 
     // Try to make the gaps equal, taking the spread factors and maximum spacing into account.
+    // Each pass raises the gaps of the lowest level to the next level.
     static const int maxPasses { 20 };     // Saveguard to prevent endless loops.
     int pass { 0 };
+    LayoutVector<VerticalGapData*> modified;
+    modified.reserve(vgdl.size());
     while (!almostZero(spaceLeft) && (ngaps > 0) && (++pass < maxPasses)) {
         ngaps = 0;
-        qreal smallest     { vgdl.smallest() };
-        qreal nextSmallest { vgdl.smallest(smallest) };
+        const VerticalGapDataList::Levels levels { vgdl.levels() };
+        const qreal smallest { levels.smallest };
+        qreal nextSmallest   { levels.nextSmallest };
         if (almostZero(smallest) || almostZero(nextSmallest)) {
             break;
         }
 
-        if ((nextSmallest - smallest) * vgdl.sumStretchFactor() > spaceLeft) {
-            nextSmallest = smallest + spaceLeft / vgdl.sumStretchFactor();
+        if ((nextSmallest - smallest) * levels.stretch > spaceLeft) {
+            nextSmallest = smallest + spaceLeft / levels.stretch;
         }
 
         qreal addedSpace { 0.0 };
-        VerticalGapDataList modified;
-        for (VerticalGapData* vgd : vgdl) {
-            if (!almostZero(vgd->spacing() - smallest)) {
+        modified.clear();
+        for (VerticalGapData& vgd : vgdl) {
+            if (!almostZero(vgd.spacing() - smallest)) {
                 continue;
             }
-            qreal step { nextSmallest - vgd->spacing() };
+            qreal step { nextSmallest - vgd.spacing() };
             if (step < 0.0) {
                 continue;
             }
-            step = vgd->addSpacing(step);
+            step = vgd.addSpacing(step);
             if (!almostZero(step)) {
-                addedSpace += step * vgd->factor();
-                modified.append(vgd);
+                addedSpace += step * vgd.factor();
+                modified.push_back(&vgd);
                 ++ngaps;
             }
             if ((spaceLeft - addedSpace) <= 0.0) {
@@ -1800,48 +1787,49 @@ static void distributeStaves(Page* page)
     // If there is still space left, distribute the space of the staves.
     // However, there is a limit on how much space is added per gap.
     const qreal maxPageFill { score->styleP(Sid::maxPageFillSpread) };
-    spaceLeft = qMin(maxPageFill * vgdl.length(), spaceLeft);
+    spaceLeft = qMin(maxPageFill * vgdl.size(), spaceLeft);
     pass = 0;
     ngaps = 1;
     while (!almostZero(spaceLeft) && !almostZero(maxPageFill) && (ngaps > 0) && (++pass < maxPasses)) {
         ngaps = 0;
         qreal addedSpace { 0.0 };
         qreal step { spaceLeft / vgdl.sumStretchFactor() };
-        for (VerticalGapData* vgd : vgdl) {
-            qreal res { vgd->addFillSpacing(step, maxPageFill) };
+        for (VerticalGapData& vgd : vgdl) {
+            qreal res { vgd.addFillSpacing(step, maxPageFill) };
             if (!almostZero(res)) {
-                addedSpace += res * vgd->factor();
+                addedSpace += res * vgd.factor();
                 ++ngaps;
             }
         }
         spaceLeft -= addedSpace;
     }
 
-    QSet<System*> systems;
+    // the gaps of a system are consecutive
+    LayoutVector<System*> systems;
     qreal systemShift { 0.0 };
     qreal staffShift  { 0.0 };
     System* prvSystem { nullptr };
-    for (VerticalGapData* vgd : vgdl) {
-        if (vgd->sysStaff) {
-            systems.insert(vgd->system);
+    for (VerticalGapData& vgd : vgdl) {
+        if (vgd.sysStaff && (systems.empty() || systems.back() != vgd.system)) {
+            systems.push_back(vgd.system);
         }
-        systemShift += vgd->actualAddedSpace();
-        if (prvSystem == vgd->system) {
-            staffShift += vgd->actualAddedSpace();
+        systemShift += vgd.actualAddedSpace();
+        if (prvSystem == vgd.system) {
+            staffShift += vgd.actualAddedSpace();
         } else {
-            vgd->system->rypos() += systemShift;
+            vgd.system->rypos() += systemShift;
             if (prvSystem) {
-                prvSystem->setDistance(vgd->system->y() - prvSystem->y());
+                prvSystem->setDistance(vgd.system->y() - prvSystem->y());
                 prvSystem->setHeight(prvSystem->height() + staffShift);
             }
             staffShift = 0.0;
         }
 
-        if (vgd->sysStaff) {
-            vgd->sysStaff->bbox().translate(0.0, staffShift);
+        if (vgd.sysStaff) {
+            vgd.sysStaff->bbox().translate(0.0, staffShift);
         }
 
-        prvSystem = vgd->system;
+        prvSystem = vgd.system;
     }
     if (prvSystem) {
         prvSystem->setHeight(prvSystem->height() + staffShift);
@@ -1852,7 +1840,6 @@ static void distributeStaves(Page* page)
         system->layoutBracketsVertical();
         system->layoutInstrumentNames();
     }
-    vgdl.deleteAll();
 }
 
 //---------------------------------------------------------
@@ -1992,7 +1979,7 @@ struct Spring {
         : seg(i), stretch(s), fix(f) {}
 };
 
-typedef std::multimap<qreal, Spring, std::less<qreal> > SpringMap;
+typedef std::multimap<qreal, Spring, std::less<qreal>, ArenaAllocator<std::pair<const qreal, Spring> > > SpringMap;
 
 //---------------------------------------------------------
 //   sff2
@@ -2666,6 +2653,42 @@ static bool breakMultiMeasureRest(Measure* m)
     return false;
 }
 
+//---------------------------------------------------------
+//   scanMMRestRun
+//    collect the measures following m which may be joined
+//    into a multi measure rest starting at m or a later
+//    measure of the run; every measure is checked only
+//    once per layout
+//---------------------------------------------------------
+
+void Score::scanMMRestRun(LayoutContext& lc, Measure* m)
+{
+    lc.mmrRun.clear();
+    lc.mmrPos = 0;
+    bool valid = m == lc.mmrStop ? lc.mmrStopValid : validMMRestMeasure(m);
+    lc.mmrStop = nullptr;
+    lc.mmrStopValid = false;
+    if (!valid) {
+        lc.mmrStop = m;
+        return;
+    }
+    Measure* nm = m;
+    for (;;) {
+        lc.mmrRun.push_back(nm);
+        MeasureBase* mb = _showVBox ? nm->next() : nm->nextMeasure();
+        if (!(mb && mb->isMeasure())) {
+            break;
+        }
+        nm = toMeasure(mb);
+        valid = validMMRestMeasure(nm);
+        if (!valid || breakMultiMeasureRest(nm)) {
+            lc.mmrStop = nm;
+            lc.mmrStopValid = valid;
+            break;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   adjustMeasureNo
 //---------------------------------------------------------
@@ -3045,6 +3068,7 @@ std::pair<qreal, qreal> extendedStemLenWithTwoNoteTremolo(Tremolo* tremolo, qrea
 
 void Score::getNextMeasure(LayoutContext& lc)
 {
+    LayoutPhaseScope phase(lc, LayoutStatistics::Phase::MEASURES);
     lc.prevMeasure = lc.curMeasure;
     lc.curMeasure  = lc.nextMeasure;
     if (!lc.curMeasure) {
@@ -3061,26 +3085,28 @@ void Score::getNextMeasure(LayoutContext& lc)
     if (lc.curMeasure->isMeasure()) {
         if (score()->styleB(Sid::createMultiMeasureRests)) {
             Measure* m = toMeasure(lc.curMeasure);
-            Measure* nm = m;
-            Measure* lm = nm;
+            Measure* lm = m;
             int n       = 0;
             Fraction len;
 
-            while (validMMRestMeasure(nm)) {
-                MeasureBase* mb = _showVBox ? nm->next() : nm->nextMeasure();
-                if (breakMultiMeasureRest(nm) && n) {
-                    break;
-                }
+            // the rest of the run is still valid if m was part of the last scan
+            size_t i = lc.mmrPos;
+            while (i < lc.mmrRun.size() && lc.mmrRun[i] != m) {
+                ++i;
+            }
+            if (i == lc.mmrRun.size()) {
+                scanMMRestRun(lc, m);
+                i = 0;
+            }
+            lc.mmrPos = i;
+            for (; i < lc.mmrRun.size(); ++i) {
+                Measure* nm = lc.mmrRun[i];
                 if (nm != m) {
                     lc.adjustMeasureNo(nm);
                 }
                 ++n;
                 len += nm->ticks();
                 lm = nm;
-                if (!(mb && mb->isMeasure())) {
-                    break;
-                }
-                nm = toMeasure(mb);
             }
             if (n >= styleI(Sid::minEmptyMeasures)) {
                 createMMRest(m, lm, len);
@@ -3117,6 +3143,7 @@ void Score::getNextMeasure(LayoutContext& lc)
         lc.tick += measure->ticks();
         return;
     }
+    ++lc.statistics.measures;
 
     measure->connectTremolo();
 
@@ -3409,142 +3436,84 @@ bool notTopTuplet(ChordRest* cr)
 
 //---------------------------------------------------------
 //   findLyricsMaxY
+//    how far the autoplaced lyrics below cr have to move
+//    down to keep clear of the staff; sk is scratch space
 //---------------------------------------------------------
 
-static qreal findLyricsMaxY(Segment& s, int staffIdx)
+static qreal findLyricsMaxY(ChordRest* cr, const SysStaff* ss, SkylineLine& sk, qreal lyricsMinTopDistance)
 {
-    qreal yMax = 0.0;
-    if (!s.isChordRestType()) {
-        return yMax;
-    }
-
-    qreal lyricsMinTopDistance = s.score()->styleP(Sid::lyricsMinTopDistance);
-
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            SkylineLine sk(true);
-
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    qreal yOff = l->offset().y();
-                    QPointF offset = l->pos() + cr->pos() + s.pos() + s.measure()->pos();
-                    QRectF r = l->bbox().translated(offset);
-                    r.translate(0.0, -yOff);
-                    sk.add(r.x(), r.top(), r.width());
-                }
-            }
-            SysStaff* ss = s.measure()->system()->staff(staffIdx);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    qreal y = ss->skyline().south().minDistance(sk);
-                    if (y > -lyricsMinTopDistance) {
-                        yMax = qMax(yMax, y + lyricsMinTopDistance);
-                    }
-                }
-            }
+    Segment* s = cr->segment();
+    bool found = false;
+    sk.clear();
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeBelow()) {
+            qreal yOff = l->offset().y();
+            QPointF offset = l->pos() + cr->pos() + s->pos() + s->measure()->pos();
+            QRectF r = l->bbox().translated(offset);
+            r.translate(0.0, -yOff);
+            sk.add(r.x(), r.top(), r.width());
+            found = true;
         }
     }
-    return yMax;
+    if (!found) {
+        return 0.0;
+    }
+    // the distance is the same for all verses
+    qreal y = ss->skyline().south().minDistance(sk);
+    return y > -lyricsMinTopDistance ? y + lyricsMinTopDistance : 0.0;
 }
 
 //---------------------------------------------------------
 //   findLyricsMinY
+//    how far the autoplaced lyrics above cr have to move
+//    up to keep clear of the staff; sk is scratch space
 //---------------------------------------------------------
 
-static qreal findLyricsMinY(Segment& s, int staffIdx)
+static qreal findLyricsMinY(ChordRest* cr, const SysStaff* ss, SkylineLine& sk, qreal lyricsMinTopDistance)
 {
-    qreal yMin = 0.0;
-    if (!s.isChordRestType()) {
-        return yMin;
-    }
-    qreal lyricsMinTopDistance = s.score()->styleP(Sid::lyricsMinTopDistance);
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            SkylineLine sk(false);
-
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeAbove()) {
-                    qreal yOff = l->offset().y();
-                    QRectF r = l->bbox().translated(l->pos() + cr->pos() + s.pos() + s.measure()->pos());
-                    r.translate(0.0, -yOff);
-                    sk.add(r.x(), r.bottom(), r.width());
-                }
-            }
-            SysStaff* ss = s.measure()->system()->staff(staffIdx);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeAbove()) {
-                    qreal y = sk.minDistance(ss->skyline().north());
-                    if (y > -lyricsMinTopDistance) {
-                        yMin = qMin(yMin, -y - lyricsMinTopDistance);
-                    }
-                }
-            }
+    Segment* s = cr->segment();
+    bool found = false;
+    sk.clear();
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeAbove()) {
+            qreal yOff = l->offset().y();
+            QRectF r = l->bbox().translated(l->pos() + cr->pos() + s->pos() + s->measure()->pos());
+            r.translate(0.0, -yOff);
+            sk.add(r.x(), r.bottom(), r.width());
+            found = true;
         }
     }
-    return yMin;
-}
-
-static qreal findLyricsMaxY(Measure* m, int staffIdx)
-{
-    qreal yMax = 0.0;
-    for (Segment& s : m->segments()) {
-        yMax = qMax(yMax, findLyricsMaxY(s, staffIdx));
-    }
-    return yMax;
-}
-
-static qreal findLyricsMinY(Measure* m, int staffIdx)
-{
-    qreal yMin = 0.0;
-    for (Segment& s : m->segments()) {
-        yMin = qMin(yMin, findLyricsMinY(s, staffIdx));
+    if (!found) {
+        return 0.0;
     }
-    return yMin;
+    qreal y = sk.minDistance(ss->skyline().north());
+    return y > -lyricsMinTopDistance ? -y - lyricsMinTopDistance : 0.0;
 }
 
 //---------------------------------------------------------
 //   applyLyricsMax
 //---------------------------------------------------------
 
-static void applyLyricsMax(Segment& s, int staffIdx, qreal yMax)
+static void applyLyricsMax(ChordRest* cr, Skyline& sk, qreal yMax, qreal lyricsMinBottomDistance)
 {
-    if (!s.isChordRestType()) {
-        return;
-    }
-    Skyline& sk = s.measure()->system()->staff(staffIdx)->skyline();
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            qreal lyricsMinBottomDistance = s.score()->styleP(Sid::lyricsMinBottomDistance);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    l->rypos() += yMax - l->propertyDefault(Pid::OFFSET).toPointF().y();
-                    if (l->addToSkyline()) {
-                        QPointF offset = l->pos() + cr->pos() + s.pos() + s.measure()->pos();
-                        sk.add(l->bbox().translated(offset).adjusted(0.0, 0.0, 0.0, lyricsMinBottomDistance));
-                    }
-                }
+    Segment* s = cr->segment();
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeBelow()) {
+            l->rypos() += yMax - l->propertyDefault(Pid::OFFSET).toPointF().y();
+            if (l->addToSkyline()) {
+                QPointF offset = l->pos() + cr->pos() + s->pos() + s->measure()->pos();
+                sk.add(l->bbox().translated(offset).adjusted(0.0, 0.0, 0.0, lyricsMinBottomDistance));
             }
         }
     }
 }
 
-static void applyLyricsMax(Measure* m, int staffIdx, qreal yMax)
-{
-    for (Segment& s : m->segments()) {
-        applyLyricsMax(s, staffIdx, yMax);
-    }
-}
-
 //---------------------------------------------------------
 //   applyLyricsMin
 //---------------------------------------------------------
 
-static void applyLyricsMin(ChordRest* cr, int staffIdx, qreal yMin)
+static void applyLyricsMin(ChordRest* cr, Skyline& sk, qreal yMin)
 {
-    Skyline& sk = cr->measure()->system()->staff(staffIdx)->skyline();
     for (Lyrics* l : cr->lyrics()) {
         if (l->autoplace() && l->placeAbove()) {
             l->rypos() += yMin - l->propertyDefault(Pid::OFFSET).toPointF().y();
@@ -3556,20 +3525,6 @@ static void applyLyricsMin(ChordRest* cr, int staffIdx, qreal yMin)
     }
 }
 
-static void applyLyricsMin(Measure* m, int staffIdx, qreal yMin)
-{
-    for (Segment& s : m->segments()) {
-        if (s.isChordRestType()) {
-            for (int voice = 0; voice < VOICES; ++voice) {
-                ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-                if (cr) {
-                    applyLyricsMin(cr, staffIdx, yMin);
-                }
-            }
-        }
-    }
-}
-
 //---------------------------------------------------------
 //   restoreBeams
 //---------------------------------------------------------
@@ -3607,6 +3562,12 @@ void Score::layoutLyrics(System* system)
     //int nAbove[nstaves()];
     std::vector<int> VnAbove(nstaves());
 
+    // chord rests with lyrics in layout order, staff after staff;
+    // the chord rests of visibleStaves[i] end at staffEnd[i]
+    LayoutVector<ChordRest*> crs;
+    LayoutVector<size_t> staffEnd;
+    staffEnd.reserve(visibleStaves.size());
+
     for (int staffIdx : visibleStaves) {
         VnAbove[staffIdx] = 0;
         for (MeasureBase* mb : system->measures()) {
@@ -3637,83 +3598,92 @@ void Score::layoutLyrics(System* system)
                                 }
                             }
                             VnAbove[staffIdx] = qMax(VnAbove[staffIdx], nA);
+                            if (!cr->lyrics().empty()) {
+                                crs.push_back(cr);
+                            }
                         }
                     }
                 }
             }
         }
+        staffEnd.push_back(crs.size());
     }
 
-    for (int staffIdx : visibleStaves) {
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (Segment& s : m->segments()) {
-                if (s.isChordRestType()) {
-                    for (int voice = 0; voice < VOICES; ++voice) {
-                        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-                        if (cr) {
-                            for (Lyrics* l : cr->lyrics()) {
-                                l->layout2(VnAbove[staffIdx]);
-                            }
-                        }
-                    }
-                }
+    size_t begin = 0;
+    for (size_t i = 0; i < visibleStaves.size(); ++i) {
+        for (size_t j = begin; j < staffEnd[i]; ++j) {
+            for (Lyrics* l : crs[j]->lyrics()) {
+                l->layout2(VnAbove[visibleStaves[i]]);
             }
         }
+        begin = staffEnd[i];
     }
 
-    VerticalAlignRange ar = VerticalAlignRange(styleI(Sid::autoplaceVerticalAlignRange));
+    //-------------------------------------------------------------
+    //    align the lyrics of a segment, measure or system;
+    //    the staves do not share skylines, so each staff is
+    //    done completely before the next one
+    //-------------------------------------------------------------
 
-    switch (ar) {
-    case VerticalAlignRange::MEASURE:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
+    VerticalAlignRange ar = VerticalAlignRange(styleI(Sid::autoplaceVerticalAlignRange));
+    const qreal lyricsMinTopDistance    = styleP(Sid::lyricsMinTopDistance);
+    const qreal lyricsMinBottomDistance = styleP(Sid::lyricsMinBottomDistance);
+    SkylineLine below(true);
+    SkylineLine above(false);
+
+    // end of the measure (or segment) starting at crs[j]
+    auto groupEnd = [&crs, ar](size_t j, size_t end) {
+        size_t k = j + 1;
+        if (ar == VerticalAlignRange::SEGMENT) {
+            while (k < end && crs[k]->segment() == crs[j]->segment()) {
+                ++k;
             }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                qreal yMax = findLyricsMaxY(m, staffIdx);
-                applyLyricsMax(m, staffIdx, yMax);
+        } else {
+            while (k < end && crs[k]->segment()->measure() == crs[j]->segment()->measure()) {
+                ++k;
             }
         }
-        break;
-    case VerticalAlignRange::SYSTEM:
-        for (int staffIdx : visibleStaves) {
+        return k;
+    };
+
+    begin = 0;
+    for (size_t i = 0; i < visibleStaves.size(); ++i) {
+        const size_t end = staffEnd[i];
+        SysStaff* ss = system->staff(visibleStaves[i]);
+        Skyline& sk = ss->skyline();
+
+        if (ar == VerticalAlignRange::SYSTEM) {
             qreal yMax = 0.0;
             qreal yMin = 0.0;
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
-                }
-                yMax = qMax<qreal>(yMax, findLyricsMaxY(toMeasure(mb), staffIdx));
-                yMin = qMin(yMin, findLyricsMinY(toMeasure(mb), staffIdx));
+            for (size_t j = begin; j < end; ++j) {
+                yMax = qMax<qreal>(yMax, findLyricsMaxY(crs[j], ss, below, lyricsMinTopDistance));
+                yMin = qMin(yMin, findLyricsMinY(crs[j], ss, above, lyricsMinTopDistance));
             }
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
+            // measure by measure, the skyline grows in that order
+            for (size_t j = begin; j < end;) {
+                const size_t k = groupEnd(j, end);
+                for (size_t n = j; n < k; ++n) {
+                    applyLyricsMax(crs[n], sk, yMax, lyricsMinBottomDistance);
                 }
-                applyLyricsMax(toMeasure(mb), staffIdx, yMax);
-                applyLyricsMin(toMeasure(mb), staffIdx, yMin);
-            }
-        }
-        break;
-    case VerticalAlignRange::SEGMENT:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
+                for (size_t n = j; n < k; ++n) {
+                    applyLyricsMin(crs[n], sk, yMin);
+                }
+                j = k;
             }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                for (Segment& s : m->segments()) {
-                    qreal yMax = findLyricsMaxY(s, staffIdx);
-                    applyLyricsMax(s, staffIdx, yMax);
+        } else {
+            for (size_t j = begin; j < end;) {
+                const size_t k = groupEnd(j, end);
+                qreal yMax = 0.0;
+                for (size_t n = j; n < k; ++n) {
+                    yMax = qMax(yMax, findLyricsMaxY(crs[n], ss, below, lyricsMinTopDistance));
                 }
+                for (size_t n = j; n < k; ++n) {
+                    applyLyricsMax(crs[n], sk, yMax, lyricsMinBottomDistance);
+                }
+                j = k;
             }
         }
-        break;
+        begin = end;
     }
 }
 
@@ -3751,7 +3721,7 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
 //   layoutHarmonies
 //---------------------------------------------------------
 
-void layoutHarmonies(const std::vector<Segment*>& sl)
+void layoutHarmonies(const LayoutVector<Segment*>& sl)
 {
     for (const Segment* s : sl) {
         for (Element* e : s->annotations()) {
@@ -3773,7 +3743,7 @@ void layoutHarmonies(const std::vector<Segment*>& sl)
 //   alignHarmonies
 //---------------------------------------------------------
 
-void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool harmony, const qreal maxShiftAbove,
+void alignHarmonies(const System* system, const LayoutVector<Segment*>& sl, bool harmony, const qreal maxShiftAbove,
                     const qreal maxShiftBelow)
 {
     // Help class.
@@ -3942,9 +3912,9 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
 //   processLines
 //---------------------------------------------------------
 
-static void processLines(System* system, std::vector<Spanner*> lines, bool align)
+static void processLines(System* system, const LayoutVector<Spanner*>& lines, bool align)
 {
-    std::vector<SpannerSegment*> segments;
+    LayoutVector<SpannerSegment*> segments;
     for (Spanner* sp : lines) {
         SpannerSegment* ss = sp->layoutSystem(system);         // create/layout spanner segment for this system
         if (ss->autoplace()) {
@@ -3956,7 +3926,7 @@ static void processLines(System* system, std::vector<Spanner*> lines, bool align
         const int nstaves = system->staves()->size();
         constexpr qreal minY = -1000000.0;
         const qreal defaultY = segments[0]->rypos();
-        std::vector<qreal> y(nstaves, minY);
+        LayoutVector<qreal> y(nstaves, minY);
 
         for (SpannerSegment* ss : segments) {
             if (ss->visible()) {
@@ -3996,6 +3966,15 @@ System* Score::collectSystem(LayoutContext& lc)
     if (!lc.curMeasure) {
         return 0;
     }
+    mu::framework::TraceSpan span("collectSystem");
+    if (span.isActive()) {
+        span.arg("startTick", lc.curMeasure->tick().ticks());
+    }
+    LayoutPhaseScope phase(lc, LayoutStatistics::Phase::SYSTEMS);
+    // temporaries of this system are released when it is done;
+    // containers of lc keep allocating from the layout arena
+    LayoutArenaScope arenaScope(masterScore()->systemLayoutArena());
+    ++lc.statistics.systems;
     const MeasureBase* measure  = _systems.empty() ? 0 : _systems.back()->measures().back();
     if (measure) {
         measure = measure->findPotentialSectionBreak();
@@ -4361,11 +4340,14 @@ System* Score::collectSystem(LayoutContext& lc)
 
 void Score::layoutSystemElements(System* system, LayoutContext& lc)
 {
+    LayoutPhaseScope phase(lc, LayoutStatistics::Phase::SYSTEM_ELEMENTS);
+    LayoutArenaScope arenaScope(masterScore()->systemLayoutArena());
+
     //-------------------------------------------------------------
     //    create cr segment list to speed up computations
     //-------------------------------------------------------------
 
-    std::vector<Segment*> sl;
+    LayoutVector<Segment*> sl;
     for (MeasureBase* mb : system->measures()) {
         if (!mb->isMeasure()) {
             continue;
@@ -4635,7 +4617,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
     Fraction etick = useRange ? lc.endTick : system->measures().back()->endTick();
     auto spanners = score()->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
 
-    std::vector<Spanner*> spanner;
+    LayoutVector<Spanner*> spanner;
     for (auto interval : spanners) {
         Spanner* sp = interval.value;
         sp->computeStartElement();
@@ -4654,7 +4636,10 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
             }
         }
     }
+    // segment positions are final here; slurs only look at the segments they overlap
+    system->segmentShapes().build(system);
     processLines(system, spanner, false);
+    system->segmentShapes().clear();
     for (auto s : spanner) {
         Slur* slur = toSlur(s);
         ChordRest* scr = s->startCR();
@@ -4667,7 +4652,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
         }
     }
 
-    std::vector<Dynamic*> dynamics;
+    LayoutVector<Dynamic*> dynamics;
     for (Segment* s : sl) {
         for (Element* e : s->elist()) {
             if (!e) {
@@ -4715,10 +4700,10 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
     //-------------------------------------------------------------
 
     spanner.clear();
-    std::vector<Spanner*> hairpins;
-    std::vector<Spanner*> ottavas;
-    std::vector<Spanner*> pedal;
-    std::vector<Spanner*> voltas;
+    LayoutVector<Spanner*> hairpins;
+    LayoutVector<Spanner*> ottavas;
+    LayoutVector<Spanner*> pedal;
+    LayoutVector<Spanner*> voltas;
 
     for (auto interval : spanners) {
         Spanner* sp = interval.value;
@@ -4851,7 +4836,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
     // vertical align volta segments
     //
     for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
-        std::vector<SpannerSegment*> voltaSegments;
+        LayoutVector<SpannerSegment*> voltaSegments;
         for (SpannerSegment* ss : system->spannerSegments()) {
             if (ss->isVoltaSegment() && ss->staffIdx() == staffIdx) {
                 voltaSegments.push_back(ss);
@@ -4943,6 +4928,13 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
 
 void LayoutContext::collectPage()
 {
+    mu::framework::TraceSpan span("collectPage");
+    if (span.isActive()) {
+        span.arg("page", curPage);
+    }
+    LayoutPhaseScope phase(*this, LayoutStatistics::Phase::PAGES);
+    ++statistics.pages;
+
     const qreal slb = score->styleP(Sid::staffLowerBorder);
     bool breakPages = score->layoutMode() != LayoutMode::SYSTEM;
     qreal ey        = page->height() - page->bm();
@@ -5186,6 +5178,9 @@ void LayoutContext::collectPage()
 
 void Score::doLayout()
 {
+    // a full layout (after reading a score, for instance) must not
+    // trust occupancy bits computed before the elements were complete
+    Measure::invalidateAllStaffOccupancy();
     doLayoutRange(Fraction(0, 1), Fraction(-1, 1));
 }
 
@@ -5202,13 +5197,38 @@ public:
     ~CmdStateLocker() { score->cmdState().unlock(); }
 };
 
+//---------------------------------------------------------
+//   LayoutAllocationCounter
+//    record the element allocations of a layout
+//---------------------------------------------------------
+
+class LayoutAllocationCounter
+{
+    MasterScore* score;
+    AllocationStatistics start;
+public:
+    LayoutAllocationCounter(MasterScore* s)
+        : score(s), start(ElementPool::statistics()) {}
+    ~LayoutAllocationCounter() { score->setLayoutAllocations(ElementPool::statistics() - start); }
+};
+
 //---------------------------------------------------------
 //   doLayoutRange
 //---------------------------------------------------------
 
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
+    mu::framework::TraceSpan span("doLayoutRange");
+    if (span.isActive()) {
+        span.arg("score", title().toStdString());
+        span.arg("startTick", st.ticks());
+        span.arg("endTick", et.ticks());
+        span.arg("staves", nstaves());
+    }
+
     CmdStateLocker cmdStateLocker(this);
+    LayoutAllocationCounter allocationCounter(masterScore());
+    LayoutArenaScope arenaScope(masterScore()->layoutArena());
     LayoutContext lc(this);
 
     Fraction stick(st);
@@ -5423,6 +5443,9 @@ LayoutContext::LayoutContext(Score* s)
     : score(s)
 {
     firstSystemIndent = score && score->styleB(Sid::enableIndentationOnFirstSystem);
+    layoutStart = std::chrono::steady_clock::now();
+    phaseStart = layoutStart;
+    shapesAtStart = Segment::createdShapes();
 }
 
 //---------------------------------------------------------
@@ -5435,11 +5458,32 @@ LayoutContext::~LayoutContext()
         s->layoutSystemsDone();
     }
 
+    switchPhase(LayoutStatistics::Phase::OTHER);
+    statistics.shapes  = Segment::createdShapes() - shapesAtStart;
+    statistics.totalMs = std::chrono::duration<double, std::milli>(phaseStart - layoutStart).count();
+    score->setLayoutStatistics(statistics);
+
     for (MuseScoreView* v : score->getViewer()) {
         v->layoutChanged();
     }
 }
 
+//---------------------------------------------------------
+//   LayoutContext::switchPhase
+//    charge the time since the last switch to the current
+//    phase and make p current; returns the previous phase
+//---------------------------------------------------------
+
+LayoutStatistics::Phase LayoutContext::switchPhase(LayoutStatistics::Phase p)
+{
+    auto now = std::chrono::steady_clock::now();
+    statistics.phaseMs[int(phase)] += std::chrono::duration<double, std::milli>(now - phaseStart).count();
+    phaseStart = now;
+    LayoutStatistics::Phase prev = phase;
+    phase = p;
+    return prev;
+}
+
 //---------------------------------------------------------
 //   VerticalStretchData
 //      defines a gap ABOVE the staff.
@@ -5533,25 +5577,6 @@ void VerticalGapData::insideCurlyBracket()
     _maxActualSpacing = system->score()->styleP(Sid::maxAkkoladeDistance) / _factor;
 }
 
-//---------------------------------------------------------
-//   factor
-//---------------------------------------------------------
-
-qreal VerticalGapData::factor() const
-{
-    return _factor;
-}
-
-//---------------------------------------------------------
-//   spacing
-//    return normalised spacing
-//---------------------------------------------------------
-
-qreal VerticalGapData::spacing() const
-{
-    return _normalisedSpacing + _addedNormalisedSpace;
-}
-
 //---------------------------------------------------------
 //   addedSpace
 //---------------------------------------------------------
@@ -5618,17 +5643,6 @@ qreal VerticalGapData::addFillSpacing(qreal step, qreal maxFill)
     return res;
 }
 
-//---------------------------------------------------------
-//   deleteAll
-//---------------------------------------------------------
-
-void VerticalGapDataList::deleteAll()
-{
-    for (auto vsd : *this) {
-        delete vsd;
-    }
-}
-
 //---------------------------------------------------------
 //   sumStretchFactor
 //---------------------------------------------------------
@@ -5636,32 +5650,69 @@ void VerticalGapDataList::deleteAll()
 qreal VerticalGapDataList::sumStretchFactor() const
 {
     qreal sum { 0.0 };
-    for (VerticalGapData* vsd : *this) {
-        if (!vsd->isFixedHeight()) {
-            sum += vsd->factor();
+    for (const VerticalGapData& vgd : *this) {
+        if (!vgd.isFixedHeight()) {
+            sum += vgd.factor();
         }
     }
     return sum;
 }
 
 //---------------------------------------------------------
-//   smallest
+//   levels
+//    smallest spacing, next smallest spacing and stretch
+//    factor sum of the stretchable gaps in a single pass.
+//    Gaps with the same qCeil() of their spacing count as
+//    one level. qCeil() is monotonic, so it is enough to
+//    track the minima of the two lowest levels; the lowest
+//    can be the excluded level -1 (spacing in (-2, -1]).
 //---------------------------------------------------------
 
-qreal VerticalGapDataList::smallest(qreal limit) const
+VerticalGapDataList::Levels VerticalGapDataList::levels() const
 {
-    VerticalGapData* vdp { nullptr };
-    for (VerticalGapData* vgd : *this) {
-        if (vgd->isFixedHeight()) {
-            continue;
-        }
-        if ((qCeil(limit) == qCeil(vgd->spacing()))) {
+    Levels l;
+    int level1 { 0 };
+    int level2 { 0 };
+    qreal min1 { 0.0 };
+    qreal min2 { 0.0 };
+    int found  { 0 };
+    for (const VerticalGapData& vgd : *this) {
+        if (vgd.isFixedHeight()) {
             continue;
         }
-        if (!vdp || (vgd->spacing() < vdp->spacing())) {
-            vdp = vgd;
-        }
-    }
-    return vdp ? vdp->spacing() : 0.0;
+        const qreal s { vgd.spacing() };
+        const int level { qCeil(s) };
+        l.stretch += vgd.factor();
+        if (found == 0) {
+            level1 = level;
+            min1 = s;
+            found = 1;
+        } else if (level == level1) {
+            min1 = qMin(min1, s);
+        } else if (level < level1) {
+            level2 = level1;
+            min2 = min1;
+            level1 = level;
+            min1 = s;
+            found = 2;
+        } else if (found == 1 || level < level2) {
+            level2 = level;
+            min2 = s;
+            found = 2;
+        } else if (level == level2) {
+            min2 = qMin(min2, s);
+        }
+    }
+    if (found == 0) {
+        return l;
+    }
+    if (level1 != -1) {
+        l.smallest     = min1;
+        l.nextSmallest = found == 2 ? min2 : 0.0;
+    } else if (found == 2) {
+        l.smallest     = min2;
+        l.nextSmallest = min1;
+    }
+    return l;
 }
 }
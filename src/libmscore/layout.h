@@ -23,15 +23,41 @@
 #ifndef __LAYOUT_H__
 #define __LAYOUT_H__
 
+#include <chrono>
 #include <set>
+#include <vector>
 #include <QList>
 
+#include "elementpool.h"
+#include "layoutstatistics.h"
+#include "skyline.h"
 #include "system.h"
 
 namespace Ms {
 class Segment;
 class Page;
 
+//---------------------------------------------------------
+//   LayoutVector
+//    scratch vector for values which live no longer than
+//    a layout; the storage comes from the score's
+//    LayoutArena and is reused by the next layout
+//---------------------------------------------------------
+
+template<typename T>
+using LayoutVector = std::vector<T, ArenaAllocator<T> >;
+
+//---------------------------------------------------------
+//   MinWidthScratch
+//    buffers of Measure::computeMinWidth(), kept by the
+//    master score so they are allocated only once
+//---------------------------------------------------------
+
+struct MinWidthScratch {
+    std::vector<HorizontalSkyline> envelope;      // per staff
+    std::vector<Segment*> added;
+};
+
 //---------------------------------------------------------
 //   VerticalStretchData
 //    helper class for spreading staves over a page
@@ -63,8 +89,8 @@ public:
     void addSpaceAroundCurlyBracket();
     void insideCurlyBracket();
 
-    qreal factor() const;
-    qreal spacing() const;
+    qreal factor() const { return _factor; }
+    qreal spacing() const { return _normalisedSpacing + _addedNormalisedSpace; }
     qreal actualAddedSpace() const;
 
     qreal addSpacing(qreal step);
@@ -78,12 +104,35 @@ public:
 //    helper class for spreading staves over a page
 //---------------------------------------------------------
 
-class VerticalGapDataList : public QList<VerticalGapData*>
+class VerticalGapDataList : public LayoutVector<VerticalGapData>
 {
 public:
-    void deleteAll();
+    struct Levels {
+        qreal smallest     { 0.0 };     // smallest spacing of a stretchable gap
+        qreal nextSmallest { 0.0 };     // smallest spacing with a different qCeil() than smallest
+        qreal stretch      { 0.0 };     // sum of the factors of the stretchable gaps
+    };
+
+    Levels levels() const;
     qreal sumStretchFactor() const;
-    qreal smallest(qreal limit=-1.0) const;
+};
+
+//---------------------------------------------------------
+//   LinearWindow
+//    a run of consecutive measures of the continuous view
+//    (LayoutMode::LINE), positioned as a unit
+//---------------------------------------------------------
+
+static constexpr int LINEAR_WINDOW_MEASURES = 32;
+
+struct LinearWindow {
+    int first       { 0 };        // index of the first measure in System::measures()
+    int count       { 0 };
+    Fraction tick;                // tick of the first measure
+    qreal x         { 0.0 };      // sum of the widths in front of the window
+    qreal width     { 0.0 };
+    bool relaid     { false };    // has measures of the layout range
+    bool moved      { false };    // a measure changed its position
 };
 
 //---------------------------------------------------------
@@ -101,7 +150,7 @@ struct LayoutContext {
     Fraction tick            { 0, 1 };
 
     QList<System*> systemList;            // reusable systems
-    std::set<Spanner*> processedSpanners;
+    std::set<Spanner*, std::less<Spanner*>, ArenaAllocator<Spanner*> > processedSpanners;
 
     System* prevSystem       { 0 };       // used during page layout
     System* curSystem        { 0 };
@@ -117,6 +166,20 @@ struct LayoutContext {
     Fraction startTick;
     Fraction endTick;
 
+    std::vector<LinearWindow> linearWindows;    // continuous view only
+
+    // multi measure rest candidates, see Score::scanMMRestRun()
+    LayoutVector<Measure*> mmrRun;        // consecutive measures which may form one multi measure rest
+    size_t mmrPos            { 0 };       // index in mmrRun of the last measure looked up
+    Measure* mmrStop         { nullptr }; // measure which ended the run, if any
+    bool mmrStopValid        { false };   // validMMRestMeasure() of mmrStop
+
+    LayoutStatistics statistics;
+    LayoutStatistics::Phase phase { LayoutStatistics::Phase::OTHER };
+    std::chrono::steady_clock::time_point phaseStart;
+    std::chrono::steady_clock::time_point layoutStart;
+    uint64_t shapesAtStart   { 0 };
+
     LayoutContext(Score* s);
     LayoutContext(const LayoutContext&) = delete;
     LayoutContext& operator=(const LayoutContext&) = delete;
@@ -128,6 +191,26 @@ struct LayoutContext {
     int adjustMeasureNo(MeasureBase*);
     void getNextPage();
     void collectPage();
+    LayoutStatistics::Phase switchPhase(LayoutStatistics::Phase);
+};
+
+//---------------------------------------------------------
+//   LayoutPhaseScope
+//    charges the time spent in its scope to a phase
+//    of LayoutContext::statistics
+//---------------------------------------------------------
+
+class LayoutPhaseScope
+{
+    LayoutContext& _lc;
+    LayoutStatistics::Phase _prev;
+
+public:
+    LayoutPhaseScope(LayoutContext& lc, LayoutStatistics::Phase p)
+        : _lc(lc), _prev(lc.switchPhase(p)) {}
+    ~LayoutPhaseScope() { _lc.switchPhase(_prev); }
+    LayoutPhaseScope(const LayoutPhaseScope&) = delete;
+    LayoutPhaseScope& operator=(const LayoutPhaseScope&) = delete;
 };
 
 //---------------------------------------------------------
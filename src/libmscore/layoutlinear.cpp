@@ -31,6 +31,7 @@
 #include "barline.h"
 #include "tie.h"
 #include "chord.h"
+#include "note.h"
 #include "staff.h"
 #include "box.h"
 #include "spacer.h"
@@ -49,6 +50,8 @@
 #include "fermata.h"
 #include "lyrics.h"
 
+#include <algorithm>
+
 namespace Ms {
 //---------------------------------------------------------
 //   resetSystems
@@ -102,15 +105,22 @@ void Score::resetSystems(bool layoutAll, LayoutContext& lc)
 //---------------------------------------------------------
 //   collectLinearSystem
 //   Append all measures to System. VBox is not included to System
+//   Measures are grouped into windows of LINEAR_WINDOW_MEASURES,
+//   each placed at the sum of the widths in front of it; the
+//   windows remember whether they were relaid or moved so that
+//   LayoutContext::layoutLinear() can leave the others alone.
 //---------------------------------------------------------
 
 void Score::collectLinearSystem(LayoutContext& lc)
 {
+    LayoutPhaseScope phase(lc, LayoutStatistics::Phase::SYSTEMS);
+    ++lc.statistics.systems;
     System* system = systems().front();
     system->setInstrumentNames(/* longNames */ true);
 
     QPointF pos;
     bool firstMeasure = true;       //lc.startTick.isZero();
+    lc.linearWindows.clear();
 
     //set first measure to lc.nextMeasures for following
     //utilizing in getNextMeasure()
@@ -125,6 +135,14 @@ void Score::collectLinearSystem(LayoutContext& lc)
             getNextMeasure(lc);
             continue;
         }
+        if (lc.linearWindows.empty() || lc.linearWindows.back().count == LINEAR_WINDOW_MEASURES) {
+            LinearWindow w;
+            w.first = system->measures().size();
+            w.tick  = lc.curMeasure->tick();
+            w.x     = pos.x();
+            lc.linearWindows.push_back(w);
+        }
+        LinearWindow& window = lc.linearWindows.back();
         system->appendMeasure(lc.curMeasure);
         if (lc.curMeasure->isMeasure()) {
             Measure* m = toMeasure(lc.curMeasure);
@@ -154,10 +172,12 @@ void Score::collectLinearSystem(LayoutContext& lc)
                 m->computeMinWidth();
                 ww = m->width();
                 m->stretchMeasure(ww);
+                window.relaid = true;
             } else {
                 // for measures not in range, use existing layout
                 ww = m->width();
                 if (m->pos() != pos) {
+                    window.moved = true;
                     // fix beam positions
                     // other elements with system as parent are processed in layoutSystemElements()
                     // but full beam processing is expensive and not needed if we adjust position here
@@ -181,11 +201,17 @@ void Score::collectLinearSystem(LayoutContext& lc)
             m->setPos(pos);
             m->layoutStaffLines();
         } else if (lc.curMeasure->isHBox()) {
-            lc.curMeasure->setPos(pos + QPointF(toHBox(lc.curMeasure)->topGap(), 0.0));
+            QPointF p = pos + QPointF(toHBox(lc.curMeasure)->topGap(), 0.0);
+            if (lc.curMeasure->pos() != p) {
+                window.moved = true;
+            }
+            lc.curMeasure->setPos(p);
             lc.curMeasure->layout();
             ww = lc.curMeasure->width();
         }
         pos.rx() += ww;
+        window.width += ww;
+        ++window.count;
 
         getNextMeasure(lc);
     }
@@ -214,75 +240,177 @@ void Score::layoutLinear(bool layoutAll, LayoutContext& lc)
 
 void LayoutContext::layoutLinear()
 {
+    LayoutPhaseScope phase(*this, LayoutStatistics::Phase::PAGES);
+    ++statistics.pages;
     System* system = score->systems().front();
 
+    // vertical staff geometry of the previous layout; the width
+    // follows the system width and does not matter to bar lines,
+    // spacers and ties
+    struct StaffGeometry {
+        bool show;
+        qreal top;
+        qreal height;
+        qreal y;
+    };
+    auto geometry = [system](int staffIdx) {
+        SysStaff* ss = system->staff(staffIdx);
+        return StaffGeometry { ss->show(), ss->bbox().top(), ss->bbox().height(), ss->y() };
+    };
+    std::vector<StaffGeometry> oldStaves;
+    for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+        oldStaves.push_back(geometry(staffIdx));
+    }
+
     score->layoutSystemElements(system, *this);
 
     system->layout2();     // compute staff distances
 
-    for (MeasureBase* mb : system->measures()) {
-        if (!mb->isMeasure()) {
-            continue;
+    bool stavesMoved = false;
+    for (int staffIdx = 0; !stavesMoved && staffIdx < score->nstaves(); ++staffIdx) {
+        StaffGeometry g = geometry(staffIdx);
+        const StaffGeometry& o = oldStaves[staffIdx];
+        stavesMoved = g.show != o.show || g.top != o.top || g.height != o.height || g.y != o.y;
+    }
+
+    //---------------------------------------------------
+    //    a window keeps its previous layout if neither it nor
+    //    its neighbours were relaid or moved and the staves
+    //    are where they were
+    //    Only the measure layout below is windowed,
+    //    layoutSystemElements() above and the bsp tree still
+    //    cover the whole line.
+    //---------------------------------------------------
+
+    const int nwindows = int(linearWindows.size());
+    std::vector<char> keep(nwindows, 0);
+    if (!stavesMoved) {
+        auto changed = [this](int i) {
+            return linearWindows[i].relaid || linearWindows[i].moved;
+        };
+        for (int i = 0; i < nwindows; ++i) {
+            keep[i] = !changed(i) && !(i > 0 && changed(i - 1)) && !(i + 1 < nwindows && changed(i + 1));
         }
-        Measure* m = toMeasure(mb);
+    }
 
-        for (int track = 0; track < score->ntracks(); ++track) {
-            for (Segment* segment = m->first(); segment; segment = segment->next()) {
-                Element* e = segment->element(track);
-                if (!e) {
+    //---------------------------------------------------
+    //    System::clear() detached all spanner segments; ties
+    //    and note anchored spanners are only laid out again
+    //    from their chords, so this is done for every chord,
+    //    also in kept windows and measures out of range
+    //---------------------------------------------------
+
+    auto layoutChordSpanners = [this](Measure* m) {
+        static const SegmentType st { SegmentType::ChordRest };
+        for (Segment* segment = m->first(st); segment; segment = segment->next(st)) {
+            for (int track = 0; track < score->ntracks(); ++track) {
+                ChordRest* cr = segment->cr(track);
+                if (!cr || !cr->isChord() || !score->staff(track2staff(track))->show()) {
                     continue;
                 }
-                if (e->isChordRest()) {
-                    if (m->tick() < startTick || m->tick() > endTick) {
-                        continue;
-                    }
-                    if (!score->staff(track2staff(track))->show()) {
-                        continue;
-                    }
-                    ChordRest* cr = toChordRest(e);
-                    if (notTopBeam(cr)) {                           // layout cross staff beams
-                        cr->beam()->layout();
+                Chord* c = toChord(cr);
+                for (Chord* cc : c->graceNotes()) {
+                    cc->layoutSpanners();
+                    for (Element* element : cc->el()) {
+                        if (element->isSlur()) {
+                            element->layout();
+                        }
                     }
-                    if (notTopTuplet(cr)) {
-                        // fix layout of tuplets
-                        DurationElement* de = cr;
-                        while (de->tuplet() && de->tuplet()->elements().front() == de) {
-                            Tuplet* t = de->tuplet();
-                            t->layout();
-                            de = de->tuplet();
+                }
+                c->layoutSpanners();
+            }
+        }
+    };
+
+    const QList<MeasureBase*>& ml = system->measures();
+    for (int wi = 0; wi < nwindows; ++wi) {
+        const LinearWindow& window = linearWindows[wi];
+        if (keep[wi]) {
+            for (int mi = window.first; mi < window.first + window.count; ++mi) {
+                if (ml[mi]->isMeasure()) {
+                    layoutChordSpanners(toMeasure(ml[mi]));
+                }
+            }
+            continue;
+        }
+        for (int mi = window.first; mi < window.first + window.count; ++mi) {
+            MeasureBase* mb = ml[mi];
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            Measure* m = toMeasure(mb);
+
+            if (m->tick() < startTick || m->tick() > endTick) {
+                layoutChordSpanners(m);
+                // only bar lines need to follow the staves here
+                static const SegmentType barLineTypes = SegmentType::BarLineType;
+                for (Segment* segment = m->first(barLineTypes); segment; segment = segment->next(barLineTypes)) {
+                    for (int track = 0; track < score->ntracks(); ++track) {
+                        Element* e = segment->element(track);
+                        if (e && e->isBarLine()) {
+                            toBarLine(e)->layout2();
                         }
                     }
+                }
+                m->layout2();
+                continue;
+            }
 
-                    if (cr->isChord()) {
-                        Chord* c = toChord(cr);
-                        for (Chord* cc : c->graceNotes()) {
-                            if (cc->beam() && cc->beam()->elements().front() == cc) {
-                                cc->beam()->layout();
+            for (int track = 0; track < score->ntracks(); ++track) {
+                for (Segment* segment = m->first(); segment; segment = segment->next()) {
+                    Element* e = segment->element(track);
+                    if (!e) {
+                        continue;
+                    }
+                    if (e->isChordRest()) {
+                        if (!score->staff(track2staff(track))->show()) {
+                            continue;
+                        }
+                        ChordRest* cr = toChordRest(e);
+                        if (notTopBeam(cr)) {                           // layout cross staff beams
+                            cr->beam()->layout();
+                        }
+                        if (notTopTuplet(cr)) {
+                            // fix layout of tuplets
+                            DurationElement* de = cr;
+                            while (de->tuplet() && de->tuplet()->elements().front() == de) {
+                                Tuplet* t = de->tuplet();
+                                t->layout();
+                                de = de->tuplet();
                             }
-                            cc->layoutSpanners();
-                            for (Element* element : cc->el()) {
-                                if (element->isSlur()) {
-                                    element->layout();
+                        }
+
+                        if (cr->isChord()) {
+                            Chord* c = toChord(cr);
+                            for (Chord* cc : c->graceNotes()) {
+                                if (cc->beam() && cc->beam()->elements().front() == cc) {
+                                    cc->beam()->layout();
+                                }
+                                cc->layoutSpanners();
+                                for (Element* element : cc->el()) {
+                                    if (element->isSlur()) {
+                                        element->layout();
+                                    }
                                 }
                             }
-                        }
-                        c->layoutArpeggio2();
-                        c->layoutSpanners();
-                        if (c->tremolo()) {
-                            Tremolo* t = c->tremolo();
-                            Chord* c1 = t->chord1();
-                            Chord* c2 = t->chord2();
-                            if (t->twoNotes() && c1 && c2 && (c1->staffMove() || c2->staffMove())) {
-                                t->layout();
+                            c->layoutArpeggio2();
+                            c->layoutSpanners();
+                            if (c->tremolo()) {
+                                Tremolo* t = c->tremolo();
+                                Chord* c1 = t->chord1();
+                                Chord* c2 = t->chord2();
+                                if (t->twoNotes() && c1 && c2 && (c1->staffMove() || c2->staffMove())) {
+                                    t->layout();
+                                }
                             }
                         }
+                    } else if (e->isBarLine()) {
+                        toBarLine(e)->layout2();
                     }
-                } else if (e->isBarLine()) {
-                    toBarLine(e)->layout2();
                 }
             }
+            m->layout2();
         }
-        m->layout2();
     }
     page->setPos(0, 0);
     system->setPos(page->lm(), page->tm() + score->styleP(Sid::staffUpperBorder));
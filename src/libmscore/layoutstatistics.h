@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LAYOUTSTATISTICS_H__
+#define __LAYOUTSTATISTICS_H__
+
+#include <cstdint>
+
+namespace Ms {
+//---------------------------------------------------------
+//   LayoutStatistics
+//    what the last layout of a score did and where the
+//    time went; the phases do not overlap, time spent in
+//    a nested phase is only counted there
+//---------------------------------------------------------
+
+struct LayoutStatistics {
+    enum class Phase : char {
+        OTHER,              // setup and everything not below
+        MEASURES,           // Score::getNextMeasure()
+        SYSTEMS,            // Score::collectSystem(), collectLinearSystem()
+        SYSTEM_ELEMENTS,    // Score::layoutSystemElements()
+        PAGES,              // LayoutContext::collectPage(), LayoutContext::layoutLinear()
+        PHASES
+    };
+
+    uint64_t measures { 0 };        // measures laid out
+    uint64_t systems  { 0 };        // systems collected
+    uint64_t pages    { 0 };        // pages collected
+    uint64_t shapes   { 0 };        // segment staff shapes created
+    double phaseMs[int(Phase::PHASES)] { };
+    double totalMs    { 0.0 };
+
+    double ms(Phase p) const { return phaseMs[int(p)]; }
+};
+}     // namespace Ms
+#endif
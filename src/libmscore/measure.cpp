@@ -25,7 +25,9 @@
  Implementation of most part of class Measure.
 */
 
+#include <atomic>
 #include <cmath>
+#include <cstring>
 
 #include "log.h"
 
@@ -68,6 +70,7 @@
 #include "segment.h"
 #include "select.h"
 #include "sig.h"
+#include "skyline.h"
 #include "slur.h"
 #include "spacer.h"
 #include "staff.h"
@@ -921,6 +924,9 @@ void Measure::add(Element* e)
         }
         seg->setParent(this);
         m_segments.insert(seg, s);
+        if (seg->isChordRestType()) {
+            invalidateStaffOccupancy();
+        }
         //
         // update measure flags
         //
@@ -1033,6 +1039,9 @@ void Measure::remove(Element* e)
     {
         Segment* s = toSegment(e);
         m_segments.remove(s);
+        if (s->isChordRestType()) {
+            invalidateStaffOccupancy();
+        }
         //
         // update measure flags
         //
@@ -2108,38 +2117,50 @@ void Measure::read(XmlReader& e, int staffIdx)
     }
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
-
-        if (tag == "voice") {
+        switch (e.tag()) {
+        case XmlTag::VOICE:
             e.setTrack(nextTrack++);
             e.setTick(tick());
             readVoice(e, staffIdx, irregular);
-        } else if (tag == "Marker" || tag == "Jump") {
-            Element* el = Element::name2Element(tag, score());
+            break;
+        case XmlTag::MARKER:
+        case XmlTag::JUMP: {
+            Element* el = Element::name2Element(e.name(), score());
             el->setTrack(e.track());
             el->read(e);
             add(el);
-        } else if (tag == "stretch") {
+        }
+        break;
+        case XmlTag::STRETCH: {
             double val = e.readDouble();
             if (val < 0.0) {
                 val = 0;
             }
             setUserStretch(val);
-        } else if (tag == "noOffset") {
+        }
+        break;
+        case XmlTag::NO_OFFSET:
             setNoOffset(e.readInt());
-        } else if (tag == "measureNumberMode") {
+            break;
+        case XmlTag::MEASURE_NUMBER_MODE:
             setMeasureNumberMode(MeasureNumberMode(e.readInt()));
-        } else if (tag == "irregular") {
+            break;
+        case XmlTag::IRREGULAR:
             setIrregular(e.readBool());
-        } else if (tag == "breakMultiMeasureRest") {
+            break;
+        case XmlTag::BREAK_MULTI_MEASURE_REST:
             m_breakMultiMeasureRest = e.readBool();
-        } else if (tag == "startRepeat") {
+            break;
+        case XmlTag::START_REPEAT:
             setRepeatStart(true);
             e.readNext();
-        } else if (tag == "endRepeat") {
+            break;
+        case XmlTag::END_REPEAT:
             m_repeatCount = e.readInt();
             setRepeatEnd(true);
-        } else if (tag == "vspacer" || tag == "vspacerDown") {
+            break;
+        case XmlTag::VSPACER:
+        case XmlTag::VSPACER_DOWN:
             if (!m_mstaves[staffIdx]->vspacerDown()) {
                 Spacer* spacer = new Spacer(score());
                 spacer->setSpacerType(SpacerType::DOWN);
@@ -2147,7 +2168,8 @@ void Measure::read(XmlReader& e, int staffIdx)
                 add(spacer);
             }
             m_mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
-        } else if (tag == "vspacerFixed") {
+            break;
+        case XmlTag::VSPACER_FIXED:
             if (!m_mstaves[staffIdx]->vspacerDown()) {
                 Spacer* spacer = new Spacer(score());
                 spacer->setSpacerType(SpacerType::FIXED);
@@ -2155,7 +2177,8 @@ void Measure::read(XmlReader& e, int staffIdx)
                 add(spacer);
             }
             m_mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
-        } else if (tag == "vspacerUp") {
+            break;
+        case XmlTag::VSPACER_UP:
             if (!m_mstaves[staffIdx]->vspacerUp()) {
                 Spacer* spacer = new Spacer(score());
                 spacer->setSpacerType(SpacerType::UP);
@@ -2163,34 +2186,48 @@ void Measure::read(XmlReader& e, int staffIdx)
                 add(spacer);
             }
             m_mstaves[staffIdx]->vspacerUp()->setGap(e.readDouble() * _spatium);
-        } else if (tag == "visible") {
+            break;
+        case XmlTag::VISIBLE:
             m_mstaves[staffIdx]->setVisible(e.readInt());
-        } else if ((tag == "slashStyle") || (tag == "stemless")) {
+            break;
+        case XmlTag::SLASH_STYLE:
+        case XmlTag::STEMLESS:
             m_mstaves[staffIdx]->setStemless(e.readInt());
-        } else if (tag == "measureRepeatCount") {
+            break;
+        case XmlTag::MEASURE_REPEAT_COUNT:
             setMeasureRepeatCount(e.readInt(), staffIdx);
-        } else if (tag == "SystemDivider") {
+            break;
+        case XmlTag::SYSTEM_DIVIDER: {
             SystemDivider* sd = new SystemDivider(score());
             sd->read(e);
             add(sd);
-        } else if (tag == "multiMeasureRest") {
+        }
+        break;
+        case XmlTag::MULTI_MEASURE_REST:
             m_mmRestCount = e.readInt();
             // set tick to previous measure
             setTick(e.lastMeasure()->tick());
             e.setTick(e.lastMeasure()->tick());
-        } else if (tag == "MeasureNumber") {
+            break;
+        case XmlTag::MEASURE_NUMBER: {
             MeasureNumber* noText = new MeasureNumber(score());
             noText->read(e);
             noText->setTrack(e.track());
             add(noText);
-        } else if (tag == "MMRestRange") {
+        }
+        break;
+        case XmlTag::MMREST_RANGE: {
             MMRestRange* range = new MMRestRange(score());
             range->read(e);
             range->setTrack(e.track());
             add(range);
-        } else if (MeasureBase::readProperties(e)) {
-        } else {
-            e.unknown();
+        }
+        break;
+        default:
+            if (!MeasureBase::readProperties(e)) {
+                e.unknown();
+            }
+            break;
         }
     }
     e.checkConnectors();
@@ -2219,16 +2256,18 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
     Fraction timeStretch(staff->timeStretch(tick()));
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
-
-        if (tag == "location") {
+        switch (e.tag()) {
+        case XmlTag::LOCATION: {
             Location loc = Location::relative();
             loc.read(e);
             e.setLocation(loc);
-        } else if (tag == "tick") {             // obsolete?
+        }
+        break;
+        case XmlTag::TICK:                  // obsolete?
             qDebug("read midi tick");
             e.setTick(Fraction::fromTicks(score()->fileDivision(e.readInt())));
-        } else if (tag == "BarLine") {
+            break;
+        case XmlTag::BAR_LINE: {
             BarLine* barLine = new BarLine(score());
             barLine->setTrack(e.track());
             barLine->read(e);
@@ -2262,7 +2301,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 segment->add(fermata);
                 fermata = nullptr;
             }
-        } else if (tag == "Chord") {
+        }
+        break;
+        case XmlTag::CHORD: {
             Chord* chord = new Chord(score());
             chord->setTrack(e.track());
             chord->read(e);
@@ -2292,7 +2333,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 segment->add(fermata);
                 fermata = nullptr;
             }
-        } else if (tag == "Rest") {
+        }
+        break;
+        case XmlTag::REST:
             if (isMMRest()) {
                 MMRest* mmr = new MMRest(score());
                 mmr->setTrack(e.track());
@@ -2326,16 +2369,21 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 }
                 e.incTick(rest->actualTicks());
             }
-        } else if (tag == "Breath") {
+            break;
+        case XmlTag::BREATH: {
             Breath* breath = new Breath(score());
             breath->setTrack(e.track());
             breath->setPlacement(breath->track() & 1 ? Placement::BELOW : Placement::ABOVE);
             breath->read(e);
             segment = getSegment(SegmentType::Breath, e.tick());
             segment->add(breath);
-        } else if (tag == "Spanner") {
+        }
+        break;
+        case XmlTag::SPANNER:
             Spanner::readSpanner(e, this, e.track());
-        } else if (tag == "MeasureRepeat" || tag == "RepeatMeasure") {
+            break;
+        case XmlTag::MEASURE_REPEAT:
+        case XmlTag::REPEAT_MEASURE: {
             //             4.x                       3.x
             MeasureRepeat* mr = new MeasureRepeat(score());
             mr->setTrack(e.track());
@@ -2349,7 +2397,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(mr);
             e.incTick(ticks());
-        } else if (tag == "Clef") {
+        }
+        break;
+        case XmlTag::CLEF: {
             Clef* clef = new Clef(score());
             clef->setTrack(e.track());
             clef->read(e);
@@ -2376,7 +2426,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             }
             segment = getSegment(header ? SegmentType::HeaderClef : SegmentType::Clef, e.tick());
             segment->add(clef);
-        } else if (tag == "TimeSig") {
+        }
+        break;
+        case XmlTag::TIME_SIG: {
             TimeSig* ts = new TimeSig(score());
             ts->setTrack(e.track());
             ts->read(e);
@@ -2403,7 +2455,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                     score()->sigmap()->add(tick().ticks(), SigEvent(m_timesig));
                 }
             }
-        } else if (tag == "KeySig") {
+        }
+        break;
+        case XmlTag::KEY_SIG: {
             KeySig* ks = new KeySig(score());
             ks->setTrack(e.track());
             ks->read(e);
@@ -2420,7 +2474,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                     staff->setKey(curTick, ks->keySigEvent());
                 }
             }
-        } else if (tag == "Text") {
+        }
+        break;
+        case XmlTag::TEXT: {
             StaffText* t = new StaffText(score());
             t->setTrack(e.track());
             t->read(e);
@@ -2432,52 +2488,54 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 segment->add(t);
             }
         }
-        //----------------------------------------------------
-        // Annotation
-        else if (tag == "Dynamic") {
+        break;
+        case XmlTag::DYNAMIC: {
             Dynamic* dyn = new Dynamic(score());
             dyn->setTrack(e.track());
             dyn->read(e);
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(dyn);
-        } else if (tag == "Harmony"
-                   || tag == "FretDiagram"
-                   || tag == "TremoloBar"
-                   || tag == "Symbol"
-                   || tag == "Tempo"
-                   || tag == "StaffText"
-                   || tag == "Sticking"
-                   || tag == "SystemText"
-                   || tag == "RehearsalMark"
-                   || tag == "InstrumentChange"
-                   || tag == "StaffState"
-                   || tag == "FiguredBass"
-                   ) {
-            Element* el = Element::name2Element(tag, score());
+        }
+        break;
+        case XmlTag::HARMONY:
+        case XmlTag::FRET_DIAGRAM:
+        case XmlTag::TREMOLO_BAR:
+        case XmlTag::SYMBOL:
+        case XmlTag::TEMPO:
+        case XmlTag::STAFF_TEXT:
+        case XmlTag::STICKING:
+        case XmlTag::SYSTEM_TEXT:
+        case XmlTag::REHEARSAL_MARK:
+        case XmlTag::INSTRUMENT_CHANGE:
+        case XmlTag::STAFF_STATE:
+        case XmlTag::FIGURED_BASS: {
+            Element* el = Element::name2Element(e.name(), score());
             // hack - needed because tick tags are unreliable in 1.3 scores
             // for symbols attached to anything but a measure
             el->setTrack(e.track());
             el->read(e);
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(el);
-        } else if (tag == "Fermata") {
+        }
+        break;
+        case XmlTag::FERMATA:
             fermata = new Fermata(score());
             fermata->setTrack(e.track());
             fermata->setPlacement(fermata->track() & 1 ? Placement::BELOW : Placement::ABOVE);
             fermata->read(e);
-        } else if (tag == "Image") {
+            break;
+        case XmlTag::IMAGE:
             if (MScore::noImages) {
                 e.skipCurrentElement();
             } else {
-                Element* el = Element::name2Element(tag, score());
+                Element* el = Element::name2Element(e.name(), score());
                 el->setTrack(e.track());
                 el->read(e);
                 segment = getSegment(SegmentType::ChordRest, e.tick());
                 segment->add(el);
             }
-        }
-        //----------------------------------------------------
-        else if (tag == "Tuplet") {
+            break;
+        case XmlTag::TUPLET: {
             Tuplet* oldTuplet = tuplet;
             tuplet = new Tuplet(score());
             tuplet->setTrack(e.track());
@@ -2487,7 +2545,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             if (oldTuplet) {
                 oldTuplet->add(tuplet);
             }
-        } else if (tag == "endTuplet") {
+        }
+        break;
+        case XmlTag::END_TUPLET: {
             if (!tuplet) {
                 qDebug("Measure::read: encountered <endTuplet/> when no tuplet was started");
                 e.skipCurrentElement();
@@ -2504,7 +2564,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 delete oldTuplet;
             }
             e.readNext();
-        } else if (tag == "Beam") {
+        }
+        break;
+        case XmlTag::BEAM: {
             Beam* beam = new Beam(score());
             beam->setTrack(e.track());
             beam->read(e);
@@ -2514,17 +2576,27 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 delete startingBeam;
             }
             startingBeam = beam;
-        } else if (tag == "Segment" && segment) {
-            segment->read(e);
-        } else if (tag == "Ambitus") {
+        }
+        break;
+        case XmlTag::SEGMENT:
+            if (segment) {
+                segment->read(e);
+            } else {
+                e.unknown();
+            }
+            break;
+        case XmlTag::AMBITUS: {
             Ambitus* range = new Ambitus(score());
             range->read(e);
             segment = getSegment(SegmentType::Ambitus, e.tick());
             range->setParent(segment);                // a parent segment is needed for setTrack() to work
             range->setTrack(trackZeroVoice(e.track()));
             segment->add(range);
-        } else {
+        }
+        break;
+        default:
             e.unknown();
+            break;
         }
     }
     if (startingBeam) {
@@ -2900,44 +2972,105 @@ bool Measure::hasVoice(int track) const
     return false;
 }
 
-//-------------------------------------------------------------------
-//   isEmpty
-///   Check if the measure is filled by a full-measure rest, or is
-///   full of rests on this staff, that may have fermatas on them.
-///   If staff is -1, then check for all staves.
-//-------------------------------------------------------------------
+//---------------------------------------------------------
+//   StaffOccupancy
+//---------------------------------------------------------
 
-bool Measure::isEmpty(int staffIdx) const
+void StaffOccupancy::reset(int nstaves)
 {
-    int strack;
-    int etrack;
-    bool hasStaves = score()->staff(staffIdx)->part()->staves()->size() > 1;
-    if (staffIdx < 0) {
-        strack = 0;
-        etrack = score()->nstaves() * VOICES;
-    } else {
-        strack = staffIdx * VOICES;
-        etrack = strack + VOICES;
+    size_t words = (size_t(nstaves) + 63) / 64;
+    m_occupied.assign(words, 0);
+    m_movedInto.assign(words, 0);
+    m_nstaves = nstaves;
+}
+
+void StaffOccupancy::unite(const StaffOccupancy& o)
+{
+    if (o.m_nstaves > m_nstaves) {
+        m_occupied.resize(o.m_occupied.size(), 0);
+        m_movedInto.resize(o.m_movedInto.size(), 0);
+        m_nstaves = o.m_nstaves;
+    }
+    for (size_t i = 0; i < o.m_occupied.size(); ++i) {
+        m_occupied[i] |= o.m_occupied[i];
+        m_movedInto[i] |= o.m_movedInto[i];
+    }
+}
+
+bool StaffOccupancy::anyOccupied() const
+{
+    for (uint64_t word : m_occupied) {
+        if (word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   occupancyGeneration
+//    bumped by invalidateAllStaffOccupancy() when a full layout
+//    must not trust any bits; edits invalidate single measures
+//    through the segment hooks and the undo commands changing
+//    visibility, staff moves, system flag and track
+//---------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> occupancyGeneration { 1 };
+}
+
+void Measure::invalidateAllStaffOccupancy()
+{
+    occupancyGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+//   staffOccupancy
+///   Return the per staff occupancy of this measure, rescanning
+///   the chord rest segments once for all staves if the measure
+///   has changed since the last call.
+///   Main thread only, the lazy rebuild is not synchronized.
+//---------------------------------------------------------
+
+const StaffOccupancy& Measure::staffOccupancy() const
+{
+    const uint64_t generation = occupancyGeneration.load(std::memory_order_relaxed);
+    const int nstaves = score()->nstaves();
+    if (m_occupancyGeneration == generation && m_occupancy.nstaves() == nstaves) {
+        return m_occupancy;
+    }
+
+    m_occupancy.reset(nstaves);
+    std::vector<Part*> parts(nstaves);
+    std::vector<char> hasStaves(nstaves);
+    for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+        Part* part = score()->staff(staffIdx)->part();
+        parts[staffIdx] = part;
+        hasStaves[staffIdx] = part->staves()->size() > 1;
     }
+
+    const int ntracks = nstaves * VOICES;
     for (Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-        for (int track = strack; track < etrack; ++track) {
+        for (int track = 0; track < ntracks; ++track) {
             Element* e = s->element(track);
-            if (e && !e->isRest()) {
-                return false;
+            if (!e || e->isRest()) {
+                continue;
             }
-            // Check for cross-staff chords
-            if (hasStaves) {
-                if (strack >= VOICES) {
-                    e = s->element(track - VOICES);
-                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
-                        return false;
-                    }
-                }
-                if (etrack < score()->nstaves() * VOICES) {
-                    e = s->element(track + VOICES);
-                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
-                        return false;
-                    }
+            int staffIdx = track / VOICES;
+            m_occupancy.setOccupied(staffIdx);
+
+            // cross-staff notes coming from an adjacent staff
+            int vStaffIdx = e->vStaffIdx();
+            if ((vStaffIdx == staffIdx + 1 || vStaffIdx == staffIdx - 1)
+                && vStaffIdx >= 0 && vStaffIdx < nstaves && hasStaves[vStaffIdx]) {
+                m_occupancy.setOccupied(vStaffIdx);
+            }
+            // cross-staff notes moved anywhere inside the part
+            if (e->isChordRest()) {
+                int staffMove = toChordRest(e)->staffMove();
+                int target = staffIdx + staffMove;
+                if (staffMove && target >= 0 && target < nstaves && parts[target] == parts[staffIdx]) {
+                    m_occupancy.setMovedInto(target);
                 }
             }
         }
@@ -2946,12 +3079,29 @@ bool Measure::isEmpty(int staffIdx) const
                 continue;
             }
             int atrack = a->track();
-            if (atrack >= strack && atrack < etrack) {
-                return false;
+            if (atrack >= 0 && atrack < ntracks) {
+                m_occupancy.setOccupied(atrack / VOICES);
             }
         }
     }
-    return true;
+    m_occupancyGeneration = generation;
+    return m_occupancy;
+}
+
+//-------------------------------------------------------------------
+//   isEmpty
+///   Check if the measure is filled by a full-measure rest, or is
+///   full of rests on this staff, that may have fermatas on them.
+///   If staff is -1, then check for all staves.
+//-------------------------------------------------------------------
+
+bool Measure::isEmpty(int staffIdx) const
+{
+    const StaffOccupancy& occupancy = staffOccupancy();
+    if (staffIdx < 0) {
+        return !occupancy.anyOccupied();
+    }
+    return !occupancy.occupied(staffIdx);
 }
 
 //---------------------------------------------------------
@@ -3681,7 +3831,7 @@ void Measure::stretchMeasure(qreal targetWidth)
     //    compute stretch
     //---------------------------------------------------
 
-    std::multimap<qreal, Segment*> springs;
+    std::multimap<qreal, Segment*, std::less<qreal>, ArenaAllocator<std::pair<const qreal, Segment*> > > springs;
 
     Segment* seg = first();
     while (seg && !seg->enabled()) {
@@ -4676,6 +4826,22 @@ void Measure::computeMinWidth(Segment* s, qreal x, bool isSystemHeader)
         }
     }
 
+    // right edges of the segments checked by the look back loop below,
+    // so the loop only has to run if a collision is possible at all
+    const int nstaves = score()->nstaves();
+    MinWidthScratch& scratch = masterScore()->minWidthScratch();
+    std::vector<HorizontalSkyline>& envelope = scratch.envelope;
+    if (int(envelope.size()) < nstaves) {
+        envelope.resize(nstaves, HorizontalSkyline(spatium() * .5));
+    }
+    for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+        envelope[staffIdx].reset(spatium() * .5);
+    }
+    std::vector<Segment*>& added = scratch.added;
+    Segment* envelopeLast = nullptr;          // last segment added to envelope
+    qreal envelopeMaxX    = -1000000.0;
+    bool envelopeHasFirst = false;
+
     while (s) {
         s->rxpos() = x;
         // skip disabled / invisible segments
@@ -4719,8 +4885,40 @@ void Measure::computeMinWidth(Segment* s, qreal x, bool isSystemHeader)
                 w = std::max(w, ns->minLeft(ls) - s->x());
             }
 
+            bool mayCollide = false;
+            if (s != fs) {
+                // add the segments which are new to the look back
+                added.clear();
+                for (Segment* ps = s->prevActive(); ps && ps != envelopeLast; ps = ps->prevActive()) {
+                    added.push_back(ps);
+                    if (ps == fs) {
+                        break;
+                    }
+                }
+                for (Segment* ps : added) {
+                    for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+                        envelope[staffIdx].add(ps->staffShape(staffIdx), ps->x());
+                    }
+                    envelopeMaxX     = std::max(envelopeMaxX, ps->x());
+                    envelopeHasFirst = envelopeHasFirst || ps == fs;
+                }
+                if (!added.empty()) {
+                    envelopeLast = added.front();
+                }
+                // upper bound of ww in the loop below
+                qreal ww = envelopeMaxX;
+                for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+                    ww = std::max(ww, envelope[staffIdx].minDistance(ns->staffShape(staffIdx)));
+                }
+                ww -= s->x();
+                if (envelopeHasFirst) {
+                    ww = std::max(ww, ns->minLeft(ls) - s->x());
+                }
+                mayCollide = ww >= w - 1e-6;
+            }
+
             int n = 1;
-            for (Segment* ps = s; ps != fs;) {
+            for (Segment* ps = s; mayCollide && ps != fs;) {
                 qreal ww;
                 ps = ps->prevActive();
 
@@ -4759,6 +4957,13 @@ void Measure::computeMinWidth(Segment* s, qreal x, bool isSystemHeader)
                     }
                     w += d;
                     x = xx;
+                    // segments have moved
+                    for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+                        envelope[staffIdx].clear();
+                    }
+                    envelopeLast     = nullptr;
+                    envelopeMaxX     = -1000000.0;
+                    envelopeHasFirst = false;
                     break;
                 }
             }
@@ -4773,6 +4978,113 @@ void Measure::computeMinWidth(Segment* s, qreal x, bool isSystemHeader)
     setStretchedWidth(x);
 }
 
+//---------------------------------------------------------
+//   minWidth statistics
+//---------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> minWidthHits { 0 };
+std::atomic<uint64_t> minWidthMisses { 0 };
+
+inline uint64_t keyBits(qreal v)
+{
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(v), "qreal is not a double");
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+}
+
+MinWidthStatistics Measure::minWidthStatistics()
+{
+    MinWidthStatistics st;
+    st.hits   = minWidthHits.load(std::memory_order_relaxed);
+    st.misses = minWidthMisses.load(std::memory_order_relaxed);
+    return st;
+}
+
+void Measure::clearMinWidthStatistics()
+{
+    minWidthHits.store(0, std::memory_order_relaxed);
+    minWidthMisses.store(0, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+//   minWidthKey
+//    collect everything computeMinWidth() depends on: the
+//    system position of the measure, the style and for every
+//    segment its state and shapes
+//---------------------------------------------------------
+
+void Measure::minWidthKey(std::vector<uint64_t>& key) const
+{
+    key.clear();
+    key.push_back(score()->style().epoch());
+    key.push_back(keyBits(spatium()));
+    key.push_back(keyBits(mag()));
+    key.push_back(keyBits(score()->noteHeadWidth()));
+    key.push_back(uint64_t(isFirstInSystem()) | uint64_t(header()) << 1);
+
+    // start repeat overlapping the end repeat of the previous measure
+    Segment* fs = first();
+    while (fs && !fs->enabled()) {
+        fs = fs->next();
+    }
+    bool overlap = false;
+    if (fs && fs->isStartRepeatBarLineType()) {
+        MeasureBase* pmb = prev();
+        overlap = pmb && pmb->isMeasure() && pmb->system() == system() && pmb->repeatEnd()
+                  && toMeasure(pmb)->last()->isEndBarLineType();
+    }
+    key.push_back(uint64_t(overlap) | uint64_t(fs && fs->isChordRestType() && hasAccidental(fs)) << 1);
+
+    const int tracks = score()->ntracks();
+    for (const Segment* seg = first(); seg; seg = seg->next()) {
+        bool gap = false;
+        if (seg->isChordRestType()) {
+            for (int track = 0; track < tracks; ++track) {
+                const Element* e = seg->element(track);
+                if (!e) {
+                    continue;
+                }
+                gap = e->isRest() && toRest(e)->isGap();
+                if (!gap) {
+                    break;
+                }
+            }
+        }
+        key.push_back(reinterpret_cast<uintptr_t>(seg));
+        key.push_back(uint64_t(seg->segmentType())
+                      | uint64_t(seg->enabled()) << 32
+                      | uint64_t(seg->visible()) << 33
+                      | uint64_t(seg->header()) << 34
+                      | uint64_t(seg->allElementsInvisible()) << 35
+                      | uint64_t(gap) << 36);
+        key.push_back(uint64_t(seg->rtick().numerator()) << 32 | uint32_t(seg->rtick().denominator()));
+        key.push_back(keyBits(seg->extraLeadingSpace().val()));
+        const Element* bl = seg->isStartRepeatBarLineType() ? seg->element(0) : nullptr;
+        key.push_back(keyBits(bl ? bl->width() : 0.0));
+        for (const Shape& shape : seg->shapes()) {
+            key.push_back(shape.size());
+            for (const QRectF& r : shape) {
+                key.push_back(keyBits(r.x()));
+                key.push_back(keyBits(r.y()));
+                key.push_back(keyBits(r.width()));
+                key.push_back(keyBits(r.height()));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   computeMinWidth
+//    The result only depends on what minWidthKey() collects,
+//    so the segment positions are restored from an earlier
+//    call with the same key, e.g. when a measure is tried at
+//    the end of one system and then laid out there again or
+//    when a relayout reaches measures outside the edit.
+//---------------------------------------------------------
+
 void Measure::computeMinWidth()
 {
     Segment* s;
@@ -4791,6 +5103,26 @@ void Measure::computeMinWidth()
         setWidth(0.0);
         return;
     }
+    // a multimeasure rest resets its rests while spacing
+    std::vector<uint64_t> key;
+    if (!isMMRest()) {
+        minWidthKey(key);
+        for (const MinWidthEntry& entry : m_minWidthCache) {
+            if (entry.key != key) {
+                continue;
+            }
+            auto i = entry.segments.begin();
+            for (Segment* seg = first(); seg; seg = seg->next(), ++i) {
+                seg->rxpos() = i->first;
+                seg->setWidth(i->second);
+            }
+            setStretchedWidth(last()->rxpos() + last()->width());
+            minWidthHits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        minWidthMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
     qreal x;
     bool first = isFirstInSystem();
 
@@ -4826,5 +5158,17 @@ void Measure::computeMinWidth()
     bool isSystemHeader = s->header();
 
     computeMinWidth(s, x, isSystemHeader);
+
+    if (!key.empty()) {
+        if (int(m_minWidthCache.size()) == MaxMinWidthEntries) {
+            m_minWidthCache.erase(m_minWidthCache.begin());
+        }
+        MinWidthEntry entry;
+        entry.key = std::move(key);
+        for (Segment* seg = this->first(); seg; seg = seg->next()) {
+            entry.segments.push_back({ seg->rxpos(), seg->width() });
+        }
+        m_minWidthCache.push_back(std::move(entry));
+    }
 }
 }
@@ -28,6 +28,9 @@
  Definition of class Measure.
 */
 
+#include <cstdint>
+#include <vector>
+
 #include "measurebase.h"
 #include "fraction.h"
 #include "segmentlist.h"
@@ -124,6 +127,55 @@ private:
     int m_measureRepeatCount { 0 };
 };
 
+//---------------------------------------------------------
+//   MinWidthStatistics
+//---------------------------------------------------------
+
+struct MinWidthStatistics {
+    uint64_t hits   { 0 };
+    uint64_t misses { 0 };
+};
+
+//---------------------------------------------------------
+//   StaffOccupancy
+///   Per staff bits telling what a measure (or a range of
+///   measures united together) contains.
+///   "occupied" is what makes Measure::isEmpty() false: notes,
+///   visible annotations and notes moved in from an adjacent
+///   staff of the same part. "movedInto" marks staves which
+///   receive cross-staff notes from any staff of their part.
+//---------------------------------------------------------
+
+class StaffOccupancy
+{
+public:
+    void reset(int nstaves);
+    void unite(const StaffOccupancy&);
+
+    int nstaves() const { return m_nstaves; }
+    bool occupied(int staffIdx) const { return test(m_occupied, staffIdx); }
+    bool anyOccupied() const;
+    bool movedInto(int staffIdx) const { return test(m_movedInto, staffIdx); }
+
+    void setOccupied(int staffIdx) { set(m_occupied, staffIdx); }
+    void setMovedInto(int staffIdx) { set(m_movedInto, staffIdx); }
+
+private:
+    static bool test(const std::vector<uint64_t>& bits, int idx)
+    {
+        return idx >= 0 && size_t(idx >> 6) < bits.size() && (bits[idx >> 6] >> (idx & 63)) & 1;
+    }
+
+    static void set(std::vector<uint64_t>& bits, int idx)
+    {
+        bits[idx >> 6] |= uint64_t(1) << (idx & 63);
+    }
+
+    std::vector<uint64_t> m_occupied;
+    std::vector<uint64_t> m_movedInto;
+    int m_nstaves { 0 };
+};
+
 //---------------------------------------------------------
 //   @@ Measure
 ///    one measure in a system
@@ -273,6 +325,9 @@ public:
     void checkMultiVoices(int staffIdx);
     bool hasVoice(int track) const;
     bool isEmpty(int staffIdx) const;
+    const StaffOccupancy& staffOccupancy() const;
+    void invalidateStaffOccupancy() { m_occupancyGeneration = 0; }
+    static void invalidateAllStaffOccupancy();
     bool isCutawayClef(int staffIdx) const;
     bool isFullMeasureRest() const;
     bool visible(int staffIdx) const;
@@ -335,6 +390,9 @@ public:
     qreal basicWidth() const;
     int layoutWeight(int maxMMRestLength = 0) const;
     void computeMinWidth() override;
+    static MinWidthStatistics minWidthStatistics();
+    static void clearMinWidthStatistics();
+    static constexpr int MaxMinWidthEntries = 4;     // configurations remembered per measure
     void checkHeader();
     void checkTrailer();
     void setStretchedWidth(qreal);
@@ -346,6 +404,7 @@ private:
 
     void fillGap(const Fraction& pos, const Fraction& len, int track, const Fraction& stretch, bool useGapRests = true);
     void computeMinWidth(Segment* s, qreal x, bool isSystemHeader);
+    void minWidthKey(std::vector<uint64_t>& key) const;
 
     void readVoice(XmlReader& e, int staffIdx, bool irregular);
 
@@ -370,6 +429,18 @@ private:
 
     MeasureNumberMode m_noMode;
     bool m_breakMultiMeasureRest;
+
+    // lazily rebuilt by staffOccupancy(); 0 means invalid
+    // not synchronized: only used by layout and edits on the main thread
+    mutable StaffOccupancy m_occupancy;
+    mutable uint64_t m_occupancyGeneration { 0 };
+
+    // results of computeMinWidth() for the last few system configurations
+    struct MinWidthEntry {
+        std::vector<uint64_t> key;                      // everything the spacing depends on
+        std::vector<std::pair<qreal, qreal> > segments; // x and width of every segment
+    };
+    std::vector<MinWidthEntry> m_minWidthCache;
 };
 }     // namespace Ms
 #endif
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mscsnapshot.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFileDevice>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "thirdparty/qzip/qzipwriter_p.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace Ms {
+//---------------------------------------------------------
+//   write
+//    f is already opened
+//---------------------------------------------------------
+
+bool MscSnapshot::write(QIODevice* f) const
+{
+    if (!isCompressed()) {
+        return f->write(score) == score.size();
+    }
+
+    MQZipWriter uz(f);
+
+    //uz.addDirectory("META-INF");
+    uz.addFile("META-INF/container.xml", container);
+    uz.addFile(rootFile, score);
+
+    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
+    if (fd) { // if is file (may be buffer)
+        fd->flush();     // flush to preserve score data in case of
+    }
+    // any failures on the further operations.
+
+    // save images
+    //uz.addDirectory("Pictures");
+    for (const auto& image : images) {
+        uz.addFile(image.first, image.second);
+    }
+
+    // encode thumbnail
+    if (!thumbnail.isNull()) {
+        QByteArray ba;
+        QBuffer b(&ba);
+        if (!b.open(QIODevice::WriteOnly)) {
+            qDebug("open buffer failed");
+        }
+        if (!thumbnail.save(&b, "PNG")) {
+            qDebug("save failed");
+        }
+        uz.addFile("Thumbnails/thumbnail.png", ba);
+    }
+
+    //
+    // save audio
+    //
+    if (!audio.isEmpty()) {
+        uz.addFile("audio.ogg", audio);
+    }
+
+    uz.close();
+    return uz.status() == MQZipWriter::NoError;
+}
+
+//---------------------------------------------------------
+//   writeSynced
+//    write into fileName through a QSaveFile: the data goes
+//    to a temporary file which is synced to disk and then
+//    atomically renamed to fileName
+//---------------------------------------------------------
+
+bool MscSnapshot::writeSynced(const QString& fileName, QString* error) const
+{
+    QSaveFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly)) {
+        *error = QObject::tr("Open Temp File\n%1\nfailed: %2").arg(fileName, f.errorString());
+        return false;
+    }
+    if (!write(&f) || f.error() != QFile::NoError) {
+        *error = QObject::tr("Save File failed: %1").arg(f.errorString());
+        f.cancelWriting();
+        return false;
+    }
+    if (!f.commit()) {
+        *error = QObject::tr("Save File failed: %1").arg(f.errorString());
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   saveFile
+//    Replace the file at path. If backupDir is not empty,
+//    a copy of the old file is kept there as backup (.name,).
+//    The old file is copied, not moved, and the new content
+//    is written through writeSynced(), so the file at path
+//    is either the old or the complete new content at any
+//    time. This can also be used for crash safe autosave
+//    files.
+//    Can be called from any thread.
+//---------------------------------------------------------
+
+bool MscSnapshot::saveFile(const QString& path, const QString& backupDir, QString* error) const
+{
+    QFileInfo info(path);
+    const QString name(info.filePath());
+
+    if (!backupDir.isEmpty()) {
+        const QString basename(info.fileName());
+        QDir dir(info.path());
+        //
+        // step 1
+        // remove old backup file if exists
+        // remove the backup file in the same dir as score (the traditional place) if exists
+        //
+        QDir backup(backupDir);
+        if (!backup.exists()) {
+            dir.mkpath(backupDir);
+#ifdef Q_OS_WIN
+            const QString backupDirNativePath = QDir::toNativeSeparators(backupDir);
+            SetFileAttributesW(reinterpret_cast<LPCWSTR>(backupDirNativePath.utf16()), FILE_ATTRIBUTE_HIDDEN);
+#endif
+        }
+        const QString backupName = QString(".") + info.fileName() + QString(",");
+        if (backup.exists(backupName)) {
+            backup.remove(backupName);
+        }
+        // backup files prior to 3.5 were saved in the same directory as the file itself.
+        // remove these old backup files if needed
+        if (dir != backup && dir.exists(backupName)) {
+            dir.remove(backupName);
+        }
+
+        //
+        // step 2
+        // copy old file into backup, the old file stays in place
+        // until the new content replaces it
+        //
+        if (dir.exists(basename) && !QFile::copy(name, backup.filePath(backupName))) {
+            qDebug("cannot create backup <%s>", qPrintable(backup.filePath(backupName)));
+        }
+    }
+
+    //
+    // step 3
+    // write into a temporary file and rename it to the file
+    // name, this prevents partially overwriting the original
+    // file in case of "disc full"
+    //
+    if (!writeSynced(name, error)) {
+        return false;
+    }
+    // make file readable by all
+    QFile::setPermissions(name, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser
+                          | QFile::ReadGroup | QFile::ReadOther);
+    return true;
+}
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MSCSNAPSHOT_H__
+#define __MSCSNAPSHOT_H__
+
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+class QIODevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   MscSnapshot
+//    the content of a score file, serialized on the main
+//    thread by Score::createSnapshot()
+//    Writing a snapshot (compression, thumbnail encoding,
+//    disk i/o) does not access the score and can be done
+//    on a worker thread while the score is edited.
+//---------------------------------------------------------
+
+class MscSnapshot
+{
+public:
+    QString rootFile;                             // name of the .mscx in the archive, empty: plain .mscx
+    QByteArray container;                         // META-INF/container.xml
+    QByteArray score;                             // the .mscx
+    QList<QPair<QString, QByteArray> > images;    // archive path, data
+    QImage thumbnail;
+    QByteArray audio;
+
+    bool isCompressed() const { return !rootFile.isEmpty(); }
+    bool write(QIODevice*) const;
+    bool saveFile(const QString& path, const QString& backupDir, QString* error) const;
+
+private:
+    bool writeSynced(const QString& fileName, QString* error) const;
+};
+}     // namespace Ms
+#endif
@@ -1565,67 +1565,93 @@ void Note::read(XmlReader& e)
 
 bool Note::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
-
-    if (tag == "pitch") {
+    switch (e.tag()) {
+    case XmlTag::PITCH:
         _pitch = e.readInt();
-    } else if (tag == "tpc") {
+        break;
+    case XmlTag::TPC:
         _tpc[0] = e.readInt();
         _tpc[1] = _tpc[0];
-    } else if (tag == "track") {          // for performance
+        break;
+    case XmlTag::TRACK:                   // for performance
         setTrack(e.readInt());
-    } else if (tag == "Accidental") {
+        break;
+    case XmlTag::ACCIDENTAL: {
         Accidental* a = new Accidental(score());
         a->setTrack(track());
         a->read(e);
         add(a);
-    } else if (tag == "Spanner") {
+    }
+    break;
+    case XmlTag::SPANNER:
         Spanner::readSpanner(e, this, track());
-    } else if (tag == "tpc2") {
+        break;
+    case XmlTag::TPC2:
         _tpc[1] = e.readInt();
-    } else if (tag == "small") {
+        break;
+    case XmlTag::SMALL:
         setSmall(e.readInt());
-    } else if (tag == "mirror") {
+        break;
+    case XmlTag::MIRROR:
         readProperty(e, Pid::MIRROR_HEAD);
-    } else if (tag == "dotPosition") {
+        break;
+    case XmlTag::DOT_POSITION:
         readProperty(e, Pid::DOT_POSITION);
-    } else if (tag == "fixed") {
+        break;
+    case XmlTag::FIXED:
         setFixed(e.readBool());
-    } else if (tag == "fixedLine") {
+        break;
+    case XmlTag::FIXED_LINE:
         setFixedLine(e.readInt());
-    } else if (tag == "headScheme") {
+        break;
+    case XmlTag::HEAD_SCHEME:
         readProperty(e, Pid::HEAD_SCHEME);
-    } else if (tag == "head") {
+        break;
+    case XmlTag::HEAD:
         readProperty(e, Pid::HEAD_GROUP);
-    } else if (tag == "velocity") {
+        break;
+    case XmlTag::VELOCITY:
         setVeloOffset(e.readInt());
-    } else if (tag == "play") {
+        break;
+    case XmlTag::PLAY:
         setPlay(e.readInt());
-    } else if (tag == "tuning") {
+        break;
+    case XmlTag::TUNING:
         setTuning(e.readDouble());
-    } else if (tag == "fret") {
+        break;
+    case XmlTag::FRET:
         setFret(e.readInt());
-    } else if (tag == "string") {
+        break;
+    case XmlTag::STRING:
         setString(e.readInt());
-    } else if (tag == "ghost") {
+        break;
+    case XmlTag::GHOST:
         setGhost(e.readInt());
-    } else if (tag == "headType") {
+        break;
+    case XmlTag::HEAD_TYPE:
         readProperty(e, Pid::HEAD_TYPE);
-    } else if (tag == "veloType") {
+        break;
+    case XmlTag::VELO_TYPE:
         readProperty(e, Pid::VELO_TYPE);
-    } else if (tag == "line") {
+        break;
+    case XmlTag::LINE:
         setLine(e.readInt());
-    } else if (tag == "Fingering") {
+        break;
+    case XmlTag::FINGERING: {
         Fingering* f = new Fingering(score());
         f->setTrack(track());
         f->read(e);
         add(f);
-    } else if (tag == "Symbol") {
+    }
+    break;
+    case XmlTag::SYMBOL: {
         Symbol* s = new Symbol(score());
         s->setTrack(track());
         s->read(e);
         add(s);
-    } else if (tag == "Image") {
+    }
+    break;
+    case XmlTag::IMAGE:
         if (MScore::noImages) {
             e.skipCurrentElement();
         } else {
@@ -1634,16 +1660,21 @@ bool Note::readProperties(XmlReader& e)
             image->read(e);
             add(image);
         }
-    } else if (tag == "Bend") {
+        break;
+    case XmlTag::BEND: {
         Bend* b = new Bend(score());
         b->setTrack(track());
         b->read(e);
         add(b);
-    } else if (tag == "NoteDot") {
+    }
+    break;
+    case XmlTag::NOTE_DOT: {
         NoteDot* dot = new NoteDot(score());
         dot->read(e);
         add(dot);
-    } else if (tag == "Events") {
+    }
+    break;
+    case XmlTag::EVENTS:
         _playEvents.clear();        // remove default event
         while (e.readNextStartElement()) {
             const QStringRef& t(e.name());
@@ -1658,11 +1689,12 @@ bool Note::readProperties(XmlReader& e)
         if (chord()) {
             chord()->setPlayEventType(PlayEventType::User);
         }
-    } else if (tag == "offset") {
+        break;
+    case XmlTag::OFFSET:
         Element::readProperties(e);
-    } else if (Element::readProperties(e)) {
-    } else {
-        return false;
+        break;
+    default:
+        return Element::readProperties(e);
     }
     return true;
 }
@@ -2471,6 +2471,13 @@ void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 
 void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
 {
+    mu::framework::TraceSpan span("renderChunk");
+    if (span.isActive()) {
+        span.arg("startTick", chunk.tick1());
+        span.arg("endTick", chunk.tick2());
+        span.arg("staves", score->nstaves());
+    }
+
     // TODO: avoid doing it multiple times for the same measures
     score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
 
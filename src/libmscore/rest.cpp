@@ -923,13 +923,15 @@ void Rest::write(XmlWriter& xml) const
 void Rest::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
-        if (tag == "Symbol") {
+        switch (e.tag()) {
+        case XmlTag::SYMBOL: {
             Symbol* s = new Symbol(score());
             s->setTrack(track());
             s->read(e);
             add(s);
-        } else if (tag == "Image") {
+        }
+        break;
+        case XmlTag::IMAGE:
             if (MScore::noImages) {
                 e.skipCurrentElement();
             } else {
@@ -938,14 +940,22 @@ void Rest::read(XmlReader& e)
                 image->read(e);
                 add(image);
             }
-        } else if (tag == "NoteDot") {
+            break;
+        case XmlTag::NOTE_DOT: {
             NoteDot* dot = new NoteDot(score());
             dot->read(e);
             add(dot);
-        } else if (readStyledProperty(e, tag)) {
-        } else if (ChordRest::readProperties(e)) {
-        } else {
-            e.unknown();
+        }
+        break;
+        default: {
+            const QStringRef& tag(e.name());
+            if (readStyledProperty(e, tag)) {
+            } else if (ChordRest::readProperties(e)) {
+            } else {
+                e.unknown();
+            }
+        }
+        break;
         }
     }
 }
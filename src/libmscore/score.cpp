@@ -72,6 +72,7 @@
 #include "revisions.h"
 #include "tie.h"
 #include "tiemap.h"
+#include "layout.h"
 #include "layoutbreak.h"
 #include "harmony.h"
 #include "mscore.h"
@@ -5193,9 +5194,22 @@ MasterScore::~MasterScore()
     delete _repeatList2;
     delete _sigmap;
     delete _tempomap;
+    delete _minWidthScratch;
     qDeleteAll(_excerpts);
 }
 
+//---------------------------------------------------------
+//   minWidthScratch
+//---------------------------------------------------------
+
+MinWidthScratch& MasterScore::minWidthScratch()
+{
+    if (!_minWidthScratch) {
+        _minWidthScratch = new MinWidthScratch;
+    }
+    return *_minWidthScratch;
+}
+
 //---------------------------------------------------------
 //   setMovements
 //---------------------------------------------------------
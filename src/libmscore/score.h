@@ -34,6 +34,8 @@
 #include <QSet>
 
 #include "config.h"
+#include "elementpool.h"
+#include "layoutstatistics.h"
 #include "input.h"
 #include "instrument.h"
 #include "select.h"
@@ -75,6 +77,7 @@ class Lyrics;
 class MasterSynthesizer;
 class Measure;
 class MeasureBase;
+struct MinWidthScratch;
 class MuseScoreView;
 class Note;
 class Omr;
@@ -84,6 +87,8 @@ class Part;
 class RepeatList;
 class Rest;
 class Revisions;
+class ScoreCache;
+class MscSnapshot;
 class ScoreFont;
 class Segment;
 class Selection;
@@ -515,6 +520,7 @@ private:
     PlayMode _playMode { PlayMode::SYNTHESIZER };
 
     qreal _noteHeadWidth { 0.0 };         // cached value
+    LayoutStatistics _layoutStatistics;   // counters and timings of the last layout
     QString accInfo;                      ///< information about selected element(s) for use by screen-readers
     QString accMessage;                   ///< temporary status message for use by screen-readers
 
@@ -538,6 +544,7 @@ private:
     void cmdIncDecDuration(int nSteps, bool stepDotted = false);
 
     void createMMRest(Measure*, Measure*, const Fraction&);
+    void scanMMRestRun(LayoutContext&, Measure*);
 
     void beamGraceNotes(Chord*, bool);
 
@@ -860,6 +867,7 @@ public:
     bool saveFile(QIODevice* f, bool msczFormat, bool onlySelection = false);
     bool saveCompressedFile(QFileInfo&, bool onlySelection, bool createThumbnail = true);
     bool saveCompressedFile(QIODevice*, const QString& fileName, bool onlySelection, bool createThumbnail = true);
+    MscSnapshot createSnapshot(const QString& fileName, bool onlySelection, bool createThumbnail = true);
 
     void print(mu::draw::Painter* printer, int page);
     ChordRest* getSelectedChordRest() const;
@@ -1219,6 +1227,9 @@ public:
     qreal noteHeadWidth() const { return _noteHeadWidth; }
     void setNoteHeadWidth(qreal n) { _noteHeadWidth = n; }
 
+    const LayoutStatistics& layoutStatistics() const { return _layoutStatistics; }
+    void setLayoutStatistics(const LayoutStatistics& s) { _layoutStatistics = s; }
+
     QList<int> uniqueStaves() const;
     void transpositionChanged(Part*, Interval, Fraction tickStart = { 0, 1 }, Fraction tickEnd = { -1, 1 });
 
@@ -1343,6 +1354,7 @@ class MasterScore : public Score
     Movements* _movements   { 0 };
 
     bool _readOnly          { false };
+    bool _resolveStyleDefaults { false };             // while reading: take defaults from <defaultsVersion>
 
     CmdState _cmdState;       // modified during cmd processing
 
@@ -1371,6 +1383,12 @@ class MasterScore : public Score
     QFileInfo _sessionStartBackupInfo;
     QFileInfo info;
 
+    LayoutArena _layoutArena;                         // transient layout data, rewound after each layout
+    LayoutArena _systemLayoutArena;                   // transient data of one system, rewound after each system
+    MinWidthScratch* _minWidthScratch { nullptr };
+    AllocationStatistics _loadAllocations;            // element allocations of the last load
+    AllocationStatistics _layoutAllocations;          // element allocations of the last layout
+
     bool read(XmlReader&);
     void setPrev(MasterScore* s) { _prev = s; }
     void setNext(MasterScore* s) { _next = s; }
@@ -1384,6 +1402,7 @@ public:
     virtual bool isMaster() const override { return true; }
     virtual bool readOnly() const override { return _readOnly; }
     void setReadOnly(bool ro) { _readOnly = ro; }
+    bool resolveStyleDefaults() const { return _resolveStyleDefaults; }
     virtual UndoStack* undoStack() const override { return _movements->undo(); }
     virtual TimeSigMap* sigmap() const override { return _sigmap; }
     virtual TempoMap* tempomap() const override { return _tempomap; }
@@ -1430,16 +1449,17 @@ public:
     void setTempomap(TempoMap* tm);
 
     bool saveFile(bool generateBackup = true);
+    bool createSaveSnapshot(MscSnapshot&, bool createThumbnail = true);
+    QString saveBackupDir(bool generateBackup) const;
+    void setSaveFinished(const QString& backupDir, int undoState);
     FileError read1(XmlReader&, bool ignoreVersionError);
-    FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
+    FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError, ScoreCache* cache = nullptr);
+    FileError loadCachedMsc(const ScoreCache& cache, bool ignoreVersionError);
     FileError loadMsc(QString name, bool ignoreVersionError);
     FileError loadMsc(QString name, QIODevice*, bool ignoreVersionError);
     FileError read114(XmlReader&);
     FileError read206(XmlReader&);
     FileError read302(XmlReader&);
-    QByteArray readToBuffer();
-    QByteArray readCompressedToBuffer();
-    int readStyleDefaultsVersion();
     int styleDefaultByMscVersion(const int mscVer) const;
 
     Omr* omr() const { return _omr; }
@@ -1502,6 +1522,13 @@ public:
 
     virtual MStyle& style() override { return movements()->style(); }
     virtual const MStyle& style() const override { return movements()->style(); }
+
+    LayoutArena* layoutArena() { return &_layoutArena; }
+    LayoutArena* systemLayoutArena() { return &_systemLayoutArena; }
+    MinWidthScratch& minWidthScratch();
+    const AllocationStatistics& loadAllocations() const { return _loadAllocations; }
+    const AllocationStatistics& layoutAllocations() const { return _layoutAllocations; }
+    void setLayoutAllocations(const AllocationStatistics& s) { _layoutAllocations = s; }
 };
 
 //---------------------------------------------------------
@@ -0,0 +1,372 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scorecache.h"
+
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include "mscore.h"
+
+namespace Ms {
+static QString scoreCacheDirectory;
+
+static const char MAGIC[8] = { 'M', 'S', 'C', 'C', 'A', 'C', 'H', 'E' };
+
+static constexpr int HEADER_SIZE     = 56;
+static constexpr int RECORD_SIZE     = 32;
+static constexpr int HASH_SIZE       = 16;
+static constexpr int HASH_OFFSET     = 32;
+static constexpr int CHECKSUM_OFFSET = 48;
+
+static constexpr quint64 FNV_OFFSET = 14695981039346656037ULL;
+
+//---------------------------------------------------------
+//   checksum
+//    FNV-1a, 64 bit
+//---------------------------------------------------------
+
+static quint64 checksum(const uchar* p, qint64 n, quint64 h = FNV_OFFSET)
+{
+    for (qint64 i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   headerChecksum
+//    covers the header up to the checksum, the records and
+//    the string table, but not the payload
+//---------------------------------------------------------
+
+static quint64 headerChecksum(const uchar* p, qint64 stringsEnd)
+{
+    quint64 h = checksum(p, CHECKSUM_OFFSET);
+    return checksum(p + HEADER_SIZE, stringsEnd - HEADER_SIZE, h);
+}
+
+//---------------------------------------------------------
+//   align8
+//---------------------------------------------------------
+
+static qint64 align8(qint64 n)
+{
+    return (n + 7) & ~qint64(7);
+}
+
+//---------------------------------------------------------
+//   ScoreCache
+//---------------------------------------------------------
+
+ScoreCache::ScoreCache(const QString& sourcePath)
+{
+    if (isEnabled()) {
+        QFileInfo fi(sourcePath);
+        QByteArray path = fi.absoluteFilePath().toUtf8();
+        QString name = QCryptographicHash::hash(path, QCryptographicHash::Md5).toHex();
+        _filePath = scoreCacheDirectory + "/" + name + ".mscache";
+    }
+}
+
+ScoreCache::~ScoreCache()
+{
+    close();
+}
+
+//---------------------------------------------------------
+//   setCacheDirectory
+//    an empty directory disables the cache
+//---------------------------------------------------------
+
+void ScoreCache::setCacheDirectory(const QString& dir)
+{
+    scoreCacheDirectory = dir;
+}
+
+QString ScoreCache::cacheDirectory()
+{
+    return scoreCacheDirectory;
+}
+
+bool ScoreCache::isEnabled()
+{
+    return !scoreCacheDirectory.isEmpty();
+}
+
+//---------------------------------------------------------
+//   prune
+//    remove cache files not used for maxAgeDays, then the
+//    least recently used until the rest fits maxSize; the
+//    most recently used file is always kept
+//---------------------------------------------------------
+
+void ScoreCache::prune(qint64 maxSize, int maxAgeDays)
+{
+    if (!isEnabled()) {
+        return;
+    }
+    const QFileInfoList files = QDir(scoreCacheDirectory).entryInfoList({ "*.mscache" }, QDir::Files, QDir::Time);
+    const QDateTime oldest = QDateTime::currentDateTime().addDays(-maxAgeDays);
+    qint64 size = 0;
+    for (int i = 0; i < files.size(); ++i) {
+        const QFileInfo& fi = files[i];
+        size += fi.size();
+        if (i > 0 && (size > maxSize || fi.lastModified() < oldest)) {
+            if (QFile::remove(fi.absoluteFilePath())) {
+                size -= fi.size();
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   setSourceData
+//    the content of the .mscz; a cache is only valid for
+//    source data of the same size and hash
+//---------------------------------------------------------
+
+void ScoreCache::setSourceData(const QByteArray& data)
+{
+    _sourceData = data;
+}
+
+//---------------------------------------------------------
+//   open
+//    map the cache file and check that it is valid for
+//    the source data set by setSourceData(); the payload
+//    is not read except for the root file
+//---------------------------------------------------------
+
+bool ScoreCache::open()
+{
+    close();
+    if (_filePath.isEmpty() || _sourceData.isNull()) {
+        return false;
+    }
+    _file.setFileName(_filePath);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = _file.size();
+    if (size < HEADER_SIZE) {
+        close();
+        return false;
+    }
+    const uchar* p = _file.map(0, size);
+    if (!p) {
+        close();
+        return false;
+    }
+    _map     = p;
+    _mapSize = size;
+
+    quint32 entries     = qFromLittleEndian<quint32>(p + 16);
+    quint32 stringsSize = qFromLittleEndian<quint32>(p + 20);
+    qint64 stringsOffset = HEADER_SIZE + qint64(entries) * RECORD_SIZE;
+
+    bool ok = memcmp(p, MAGIC, sizeof(MAGIC)) == 0
+              && qFromLittleEndian<quint32>(p + 8) == FORMAT_VERSION
+              && qFromLittleEndian<quint32>(p + 12) == quint32(MSCVERSION)
+              && qFromLittleEndian<quint64>(p + 24) == quint64(_sourceData.size())
+              && stringsOffset + stringsSize <= size
+              && qFromLittleEndian<quint64>(p + CHECKSUM_OFFSET) == headerChecksum(p, stringsOffset + stringsSize);
+    if (ok) {
+        const QByteArray hash = QCryptographicHash::hash(_sourceData, QCryptographicHash::Md5);
+        ok = memcmp(p + HASH_OFFSET, hash.constData(), HASH_SIZE) == 0;
+    }
+
+    for (quint32 i = 0; ok && i < entries; ++i) {
+        const uchar* r = p + HEADER_SIZE + i * RECORD_SIZE;
+        Record rec;
+        rec.nameOffset = qFromLittleEndian<quint32>(r);
+        rec.nameLength = qFromLittleEndian<quint32>(r + 4);
+        rec.dataOffset = qFromLittleEndian<quint64>(r + 8);
+        rec.dataSize   = qFromLittleEndian<quint64>(r + 16);
+        rec.checksum   = qFromLittleEndian<quint64>(r + 24);
+        if (quint64(rec.nameOffset) + rec.nameLength > stringsSize
+            || rec.dataOffset > quint64(size) || rec.dataSize > quint64(size) - rec.dataOffset) {
+            ok = false;
+            break;
+        }
+        const char* name = reinterpret_cast<const char*>(p + stringsOffset + rec.nameOffset);
+        _names.append(QString::fromUtf8(name, rec.nameLength));
+        _records.append(rec);
+        _verified.append(false);
+    }
+    // the root file is read right away, its pages are touched anyway
+    if (ok && entries > 0) {
+        ok = verify(0);
+    }
+    if (!ok) {
+        qDebug("ScoreCache: <%s> is outdated or damaged", qPrintable(_filePath));
+        close();
+        return false;
+    }
+    // the modification time of the cache file is its last use, see prune()
+    _file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+//---------------------------------------------------------
+//   close
+//---------------------------------------------------------
+
+void ScoreCache::close()
+{
+    if (_map) {
+        _file.unmap(const_cast<uchar*>(_map));
+        _map = nullptr;
+    }
+    _mapSize = 0;
+    _file.close();
+    _names.clear();
+    _records.clear();
+    _verified.clear();
+}
+
+//---------------------------------------------------------
+//   verify
+//    compare the data of an entry to its checksum, each
+//    entry is checked once
+//---------------------------------------------------------
+
+bool ScoreCache::verify(int idx) const
+{
+    if (!_verified[idx]) {
+        const Record& r = _records[idx];
+        if (checksum(_map + r.dataOffset, qint64(r.dataSize)) != r.checksum) {
+            qDebug("ScoreCache: entry <%s> of <%s> is damaged", qPrintable(_names[idx]), qPrintable(_filePath));
+            return false;
+        }
+        _verified[idx] = true;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   names
+//    entry names, the root file is the first entry
+//---------------------------------------------------------
+
+QStringList ScoreCache::names() const
+{
+    return _names;
+}
+
+//---------------------------------------------------------
+//   data
+//    returns the data of an entry without copying it,
+//    valid as long as the cache is open; a damaged entry
+//    is returned empty
+//---------------------------------------------------------
+
+QByteArray ScoreCache::data(const QString& name) const
+{
+    int idx = _names.indexOf(name);
+    if (idx < 0 || !verify(idx)) {
+        return QByteArray();
+    }
+    const Record& r = _records[idx];
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(_map + r.dataOffset), int(r.dataSize));
+}
+
+//---------------------------------------------------------
+//   write
+//---------------------------------------------------------
+
+bool ScoreCache::write(const QList<Entry>& entries) const
+{
+    if (_filePath.isEmpty() || _sourceData.isNull() || !QDir().mkpath(scoreCacheDirectory)) {
+        return false;
+    }
+
+    QByteArray strings;
+    QList<QByteArray> names;
+    for (const Entry& e : entries) {
+        names.append(e.name.toUtf8());
+    }
+    for (const QByteArray& n : names) {
+        strings.append(n);
+    }
+
+    const qint64 recordsSize = qint64(entries.size()) * RECORD_SIZE;
+    qint64 dataOffset        = align8(HEADER_SIZE + recordsSize + strings.size());
+    qint64 size              = dataOffset;
+    for (const Entry& e : entries) {
+        size = align8(size + e.data.size());
+    }
+
+    QByteArray buffer(int(size), '\0');
+    uchar* p = reinterpret_cast<uchar*>(buffer.data());
+
+    memcpy(p, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint32>(FORMAT_VERSION, p + 8);
+    qToLittleEndian<quint32>(quint32(MSCVERSION), p + 12);
+    qToLittleEndian<quint32>(quint32(entries.size()), p + 16);
+    qToLittleEndian<quint32>(quint32(strings.size()), p + 20);
+    qToLittleEndian<quint64>(quint64(_sourceData.size()), p + 24);
+    const QByteArray hash = QCryptographicHash::hash(_sourceData, QCryptographicHash::Md5);
+    memcpy(p + HASH_OFFSET, hash.constData(), HASH_SIZE);
+
+    quint32 nameOffset = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        uchar* r = p + HEADER_SIZE + i * RECORD_SIZE;
+        const QByteArray& data = entries[i].data;
+        qToLittleEndian<quint32>(nameOffset, r);
+        qToLittleEndian<quint32>(quint32(names[i].size()), r + 4);
+        qToLittleEndian<quint64>(quint64(dataOffset), r + 8);
+        qToLittleEndian<quint64>(quint64(data.size()), r + 16);
+        qToLittleEndian<quint64>(checksum(reinterpret_cast<const uchar*>(data.constData()), data.size()), r + 24);
+        memcpy(p + dataOffset, data.constData(), data.size());
+        nameOffset += names[i].size();
+        dataOffset  = align8(dataOffset + data.size());
+    }
+    memcpy(p + HEADER_SIZE + recordsSize, strings.constData(), strings.size());
+    qToLittleEndian<quint64>(headerChecksum(p, HEADER_SIZE + recordsSize + strings.size()), p + CHECKSUM_OFFSET);
+
+    QSaveFile f(_filePath);
+    if (!f.open(QIODevice::WriteOnly) || f.write(buffer) != size || !f.commit()) {
+        return false;
+    }
+    prune();
+    return true;
+}
+
+//---------------------------------------------------------
+//   remove
+//---------------------------------------------------------
+
+void ScoreCache::remove()
+{
+    close();
+    if (!_filePath.isEmpty()) {
+        QFile::remove(_filePath);
+    }
+}
+}
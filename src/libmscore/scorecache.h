@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef __SCORECACHE_H__
+#define __SCORECACHE_H__
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Ms {
+//---------------------------------------------------------
+//   ScoreCache
+//    binary sidecar of a compressed score file
+//    The cache keeps the uncompressed root file, images
+//    and audio of a .mscz in one memory mapped file, so
+//    reopening a score needs no inflate. It is only used if
+//    size and hash of the source data match the cached ones,
+//    otherwise the score is read from the .mscz and the cache
+//    is rewritten.
+//    Opening a cache reads the header, the records and the
+//    root file; other entries are checked on first access.
+//    Writing a cache prunes the cache directory: files not
+//    used for MAX_AGE_DAYS are removed and the least recently
+//    used are removed until the directory fits MAX_SIZE.
+//
+//    Layout (little endian):
+//      Header    magic, format version, MSCVERSION, entry count,
+//                source size, source hash, checksum of header,
+//                records and strings
+//      Records   fixed width: name offset/length in the string
+//                table, data offset/size in the payload, data
+//                checksum
+//      Strings   entry names, utf8
+//      Payload   entry data, 8 byte aligned
+//---------------------------------------------------------
+
+class ScoreCache
+{
+public:
+    struct Entry {
+        QString name;
+        QByteArray data;
+    };
+
+    static constexpr quint32 FORMAT_VERSION = 3;
+    static constexpr qint64 MAX_SIZE        = 512 * 1024 * 1024;
+    static constexpr int MAX_AGE_DAYS       = 30;
+
+    ScoreCache(const QString& sourcePath);
+    ~ScoreCache();
+
+    static void setCacheDirectory(const QString& dir);
+    static QString cacheDirectory();
+    static bool isEnabled();
+    static void prune(qint64 maxSize = MAX_SIZE, int maxAgeDays = MAX_AGE_DAYS);
+
+    void setSourceData(const QByteArray& data);
+
+    bool open();
+    void close();
+    bool isOpen() const { return _map != nullptr; }
+
+    QStringList names() const;
+    QByteArray data(const QString& name) const;
+
+    bool write(const QList<Entry>& entries) const;
+    void remove();
+
+    QString filePath() const { return _filePath; }
+
+private:
+    struct Record {
+        quint32 nameOffset;
+        quint32 nameLength;
+        quint64 dataOffset;
+        quint64 dataSize;
+        quint64 checksum;
+    };
+
+    bool verify(int idx) const;
+
+    QString _filePath;
+    QByteArray _sourceData;
+    QFile _file;
+    const uchar* _map     { nullptr };
+    qint64 _mapSize       { 0 };
+    QStringList _names;
+    QList<Record> _records;
+    mutable QList<bool> _verified;
+};
+}     // namespace Ms
+#endif
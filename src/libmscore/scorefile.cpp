@@ -20,7 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include <QDir>
 #include <QBuffer>
 
@@ -56,6 +58,8 @@
 #include "sig.h"
 #include "undo.h"
 #include "imageStore.h"
+#include "scorecache.h"
+#include "mscsnapshot.h"
 #include "audio.h"
 #include "barline.h"
 #include "thirdparty/qzip/qzipreader_p.h"
@@ -401,127 +405,80 @@ void Score::readStaff(XmlReader& e)
 
 bool MasterScore::saveFile(bool generateBackup)
 {
-    if (readOnly()) {
-        return false;
-    }
-    QString suffix = info.suffix();
-    if (info.exists() && !info.isWritable()) {
-        MScore::lastError = tr("The following file is locked: \n%1 \n\nTry saving to a different location.").arg(info.filePath());
+    MscSnapshot snapshot;
+    if (!createSaveSnapshot(snapshot)) {
         return false;
     }
-    //
-    // step 1
-    // save into temporary file to prevent partially overwriting
-    // the original file in case of "disc full"
-    //
-
-    QString tempName = info.filePath() + QString(".temp");
-    QFile temp(tempName);
-    if (!temp.open(QIODevice::WriteOnly)) {
-        MScore::lastError = tr("Open Temp File\n%1\nfailed: %2").arg(tempName, strerror(errno));
+    const QString backupDir = saveBackupDir(generateBackup);
+    QString error;
+    if (!snapshot.saveFile(info.filePath(), backupDir, &error)) {
+        MScore::lastError = error;
         return false;
     }
+    setSaveFinished(backupDir, undoStack()->state());
+    return true;
+}
 
-    bool rv = false;
-    if ("mscx" == suffix) {
-        rv = Score::saveFile(&temp, false);
-    } else {
-        QString fileName = info.completeBaseName() + ".mscx";
-        rv = Score::saveCompressedFile(&temp, fileName, false);
-    }
+//---------------------------------------------------------
+//   createSaveSnapshot
+//    first part of saveFile(), serialize the score for
+//    MscSnapshot::saveFile()
+//    Return false on error.
+//---------------------------------------------------------
 
-    if (!rv) {
+bool MasterScore::createSaveSnapshot(MscSnapshot& snapshot, bool createThumbnail)
+{
+    if (readOnly()) {
         return false;
     }
-
-    if (temp.error() != QFile::NoError) {
-        MScore::lastError = tr("Save File failed: %1").arg(temp.errorString());
+    if (info.exists() && !info.isWritable()) {
+        MScore::lastError = tr("The following file is locked: \n%1 \n\nTry saving to a different location.").arg(info.filePath());
         return false;
     }
-    temp.close();
 
-    const QString name(info.filePath());
-    const QString basename(info.fileName());
-    QDir dir(info.path());
-    if (!saved() && generateBackup) {
-        // if file was already saved in this session
-        // save but don't overwrite backup again
-
-        //
-        // step 2
-        // remove old backup file if exists
-        // remove the backup file in the same dir as score (the traditional place) if exists
-        //
-        const QString backupSubdirString = preferences().backupDirPath();
-        const QString backupDirString = info.path() + QString(QDir::separator()) + backupSubdirString;
-        QDir backupDir(backupDirString);
-        if (!backupDir.exists()) {
-            dir.mkdir(backupSubdirString);
-#ifdef Q_OS_WIN
-            const QString backupDirNativePath = QDir::toNativeSeparators(backupDirString);
-            SetFileAttributesW(reinterpret_cast<LPCWSTR>(backupDirNativePath.utf16()), FILE_ATTRIBUTE_HIDDEN);
-#endif
-        }
-        const QString backupName = QString(".") + info.fileName() + QString(",");
-        if (backupDir.exists(backupName)) {
-            if (!backupDir.remove(backupName)) {
-//                      if (!MScore::noGui)
-//                            QMessageBox::critical(0, QObject::tr("Save File"),
-//                               tr("Removing old backup file %1 failed").arg(backupName));
-            }
-        }
-        // backup files prior to 3.5 were saved in the same directory as the file itself.
-        // remove these old backup files if needed
-        if (dir != backupDir && dir.exists(backupName)) {
-            if (!dir.remove(backupName)) {
-//                      if (!MScore::noGui)
-//                            QMessageBox::critical(0, QObject::tr("Save File"),
-//                               tr("Removing old backup file %1 failed").arg(backupName));
-            }
-        }
-
-        //
-        // step 3
-        // rename old file into backup
-        //
-        if (dir.exists(basename)) {
-            if (!QFile::rename(name, backupDirString + (backupDirString.endsWith("/") ? "" : "/") + backupName)) {
-//                      if (!MScore::noGui)
-//                            QMessageBox::critical(0, tr("Save File"),
-//                               tr("Renaming old file <%1> to backup <%2> failed").arg(name, backupDirString + "/" + backupName);
-            }
+    if ("mscx" == info.suffix()) {
+        QBuffer dbuf(&snapshot.score);
+        dbuf.open(QIODevice::WriteOnly);
+        if (!Score::saveFile(&dbuf, false)) {
+            return false;
         }
-
-        QFileInfo fileBackup(backupDir, backupName);
-        _sessionStartBackupInfo = fileBackup;
     } else {
-        // file has previously been saved - remove the old file
-        if (dir.exists(basename)) {
-            if (!dir.remove(basename)) {
-//                      if (!MScore::noGui)
-//                            QMessageBox::critical(0, tr("Save File"),
-//                               tr("Removing old file %1 failed").arg(name));
-            }
-        }
+        snapshot = createSnapshot(info.completeBaseName() + ".mscx", false, createThumbnail);
     }
+    return true;
+}
 
-    //
-    // step 4
-    // rename temp name into file name
-    //
-    if (!QFile::rename(tempName, name)) {
-        MScore::lastError = tr("Renaming temp. file <%1> to <%2> failed:\n%3").arg(tempName, name, strerror(errno));
-        return false;
+//---------------------------------------------------------
+//   saveBackupDir
+//    where saving keeps the previous file, empty if no
+//    backup is made: if the file was already saved in this
+//    session the backup is not overwritten again
+//---------------------------------------------------------
+
+QString MasterScore::saveBackupDir(bool generateBackup) const
+{
+    if (saved() || !generateBackup) {
+        return QString();
     }
-    // make file readable by all
-    QFile::setPermissions(name, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser
-                          | QFile::ReadGroup | QFile::ReadOther);
+    return info.path() + QString(QDir::separator()) + preferences().backupDirPath();
+}
 
-    undoStack()->setClean();
-    setSaved(true);
+//---------------------------------------------------------
+//   setSaveFinished
+//    last part of saveFile() after the snapshot taken at
+//    undo state undoState was written
+//---------------------------------------------------------
+
+void MasterScore::setSaveFinished(const QString& backupDir, int undoState)
+{
+    if (!backupDir.isEmpty()) {
+        _sessionStartBackupInfo = QFileInfo(QDir(backupDir), QString(".") + info.fileName() + QString(","));
+    }
+    undoStack()->setClean(undoState);
+    // edits made while the snapshot was written are not saved
+    setSaved(undoStack()->isClean());
     info.refresh();
     update();
-    return true;
 }
 
 //---------------------------------------------------------
@@ -591,10 +548,23 @@ QImage Score::createThumbnail()
 
 bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelection, bool doCreateThumbnail)
 {
-    MQZipWriter uz(f);
+    return createSnapshot(fn, onlySelection, doCreateThumbnail).write(f);
+}
+
+//---------------------------------------------------------
+//   createSnapshot
+//    serialize the score for a compressed file whose
+//    root file is fn; the thumbnail is rendered but not
+//    encoded
+//---------------------------------------------------------
+
+MscSnapshot Score::createSnapshot(const QString& fn, bool onlySelection, bool doCreateThumbnail)
+{
+    MscSnapshot snapshot;
+    snapshot.rootFile = fn;
 
-    QBuffer cbuf;
-    cbuf.open(QIODevice::ReadWrite);
+    QBuffer cbuf(&snapshot.container);
+    cbuf.open(QIODevice::WriteOnly);
     XmlWriter xml(this, &cbuf);
     xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
     xml.stag("container");
@@ -607,60 +577,25 @@ bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelecti
         }
         QString path = QString("Pictures/") + ip->hashName();
         xml.tag("file", path);
+        snapshot.images.append({ path, ip->buffer() });
     }
 
     xml.etag();
     xml.etag();
-    cbuf.seek(0);
-    //uz.addDirectory("META-INF");
-    uz.addFile("META-INF/container.xml", cbuf.data());
+    cbuf.close();
 
-    QBuffer dbuf;
-    dbuf.open(QIODevice::ReadWrite);
+    QBuffer dbuf(&snapshot.score);
+    dbuf.open(QIODevice::WriteOnly);
     saveFile(&dbuf, true, onlySelection);
-    dbuf.seek(0);
-    uz.addFile(fn, dbuf.data());
-
-    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
-    if (fd) { // if is file (may be buffer)
-        fd->flush();     // flush to preserve score data in case of
-    }
-    // any failures on the further operations.
-
-    // save images
-    //uz.addDirectory("Pictures");
-    for (ImageStoreItem* ip : imageStore) {
-        if (!ip->isUsed(this)) {
-            continue;
-        }
-        QString path = QString("Pictures/") + ip->hashName();
-        uz.addFile(path, ip->buffer());
-    }
+    dbuf.close();
 
-    // create thumbnail
     if (doCreateThumbnail && !pages().isEmpty()) {
-        QImage pm = createThumbnail();
-
-        QByteArray ba;
-        QBuffer b(&ba);
-        if (!b.open(QIODevice::WriteOnly)) {
-            qDebug("open buffer failed");
-        }
-        if (!pm.save(&b, "PNG")) {
-            qDebug("save failed");
-        }
-        uz.addFile("Thumbnails/thumbnail.png", ba);
+        snapshot.thumbnail = createThumbnail();
     }
-
-    //
-    // save audio
-    //
     if (_audio) {
-        uz.addFile("audio.ogg", _audio->data());
+        snapshot.audio = _audio->data();
     }
-
-    uz.close();
-    return true;
+    return snapshot;
 }
 
 //---------------------------------------------------------
@@ -820,9 +755,13 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
 //---------------------------------------------------------
 //   loadCompressedMsc
 //    return false on error
+//    The root file is parsed while it is inflated, images
+//    are inflated when they are first used.
+//    If a cache is given, the uncompressed content is
+//    written to it after a successful read.
 //---------------------------------------------------------
 
-Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersionError)
+Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersionError, ScoreCache* cache)
 {
     MQZipReader uz(io);
 
@@ -833,41 +772,118 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     }
 
     //
-    // load images
+    // load images, without a cache they are inflated on first use
     //
-    if (!MScore::noImages) {
-        foreach (const QString& s, sl) {
+    QList<ScoreCache::Entry> cacheEntries;
+    foreach (const QString& s, sl) {
+        if (cache) {
             QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            if (!MScore::noImages) {
+                imageStore.add(s, dbuf);
+            }
+            cacheEntries.append({ s, dbuf });
+        } else if (!MScore::noImages) {
+            std::shared_ptr<QIODevice> device(uz.fileDevice(s));
+            if (!device) {
+                continue;
+            }
+            imageStore.addLazy(s, [device]() {
+                QByteArray data;
+                if (device->open(QIODevice::ReadOnly)) {
+                    data = device->readAll();
+                    device->close();
+                }
+                return data;
+            });
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
-        QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
+    // fall back to the first .mscx file if the root file is missing
+    QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
+    if (std::none_of(fil.begin(), fil.end(), [&rootfile](const MQZipReader::FileInfo& fi) { return fi.filePath == rootfile; })) {
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                rootfile = fi.filePath;
                 break;
             }
         }
     }
 
-    XmlReader e(dbuf);
-    e.setDocName(masterScore()->fileInfo()->completeBaseName());
-
-    FileError retval = read1(e, ignoreVersionError);
+    FileError retval;
+    QByteArray dbuf;
+    if (cache) {
+        dbuf = uz.fileData(rootfile);
+        XmlReader e(dbuf);
+        e.setDocName(masterScore()->fileInfo()->completeBaseName());
+        retval = read1(e, ignoreVersionError);
+    } else {
+        //
+        // the root file is inflated on a worker thread while
+        // it is parsed, it is never held in memory as a whole
+        //
+        std::unique_ptr<QIODevice> device(uz.fileDevice(rootfile));
+        QBuffer empty;
+        QIODevice* in = device ? device.get() : &empty;
+        in->open(QIODevice::ReadOnly);
+        XmlReader e(in);
+        e.setDocName(masterScore()->fileInfo()->completeBaseName());
+        retval = read1(e, ignoreVersionError);
+    }
 
     //
     //  read audio
     //
+    QByteArray audioData;
+    if (audio() || cache) {
+        audioData = uz.fileData("audio.ogg");
+    }
     if (audio()) {
-        QByteArray dbuf1 = uz.fileData("audio.ogg");
-        audio()->setData(dbuf1);
+        audio()->setData(audioData);
+    }
+
+    if (cache && retval == FileError::FILE_NO_ERROR) {
+        cacheEntries.prepend({ rootfile, dbuf });
+        if (!audioData.isEmpty()) {
+            cacheEntries.append({ "audio.ogg", audioData });
+        }
+        if (!cache->write(cacheEntries)) {
+            qDebug("cannot write score cache <%s>", qPrintable(cache->filePath()));
+        }
     }
     return retval;
 }
 
+//---------------------------------------------------------
+//   loadCachedMsc
+//    read the content of a compressed score from an open
+//    cache; the first entry is the root file
+//---------------------------------------------------------
+
+Score::FileError MasterScore::loadCachedMsc(const ScoreCache& cache, bool ignoreVersionError)
+{
+    QStringList names = cache.names();
+    if (names.isEmpty()) {
+        return FileError::FILE_NO_ROOTFILE;
+    }
+
+    // data is copied, the image store and audio outlive the mapping
+    for (int i = 1; i < names.size(); ++i) {
+        QByteArray data = cache.data(names[i]);
+        if (names[i] == "audio.ogg") {
+            if (audio()) {
+                audio()->setData(QByteArray(data.constData(), data.size()));
+            }
+        } else if (!MScore::noImages) {
+            imageStore.add(names[i], QByteArray(data.constData(), data.size()));
+        }
+    }
+
+    XmlReader e(cache.data(names[0]));
+    e.setDocName(masterScore()->fileInfo()->completeBaseName());
+
+    return read1(e, ignoreVersionError);
+}
+
 int MasterScore::styleDefaultByMscVersion(const int mscVer) const
 {
     constexpr int LEGACY_MSC_VERSION_V3 = 301;
@@ -889,25 +905,6 @@ int MasterScore::styleDefaultByMscVersion(const int mscVer) const
     return MSCVERSION;
 }
 
-int MasterScore::readStyleDefaultsVersion()
-{
-    if (styleB(Sid::usePre_3_6_defaults)) {
-        return style().defaultStyleVersion();
-    }
-
-    XmlReader e(readToBuffer());
-    e.setDocName(masterScore()->fileInfo()->completeBaseName());
-
-    while (!e.atEnd()) {
-        e.readNext();
-        if (e.name() == "defaultsVersion") {
-            return e.readInt();
-        }
-    }
-
-    return styleDefaultByMscVersion(mscVersion());
-}
-
 //---------------------------------------------------------
 //   loadMsc
 //    return true on success
@@ -928,12 +925,31 @@ Score::FileError MasterScore::loadMsc(QString name, QIODevice* io, bool ignoreVe
     ScoreLoad sl;
     fileInfo()->setFile(name);
 
+    const AllocationStatistics allocations = ElementPool::statistics();
+    FileError retval;
     if (name.endsWith(".mscz") || name.endsWith(".mscz,")) {
-        return loadCompressedMsc(io, ignoreVersionError);
+        if (ScoreCache::isEnabled()) {
+            // the cache is only used if it was written for the
+            // same source data, the archive is not inflated then
+            QByteArray source = io->readAll();
+            ScoreCache cache(name);
+            cache.setSourceData(source);
+            if (cache.open()) {
+                retval = loadCachedMsc(cache, ignoreVersionError);
+            } else {
+                QBuffer buffer(&source);
+                buffer.open(QIODevice::ReadOnly);
+                retval = loadCompressedMsc(&buffer, ignoreVersionError, &cache);
+            }
+        } else {
+            retval = loadCompressedMsc(io, ignoreVersionError);
+        }
     } else {
         XmlReader r(io);
-        return read1(r, ignoreVersionError);
+        retval = read1(r, ignoreVersionError);
     }
+    _loadAllocations = ElementPool::statistics() - allocations;
+    return retval;
 }
 
 //---------------------------------------------------------
@@ -1014,11 +1030,19 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
 
             if (created() && !preferences().defaultStyleFilePath().isEmpty()) {
                 setStyle(MScore::defaultStyle());
+            } else if (styleB(Sid::usePre_3_6_defaults)) {
+                int defaultsVersion = style().defaultStyleVersion();
+
+                setStyle(*MStyle::resolveStyleDefaults(defaultsVersion));
+                style().setDefaultStyleVersion(defaultsVersion);
             } else {
-                int defaultsVersion = readStyleDefaultsVersion();
+                // the defaults are rebased when the style names its
+                // <defaultsVersion>, see MStyle::load()
+                int defaultsVersion = styleDefaultByMscVersion(mscVersion());
 
                 setStyle(*MStyle::resolveStyleDefaults(defaultsVersion));
                 style().setDefaultStyleVersion(defaultsVersion);
+                _resolveStyleDefaults = true;
             }
 
             Score::FileError error;
@@ -1029,6 +1053,7 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
             } else {
                 error = read302(e);
             }
+            _resolveStyleDefaults = false;
             setExcerptsChanged(false);
             return error;
         } else {
@@ -1064,57 +1089,6 @@ void Score::print(mu::draw::Painter* painter, int pageNo)
     _printing = false;
 }
 
-//---------------------------------------------------------
-//   readCompressedToBuffer
-//---------------------------------------------------------
-
-QByteArray MasterScore::readCompressedToBuffer()
-{
-    MQZipReader uz(info.filePath());
-    if (!uz.exists()) {
-        qDebug("Score::readCompressedToBuffer: cannot read zip file");
-        return QByteArray();
-    }
-    QList<QString> images;
-    QString rootfile = readRootFile(&uz, images);
-
-    //
-    // load images
-    //
-    foreach (const QString& s, images) {
-        QByteArray dbuf = uz.fileData(s);
-        imageStore.add(s, dbuf);
-    }
-
-    if (rootfile.isEmpty()) {
-        qDebug("=can't find rootfile in: %s", qPrintable(info.filePath()));
-        return QByteArray();
-    }
-    return uz.fileData(rootfile);
-}
-
-//---------------------------------------------------------
-//   readToBuffer
-//---------------------------------------------------------
-
-QByteArray MasterScore::readToBuffer()
-{
-    QByteArray ba;
-    QString cs  = info.suffix();
-
-    if (cs == "mscz") {
-        ba = readCompressedToBuffer();
-    }
-    if (cs.toLower() == "msc" || cs.toLower() == "mscx") {
-        QFile f(info.filePath());
-        if (f.open(QIODevice::ReadOnly)) {
-            ba = f.readAll();
-            f.close();
-        }
-    }
-    return ba;
-}
-
 //---------------------------------------------------------
 //   createRevision
 //---------------------------------------------------------
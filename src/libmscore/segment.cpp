@@ -49,6 +49,8 @@
 #include "harmony.h"
 #include "hook.h"
 
+#include <atomic>
+
 namespace Ms {
 //---------------------------------------------------------
 //   subTypeName
@@ -87,6 +89,7 @@ const char* Segment::subTypeName(SegmentType t)
 
 void Segment::setElement(int track, Element* el)
 {
+    invalidateStaffOccupancy();
     if (el) {
         el->setParent(this);
         _elist[track] = el;
@@ -470,6 +473,7 @@ Element* Segment::element(int track) const
 
 void Segment::insertStaff(int staff)
 {
+    invalidateStaffOccupancy();
     int track = staff * VOICES;
     for (int voice = 0; voice < VOICES; ++voice) {
         _elist.insert(_elist.begin() + track, 0);
@@ -492,6 +496,7 @@ void Segment::insertStaff(int staff)
 
 void Segment::removeStaff(int staff)
 {
+    invalidateStaffOccupancy();
     int track = staff * VOICES;
     _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
     _dotPosX.erase(_dotPosX.begin() + staff);
@@ -507,6 +512,18 @@ void Segment::removeStaff(int staff)
     fixStaffIdx();
 }
 
+//---------------------------------------------------------
+//   invalidateStaffOccupancy
+//    the measure rescans its staff occupancy on next use
+//---------------------------------------------------------
+
+void Segment::invalidateStaffOccupancy()
+{
+    if (isChordRestType() && parent() && parent()->isMeasure()) {
+        measure()->invalidateStaffOccupancy();
+    }
+}
+
 //---------------------------------------------------------
 //   checkElement
 //---------------------------------------------------------
@@ -534,6 +551,7 @@ void Segment::add(Element* el)
 //      qDebug("%p segment %s add(%d, %d, %s)", this, subTypeName(), tick(), el->track(), el->name());
 
     el->setParent(this);
+    invalidateStaffOccupancy();
 
     int track = el->track();
     Q_ASSERT(track != -1);
@@ -678,6 +696,7 @@ void Segment::remove(Element* el)
 {
 // qDebug("%p Segment::remove %s %p", this, el->name(), el);
 
+    invalidateStaffOccupancy();
     int track = el->track();
 
     switch (el->type()) {
@@ -822,6 +841,7 @@ SegmentType Segment::segmentType(ElementType type)
 
 void Segment::sortStaves(QList<int>& dst)
 {
+    invalidateStaffOccupancy();
     std::vector<Element*> dl;
     dl.reserve(dst.size());
 
@@ -885,6 +905,7 @@ void Segment::checkEmpty() const
 
 void Segment::swapElements(int i1, int i2)
 {
+    invalidateStaffOccupancy();
     std::iter_swap(_elist.begin() + i1, _elist.begin() + i2);
     if (_elist[i1]) {
         _elist[i1]->setTrack(i1);
@@ -920,16 +941,19 @@ void Segment::write(XmlWriter& xml) const
 void Segment::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
-
-        if (tag == "subtype") {
+        switch (e.tag()) {
+        case XmlTag::SUBTYPE:
             e.skipCurrentElement();
-        } else if (tag == "leadingSpace") {
+            break;
+        case XmlTag::LEADING_SPACE:
             _extraLeadingSpace = Spatium(e.readDouble());
-        } else if (tag == "trailingSpace") {          // obsolete
+            break;
+        case XmlTag::TRAILING_SPACE:            // obsolete
             e.readDouble();
-        } else {
+            break;
+        default:
             e.unknown();
+            break;
         }
     }
 }
@@ -1202,6 +1226,7 @@ std::vector<Element*> Segment::findAnnotations(ElementType type, int minTrack, i
 
 void Segment::removeAnnotation(Element* e)
 {
+    invalidateStaffOccupancy();
     for (auto i = _annotations.begin(); i != _annotations.end(); ++i) {
         if (*i == e) {
             _annotations.erase(i);
@@ -1216,6 +1241,7 @@ void Segment::removeAnnotation(Element* e)
 
 void Segment::clearAnnotations()
 {
+    invalidateStaffOccupancy();
     _annotations.clear();
 }
 
@@ -2193,12 +2219,26 @@ void Segment::createShapes()
     }
 }
 
+//---------------------------------------------------------
+//   createdShapes
+//---------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> shapesCreated { 0 };
+}
+
+uint64_t Segment::createdShapes()
+{
+    return shapesCreated.load(std::memory_order_relaxed);
+}
+
 //---------------------------------------------------------
 //   createShape
 //---------------------------------------------------------
 
 void Segment::createShape(int staffIdx)
 {
+    shapesCreated.fetch_add(1, std::memory_order_relaxed);
     Shape& s = _shapes[staffIdx];
     s.clear();
 
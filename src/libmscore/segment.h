@@ -75,6 +75,7 @@ class Segment final : public Element
     void init();
     void checkEmpty() const;
     void checkElement(Element*, int track);
+    void invalidateStaffOccupancy();
     void setEmpty(bool val) const { setFlag(ElementFlag::EMPTY, val); }
 
 protected:
@@ -239,6 +240,7 @@ public:
     Shape& staffShape(int staffIdx) { return _shapes[staffIdx]; }
     void createShapes();
     void createShape(int staffIdx);
+    static uint64_t createdShapes();          // number of createShape() calls so far
     qreal minRight() const;
     qreal minLeft(const Shape&) const;
     qreal minLeft() const;
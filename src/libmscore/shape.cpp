@@ -21,6 +21,11 @@
  */
 
 #include "shape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "segment.h"
 
 namespace Ms {
@@ -88,6 +93,27 @@ Shape Shape::translated(const QPointF& pt) const
     return s;
 }
 
+//---------------------------------------------------------
+//   setTranslated
+//    replace contents by s moved by pt; keeps the memory
+//    of this shape so it can be reused without allocation
+//---------------------------------------------------------
+
+void Shape::setTranslated(const Shape& s, const QPointF& pt)
+{
+    clear();
+    for (const ShapeElement& r : s)
+#ifndef NDEBUG
+    {
+        add(r.translated(pt), r.text);
+    }
+#else
+    {
+        add(r.translated(pt));
+    }
+#endif
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -316,6 +342,129 @@ void Shape::paint(QPainter& p) const
     }
 }
 
+static constexpr qreal NoMatch = -std::numeric_limits<qreal>::infinity();
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void ShapeIndex::Rects::add(const QRectF& r)
+{
+    top.push_back(r.top());
+    bottom.push_back(r.bottom());
+    left.push_back(r.left());
+    right.push_back(r.right());
+}
+
+//---------------------------------------------------------
+//   ShapeIndex
+//---------------------------------------------------------
+
+ShapeIndex::ShapeIndex(const Shape& s)
+    : _maxRight(NoMatch), _zeroWidthRight(NoMatch)
+{
+    // horizontal
+    std::vector<size_t> byTop;
+    byTop.reserve(s.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+        const QRectF& r = s[i];
+        _maxRight = std::max(_maxRight, r.right());
+        if (r.width() == 0.0) {
+            // collides with everything
+            _zeroWidthRight = std::max(_zeroWidthRight, r.right());
+        } else if (!std::isnan(r.top()) && !std::isnan(r.bottom())) {
+            byTop.push_back(i);
+        }
+    }
+    std::stable_sort(byTop.begin(), byTop.end(), [&s](size_t a, size_t b) { return s[a].top() < s[b].top(); });
+    for (size_t i : byTop) {
+        if (s[i].height() == 0.0) {
+            _flat.add(s[i]);
+        } else {
+            _byTop.add(s[i]);
+        }
+    }
+
+    // vertical
+    std::vector<size_t> byLeft;
+    byLeft.reserve(s.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+        const QRectF& r = s[i];
+        if (r.height() > 0.0 && r.width() != 0.0 && !std::isnan(r.left()) && !std::isnan(r.right())) {
+            byLeft.push_back(i);
+        }
+    }
+    std::stable_sort(byLeft.begin(), byLeft.end(), [&s](size_t a, size_t b) { return s[a].left() < s[b].left(); });
+    for (size_t i : byLeft) {
+        _byLeft.add(s[i]);
+    }
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//    same as Shape::minHorizontalDistance()
+//---------------------------------------------------------
+
+qreal ShapeIndex::minHorizontalDistance(const Shape& a) const
+{
+    qreal dist = -1000000.0;
+    for (const QRectF& r2 : a) {
+        const qreal by1 = r2.top();
+        const qreal by2 = r2.bottom();
+        qreal right = _zeroWidthRight;
+        if (r2.width() == 0.0) {
+            right = _maxRight;
+        } else if (r2.height() == 0.0) {
+            // flat rectangles at the same y
+            auto i = std::lower_bound(_flat.top.begin(), _flat.top.end(), by1);
+            for (size_t k = i - _flat.top.begin(); k < _flat.size() && _flat.top[k] == by1; ++k) {
+                right = std::max(right, _flat.right[k]);
+            }
+        } else {
+            // only rectangles starting above by2 can overlap
+            const size_t n = std::lower_bound(_byTop.top.begin(), _byTop.top.end(), by2) - _byTop.top.begin();
+            const qreal* bottom = _byTop.bottom.data();
+            const qreal* rights = _byTop.right.data();
+            for (size_t k = 0; k < n; ++k) {
+                right = std::max(right, bottom[k] > by1 ? rights[k] : NoMatch);
+            }
+        }
+        if (right != NoMatch) {
+            dist = qMax(dist, right - r2.left());
+        }
+    }
+    return dist;
+}
+
+//---------------------------------------------------------
+//   minVerticalDistance
+//    same as Shape::minVerticalDistance()
+//---------------------------------------------------------
+
+qreal ShapeIndex::minVerticalDistance(const Shape& a) const
+{
+    qreal dist = -1000000.0;
+    for (const QRectF& r2 : a) {
+        if (r2.height() <= 0.0 || r2.width() == 0.0) {
+            continue;
+        }
+        const qreal bx1 = r2.left();
+        const qreal bx2 = r2.right();
+        // only rectangles starting left of bx2 can overlap
+        const size_t n = std::lower_bound(_byLeft.left.begin(), _byLeft.left.end(), bx2) - _byLeft.left.begin();
+        const qreal* rights = _byLeft.right.data();
+        const qreal* bottom = _byLeft.bottom.data();
+        qreal b = NoMatch;
+        for (size_t k = 0; k < n; ++k) {
+            b = std::max(b, rights[k] > bx1 ? bottom[k] : NoMatch);
+        }
+        if (b != NoMatch) {
+            dist = qMax(dist, b - r2.top());
+        }
+    }
+    return dist;
+}
+
 #ifndef NDEBUG
 //---------------------------------------------------------
 //   dump
@@ -23,6 +23,8 @@
 #ifndef __SHAPE_H__
 #define __SHAPE_H__
 
+#include <vector>
+
 #include <QPainter>
 
 namespace Ms {
@@ -83,6 +85,7 @@ public:
     void translateX(qreal);
     void translateY(qreal);
     Shape translated(const QPointF&) const;
+    void setTranslated(const Shape&, const QPointF&);
 
     qreal minHorizontalDistance(const Shape&) const;
     qreal minVerticalDistance(const Shape&) const;
@@ -107,6 +110,45 @@ public:
 #endif
 };
 
+//---------------------------------------------------------
+//   ShapeIndex
+//    read only form of a shape for repeated distance
+//    queries against other shapes
+//    The rectangles are kept in separate coordinate arrays
+//    sorted by top (for horizontal queries) and by left
+//    (for vertical queries), so a query only looks at the
+//    rectangles which can overlap and the inner loops
+//    are branch free. Results are exactly those of the
+//    Shape methods.
+//    Building the index sorts the rectangles, it only pays
+//    off if one shape is queried against several others.
+//---------------------------------------------------------
+
+class ShapeIndex
+{
+    struct Rects {
+        std::vector<qreal> top, bottom, left, right;
+
+        void add(const QRectF&);
+        size_t size() const { return top.size(); }
+    };
+
+    Rects _byTop;               // horizontal: rects with width and height, sorted by top
+    Rects _flat;                // horizontal: rects with width but no height, sorted by top
+    Rects _byLeft;              // vertical: rects with height, sorted by left
+    qreal _maxRight;            // of all rects
+    qreal _zeroWidthRight;      // of rects without width
+
+public:
+    // shapes with fewer rectangles are compared directly
+    static constexpr size_t MinSize = 12;
+
+    ShapeIndex(const Shape&);
+
+    qreal minHorizontalDistance(const Shape&) const;
+    qreal minVerticalDistance(const Shape&) const;
+};
+
 //---------------------------------------------------------
 //   intersects
 //---------------------------------------------------------
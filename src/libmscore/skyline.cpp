@@ -21,6 +21,9 @@
  */
 
 #include "skyline.h"
+
+#include <cmath>
+
 #include "segment.h"
 
 namespace Ms {
@@ -349,4 +352,114 @@ qreal SkylineLine::max() const
     }
     return val;
 }
+
+//---------------------------------------------------------
+//   HorizontalSkyline
+//---------------------------------------------------------
+
+HorizontalSkyline::HorizontalSkyline(qreal bandHeight)
+    : _bandHeight(bandHeight > 0.0 ? bandHeight : 1.0)
+{
+    clear();
+}
+
+//---------------------------------------------------------
+//   band
+//    values outside of the covered range go to the first
+//    or last band
+//---------------------------------------------------------
+
+int HorizontalSkyline::band(qreal y) const
+{
+    qreal b = std::floor(y / _bandHeight) + Bands / 2;
+    if (!(b > 0.0)) {           // also NaN
+        return 0;
+    }
+    if (b >= Bands - 1) {
+        return Bands - 1;
+    }
+    return int(b);
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void HorizontalSkyline::clear()
+{
+    if (!_right.empty()) {
+        for (int i = _lo; i <= _hi; ++i) {
+            _right[i] = MinRight;
+        }
+    }
+    _maxRight       = MinRight;
+    _zeroWidthRight = MinRight;
+    _lo             = Bands;
+    _hi             = -1;
+}
+
+//---------------------------------------------------------
+//   reset
+//    clear and change the band height, the bands are kept
+//---------------------------------------------------------
+
+void HorizontalSkyline::reset(qreal bandHeight)
+{
+    clear();
+    _bandHeight = bandHeight > 0.0 ? bandHeight : 1.0;
+}
+
+//---------------------------------------------------------
+//   add
+//    add shape s moved by x
+//---------------------------------------------------------
+
+void HorizontalSkyline::add(const Shape& s, qreal x)
+{
+    for (const QRectF& r : s) {
+        const qreal right = r.right() + x;
+        _maxRight = std::max(_maxRight, right);
+        if (r.width() == 0.0) {
+            // collides with everything, see Shape::minHorizontalDistance()
+            _zeroWidthRight = std::max(_zeroWidthRight, right);
+            continue;
+        }
+        if (_right.empty()) {
+            _right.assign(Bands, MinRight);
+        }
+        const int b1 = band(r.top());
+        const int b2 = band(r.bottom());
+        for (int i = b1; i <= b2; ++i) {
+            _right[i] = std::max(_right[i], right);
+        }
+        _lo = std::min(_lo, b1);
+        _hi = std::max(_hi, b2);
+    }
+}
+
+//---------------------------------------------------------
+//   minDistance
+//    s is located right of the skyline
+//---------------------------------------------------------
+
+qreal HorizontalSkyline::minDistance(const Shape& s) const
+{
+    qreal dist = MinRight;
+    for (const QRectF& r : s) {
+        qreal right = _zeroWidthRight;
+        if (r.width() == 0.0) {
+            right = _maxRight;
+        } else if (_lo <= _hi) {
+            const int b1 = std::max(band(r.top()), _lo);
+            const int b2 = std::min(band(r.bottom()), _hi);
+            for (int i = b1; i <= b2; ++i) {
+                right = std::max(right, _right[i]);
+            }
+        }
+        if (right != MinRight) {
+            dist = std::max(dist, right - r.left());
+        }
+    }
+    return dist;
+}
 } // namespace Ms
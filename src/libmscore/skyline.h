@@ -112,6 +112,41 @@ public:
     void paint(QPainter&) const;
     void dump(const char*, bool north = false) const;
 };
+
+//---------------------------------------------------------
+//   HorizontalSkyline
+//    right edge of a set of shapes as a step function of y,
+//    for checking a shape placed right of them
+//    The y axis is divided into bands of fixed height;
+//    every band keeps the rightmost edge of the rectangles
+//    touching it. minDistance() is an upper bound of
+//    Shape::minHorizontalDistance() to the union of all
+//    added shapes.
+//---------------------------------------------------------
+
+class HorizontalSkyline
+{
+    static constexpr int Bands = 256;       // centered on y == 0
+
+    qreal _bandHeight;
+    std::vector<qreal> _right;              // per band, empty until first add
+    qreal _maxRight;                        // of all rectangles
+    qreal _zeroWidthRight;                  // of rectangles without width
+    int _lo, _hi;                           // bands used
+
+    int band(qreal y) const;
+
+public:
+    HorizontalSkyline(qreal bandHeight);
+
+    void add(const Shape& s, qreal x);
+    void clear();
+    void reset(qreal bandHeight);
+    bool empty() const { return _lo > _hi && _zeroWidthRight == MinRight; }
+    qreal minDistance(const Shape& s) const;
+
+    static constexpr qreal MinRight = -1000000.0;
+};
 } // namespace Ms
 
 #endif
@@ -415,45 +415,67 @@ void SlurSegment::layoutSegment(const QPointF& p1, const QPointF& p2)
         bool intersection = false;
         qreal gdist = 0.0;
         qreal minDistance = score()->styleS(Sid::SlurMinDistance).val() * spatium();
-        for (int tries = 1; true; ++tries) {
-            for (Segment* s = fs; s && s != ls; s = s->next1()) {
-                if (!s->enabled()) {
-                    continue;
-                }
-                // skip start and end segments on assumption start and end points were placed well already
-                // this avoids overcorrection on collision with own ledger lines and accidentals
-                // it also avoids issues where slur appears to be attached to a note in a different voice
-                if (s == ss || s == es) {
-                    continue;
-                }
-                // allow slurs to cross barlines
-                if (s->segmentType() & SegmentType::BarLineType) {
-                    continue;
-                }
-                qreal x1 = s->x() + s->measure()->x();
-                qreal x2 = x1 + s->width();
-                if (pp1.x() > x2) {
-                    continue;
+        const SegmentShapeIndex& index = system()->segmentShapes();
+        Shape segShape;           // reused for all segments
+
+        auto checkSegment = [&](Segment* s) {
+            segShape.setTranslated(s->staffShape(staffIdx()), s->pos() + s->measure()->pos());
+            if (!intersection) {
+                intersection = segShape.intersects(_shape);
+            }
+            if (up) {
+                qreal dist = _shape.minVerticalDistance(segShape);
+                if (dist > 0.0) {
+                    gdist = qMax(gdist, dist);
                 }
-                if (pp2.x() < x1) {
-                    break;
+            } else {
+                qreal dist = segShape.minVerticalDistance(_shape);
+                if (dist > 0.0) {
+                    gdist = qMax(gdist, dist);
                 }
-                const Shape& segShape = s->staffShape(staffIdx()).translated(s->pos() + s->measure()->pos());
-                if (!intersection) {
-                    intersection = segShape.intersects(_shape);
+            }
+        };
+
+        for (int tries = 1; true; ++tries) {
+            if (index.valid()) {
+                // only look at the segments which may overlap
+                for (auto i = index.find(pp1.x()); i != index.end(); ++i) {
+                    // skip start and end segments, see below
+                    if (i->segment == ss || i->segment == es) {
+                        continue;
+                    }
+                    if (pp1.x() > i->x2) {
+                        continue;
+                    }
+                    if (pp2.x() < i->x1) {
+                        break;
+                    }
+                    checkSegment(i->segment);
                 }
-                if (up) {
-                    //QPointF pt = QPointF(s->x() + s->measure()->x(), s->staffShape(staffIdx()).top() + s->y() + s->measure()->y());
-                    qreal dist = _shape.minVerticalDistance(segShape);
-                    if (dist > 0.0) {
-                        gdist = qMax(gdist, dist);
+            } else {
+                for (Segment* s = fs; s && s != ls; s = s->next1()) {
+                    if (!s->enabled()) {
+                        continue;
                     }
-                } else {
-                    //QPointF pt = QPointF(s->x() + s->measure()->x(), s->staffShape(staffIdx()).bottom() + s->y() + s->measure()->y());
-                    qreal dist = segShape.minVerticalDistance(_shape);
-                    if (dist > 0.0) {
-                        gdist = qMax(gdist, dist);
+                    // skip start and end segments on assumption start and end points were placed well already
+                    // this avoids overcorrection on collision with own ledger lines and accidentals
+                    // it also avoids issues where slur appears to be attached to a note in a different voice
+                    if (s == ss || s == es) {
+                        continue;
+                    }
+                    // allow slurs to cross barlines
+                    if (s->segmentType() & SegmentType::BarLineType) {
+                        continue;
+                    }
+                    qreal x1 = s->x() + s->measure()->x();
+                    qreal x2 = x1 + s->width();
+                    if (pp1.x() > x2) {
+                        continue;
+                    }
+                    if (pp2.x() < x1) {
+                        break;
                     }
+                    checkSegment(s);
                 }
             }
             if (!intersection || gdist <= slurMaxMove || tries >= 2) {
@@ -789,38 +789,54 @@ void Staff::read(XmlReader& e)
 
 bool Staff::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
-    if (tag == "StaffType") {
+    switch (e.tag()) {
+    case XmlTag::STAFF_TYPE: {
         StaffType st;
         st.read(e);
         setStaffType(Fraction(0, 1), st);
-    } else if (tag == "defaultClef") {           // sets both default transposing and concert clef
+    }
+    break;
+    case XmlTag::DEFAULT_CLEF: {         // sets both default transposing and concert clef
         QString val(e.readElementText());
         ClefType ct = Clef::clefType(val);
         setDefaultClefType(ClefTypeList(ct, ct));
-    } else if (tag == "defaultConcertClef") {
+    }
+    break;
+    case XmlTag::DEFAULT_CONCERT_CLEF: {
         QString val(e.readElementText());
         setDefaultClefType(ClefTypeList(Clef::clefType(val), defaultClefType()._transposingClef));
-    } else if (tag == "defaultTransposingClef") {
+    }
+    break;
+    case XmlTag::DEFAULT_TRANSPOSING_CLEF: {
         QString val(e.readElementText());
         setDefaultClefType(ClefTypeList(defaultClefType()._concertClef, Clef::clefType(val)));
-    } else if (tag == "small") {                // obsolete
+    }
+    break;
+    case XmlTag::SMALL:                  // obsolete
         staffType(Fraction(0, 1))->setSmall(e.readInt());
-    } else if (tag == "invisible") {
+        break;
+    case XmlTag::INVISIBLE:
         staffType(Fraction(0, 1))->setInvisible(e.readInt());              // same as: setInvisible(Fraction(0,1)), e.readInt())
-    } else if (tag == "hideWhenEmpty") {
+        break;
+    case XmlTag::HIDE_WHEN_EMPTY:
         setHideWhenEmpty(HideMode(e.readInt()));
-    } else if (tag == "cutaway") {
+        break;
+    case XmlTag::CUTAWAY:
         setCutaway(e.readInt());
-    } else if (tag == "showIfSystemEmpty") {
+        break;
+    case XmlTag::SHOW_IF_SYSTEM_EMPTY:
         setShowIfEmpty(e.readInt());
-    } else if (tag == "hideSystemBarLine") {
+        break;
+    case XmlTag::HIDE_SYSTEM_BAR_LINE:
         _hideSystemBarLine = e.readInt();
-    } else if (tag == "mergeMatchingRests") {
+        break;
+    case XmlTag::MERGE_MATCHING_RESTS:
         _mergeMatchingRests = e.readInt();
-    } else if (tag == "keylist") {
+        break;
+    case XmlTag::KEYLIST:
         _keys.read(e, score());
-    } else if (tag == "bracket") {
+        break;
+    case XmlTag::BRACKET: {
         int col = e.intAttribute("col", -1);
         if (col == -1) {
             col = _brackets.size();
@@ -828,18 +844,25 @@ bool Staff::readProperties(XmlReader& e)
         setBracketType(col, BracketType(e.intAttribute("type", -1)));
         setBracketSpan(col, e.intAttribute("span", 0));
         e.readNext();
-    } else if (tag == "barLineSpan") {
+    }
+    break;
+    case XmlTag::BAR_LINE_SPAN:
         _barLineSpan = e.readInt();
-    } else if (tag == "barLineSpanFrom") {
+        break;
+    case XmlTag::BAR_LINE_SPAN_FROM:
         _barLineFrom = e.readInt();
-    } else if (tag == "barLineSpanTo") {
+        break;
+    case XmlTag::BAR_LINE_SPAN_TO:
         _barLineTo = e.readInt();
-    } else if (tag == "distOffset") {
+        break;
+    case XmlTag::DIST_OFFSET:
         _userDist = e.readDouble() * score()->spatium();
-    } else if (tag == "mag") {
+        break;
+    case XmlTag::MAG:
         /*_userMag =*/
         e.readDouble(0.1, 10.0);
-    } else if (tag == "linkedTo") {
+        break;
+    case XmlTag::LINKED_TO: {
         int v = e.readInt() - 1;
         Staff* st = masterScore()->staff(v);
         if (_links) {
@@ -859,21 +882,30 @@ bool Staff::readProperties(XmlReader& e)
             // a staff which is going after the current one.
             qDebug("staff %d not found in parent", v);
         }
-    } else if (tag == "color") {
+    }
+    break;
+    case XmlTag::COLOR:
         staffType(Fraction(0, 1))->setColor(e.readColor());
-    } else if (tag == "transposeDiatonic") {
+        break;
+    case XmlTag::TRANSPOSE_DIATONIC:
         e.setTransposeDiatonic(e.readInt());
-    } else if (tag == "transposeChromatic") {
+        break;
+    case XmlTag::TRANSPOSE_CHROMATIC:
         e.setTransposeChromatic(e.readInt());
-    } else if (tag == "playbackVoice1") {
+        break;
+    case XmlTag::PLAYBACK_VOICE1:
         setPlaybackVoice(0, e.readInt());
-    } else if (tag == "playbackVoice2") {
+        break;
+    case XmlTag::PLAYBACK_VOICE2:
         setPlaybackVoice(1, e.readInt());
-    } else if (tag == "playbackVoice3") {
+        break;
+    case XmlTag::PLAYBACK_VOICE3:
         setPlaybackVoice(2, e.readInt());
-    } else if (tag == "playbackVoice4") {
+        break;
+    case XmlTag::PLAYBACK_VOICE4:
         setPlaybackVoice(3, e.readInt());
-    } else {
+        break;
+    default:
         return false;
     }
     return true;
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+
 #include <QDebug>
 
 #include "mscore.h"
@@ -2748,6 +2750,19 @@ MStyle::MStyle()
     for (const StyleType& t : styleTypes) {
         _values[t.idx()] = t.defaultValue();
     }
+    _epoch = newEpoch();
+}
+
+//---------------------------------------------------------
+//   newEpoch
+//    epochs identify the style values; copies of a style share
+//    the epoch until one of them is changed
+//---------------------------------------------------------
+
+uint64_t MStyle::newEpoch()
+{
+    static std::atomic<uint64_t> epochs { 0 };
+    return epochs.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 //---------------------------------------------------------
@@ -2756,6 +2771,7 @@ MStyle::MStyle()
 
 void MStyle::precomputeValues()
 {
+    _epoch = newEpoch();
     qreal _spatium = value(Sid::spatium).toDouble();
     for (const StyleType& t : styleTypes) {
         if (!strcmp(t.valueType(), "Ms::Spatium")) {
@@ -2805,10 +2821,7 @@ void MStyle::checkChordList()
         qreal mmag = value(Sid::chordModifierMag).toDouble();
         qreal madjust = value(Sid::chordModifierAdjust).toDouble();
         _chordList.configureAutoAdjust(emag, eadjust, mmag, madjust);
-        if (value(Sid::chordsXmlFile).toBool()) {
-            _chordList.read("chords.xml");
-        }
-        _chordList.read(value(Sid::chordDescriptionFile).toString());
+        _chordList.readShared(value(Sid::chordDescriptionFile).toString(), value(Sid::chordsXmlFile).toBool());
     }
 }
 
@@ -2830,6 +2843,7 @@ void MStyle::set(const Sid t, const QVariant& val)
 {
     const int idx = int(t);
     _values[idx] = val;
+    _epoch = newEpoch();
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
@@ -2842,15 +2856,19 @@ void MStyle::set(const Sid t, const QVariant& val)
 
 //---------------------------------------------------------
 //   readProperties
+//    readIdx, if given, is set to the style value read
 //---------------------------------------------------------
 
-bool MStyle::readProperties(XmlReader& e)
+bool MStyle::readProperties(XmlReader& e, Sid* readIdx)
 {
     const QStringRef& tag(e.name());
 
     for (const StyleType& t : styleTypes) {
         Sid idx = t.styleIdx();
         if (t.name() == tag) {
+            if (readIdx) {
+                *readIdx = idx;
+            }
             const char* type = t.valueType();
             if (!strcmp("Ms::Spatium", type)) {
                 set(idx, Spatium(e.readElementText().toDouble()));
@@ -3024,37 +3042,131 @@ bool MStyle::load(QFile* qf, bool ign)
 
 extern void readPageFormat(MStyle* style, XmlReader& e);
 
-void MStyle::load(XmlReader& e)
+//---------------------------------------------------------
+//   isDerivedStyleTag
+//    tags whose values are computed from the current
+//    style values, see readPageFormat() and
+//    readStyleValCompat()
+//---------------------------------------------------------
+
+static bool isDerivedStyleTag(const QStringRef& tag)
+{
+    return tag == "page-layout"
+           || tag == "tempoOffset"
+           || tag.endsWith("FontBold")
+           || tag.endsWith("FontItalic")
+           || tag.endsWith("FontUnderline");
+}
+
+//---------------------------------------------------------
+//   styleTagToXml
+//    read the current element back into xml text
+//---------------------------------------------------------
+
+static QString styleTagToXml(XmlReader& e)
+{
+    const QString tag = e.name().toString();
+    QString s = QString("<%1").arg(tag);
+    for (const QXmlStreamAttribute& a : e.attributes()) {
+        s += QString(" %1=\"%2\"").arg(a.name().toString(), a.value().toString().toHtmlEscaped());
+    }
+    s += QString(">%1</%2>").arg(e.readXml(), tag);
+    return s;
+}
+
+//---------------------------------------------------------
+//   readStyleTag
+//---------------------------------------------------------
+
+void MStyle::readStyleTag(XmlReader& e, std::vector<bool>& readValues, bool& chordListTag)
+{
+    const QStringRef& tag(e.name());
+
+    if (tag == "TextStyle") {
+        //readTextStyle206(this, e);        // obsolete
+        e.readElementText();
+    } else if (tag == "ottavaHook") {             // obsolete, for 3.0dev bw. compatibility, should be removed in final release
+        qreal y = qAbs(e.readDouble());
+        set(Sid::ottavaHookAbove, y);
+        set(Sid::ottavaHookBelow, -y);
+        readValues[int(Sid::ottavaHookAbove)] = true;
+        readValues[int(Sid::ottavaHookBelow)] = true;
+    } else if (tag == "Spatium") {
+        set(Sid::spatium, e.readDouble() * DPMM);
+        readValues[int(Sid::spatium)] = true;
+    } else if (tag == "page-layout") {      // obsolete
+        readPageFormat(this, e);            // from read206.cpp
+    } else if (tag == "displayInConcertPitch") {
+        set(Sid::concertPitch, QVariant(bool(e.readInt())));
+        readValues[int(Sid::concertPitch)] = true;
+    } else if (tag == "ChordList") {
+        _chordList.unload();
+        _chordList.read(e);
+        _customChordList = true;
+        chordListTag = true;
+    } else if (tag == "lyricsDashMaxLegth") { // pre-3.6 typo
+        set(Sid::lyricsDashMaxLength, e.readDouble());
+        readValues[int(Sid::lyricsDashMaxLength)] = true;
+    } else if (tag == "dontHidStavesInFirstSystm") { // pre-3.6.3/4.0 typo
+        set(Sid::dontHideStavesInFirstSystem, e.readBool());
+        readValues[int(Sid::dontHideStavesInFirstSystem)] = true;
+    } else {
+        Sid idx = Sid::NOSTYLE;
+        if (!readProperties(e, &idx)) {
+            e.unknown();
+        } else if (idx != Sid::NOSTYLE) {
+            readValues[int(idx)] = true;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   load
+//    if resolveDefaultsVersion is set, the values not read
+//    are taken from the defaults named by a <defaultsVersion>
+//    tag, so the file needs no extra pass to find it first.
+//    From the first tag derived from the current values on
+//    (page-layout, obsolete keys) the tags are kept and
+//    replayed in order after that, on the resolved defaults.
+//---------------------------------------------------------
+
+void MStyle::load(XmlReader& e, bool resolveDefaultsVersion)
 {
     QString oldChordDescriptionFile = value(Sid::chordDescriptionFile).toString();
     bool chordListTag = false;
+    std::vector<bool> readValues(int(Sid::STYLES), false);
+    QString deferredTags;
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
+        const bool defer = resolveDefaultsVersion && tag != "defaultsVersion" && tag != "ChordList"
+                           && (!deferredTags.isEmpty() || isDerivedStyleTag(tag));
+        if (defer) {
+            deferredTags += styleTagToXml(e);
+        } else {
+            readStyleTag(e, readValues, chordListTag);
+        }
+    }
 
-        if (tag == "TextStyle") {
-            //readTextStyle206(this, e);        // obsolete
-            e.readElementText();
-        } else if (tag == "ottavaHook") {             // obsolete, for 3.0dev bw. compatibility, should be removed in final release
-            qreal y = qAbs(e.readDouble());
-            set(Sid::ottavaHookAbove, y);
-            set(Sid::ottavaHookBelow, -y);
-        } else if (tag == "Spatium") {
-            set(Sid::spatium, e.readDouble() * DPMM);
-        } else if (tag == "page-layout") {      // obsolete
-            readPageFormat(this, e);            // from read206.cpp
-        } else if (tag == "displayInConcertPitch") {
-            set(Sid::concertPitch, QVariant(bool(e.readInt())));
-        } else if (tag == "ChordList") {
-            _chordList.unload();
-            _chordList.read(e);
-            _customChordList = true;
-            chordListTag = true;
-        } else if (tag == "lyricsDashMaxLegth") { // pre-3.6 typo
-            set(Sid::lyricsDashMaxLength, e.readDouble());
-        } else if (tag == "dontHidStavesInFirstSystm") { // pre-3.6.3/4.0 typo
-            set(Sid::dontHideStavesInFirstSystem, e.readBool());
-        } else if (!readProperties(e)) {
-            e.unknown();
+    if (resolveDefaultsVersion && readValues[int(Sid::defaultsVersion)]) {
+        const int defaultsVersion = value(Sid::defaultsVersion).toInt();
+        const MStyle* defaults = resolveStyleDefaults(defaultsVersion);
+        if (defaults != resolveStyleDefaults(_defaultStyleVersion)) {
+            for (const StyleType& t : styleTypes) {
+                if (!readValues[t.idx()]) {
+                    _values[t.idx()] = defaults->value(t.styleIdx());
+                }
+            }
+            precomputeValues();
+            oldChordDescriptionFile = defaults->value(Sid::chordDescriptionFile).toString();
+        }
+        _defaultStyleVersion = defaultsVersion;
+    }
+
+    if (!deferredTags.isEmpty()) {
+        XmlReader de(QString("<Style>%1</Style>").arg(deferredTags));
+        de.readNextStartElement();
+        while (de.readNextStartElement()) {
+            readStyleTag(de, readValues, chordListTag);
         }
     }
 
@@ -3094,6 +3206,7 @@ void MStyle::applyNewDefaults(const MStyle& other, const int defaultsVersion)
             _values.at(st.idx()) = other.value(st.styleIdx());
         }
     }
+    _epoch = newEpoch();
 }
 
 //---------------------------------------------------------
@@ -1480,6 +1480,11 @@ class MStyle
     ChordList _chordList;
     bool _customChordList;          // if true, chordlist will be saved as part of score
     int _defaultStyleVersion = -1;
+    uint64_t _epoch;                // renewed on every change of the values
+
+    static uint64_t newEpoch();
+
+    void readStyleTag(XmlReader& e, std::vector<bool>& readValues, bool& chordListTag);
 
 public:
     MStyle();
@@ -1488,6 +1493,7 @@ public:
     const QVariant& value(Sid idx) const;
     qreal pvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
     void set(Sid idx, const QVariant& v);
+    uint64_t epoch() const { return _epoch; }
 
     bool isDefault(Sid idx) const;
     void setDefaultStyleVersion(const int defaultsVersion);
@@ -1500,10 +1506,10 @@ public:
     void checkChordList();
 
     bool load(QFile* qf, bool ign = false);
-    void load(XmlReader& e);
+    void load(XmlReader& e, bool resolveDefaultsVersion = false);
     void applyNewDefaults(const MStyle& other, const int defaultsVersion);
     void save(XmlWriter& xml, bool optimize);
-    bool readProperties(XmlReader&);
+    bool readProperties(XmlReader&, Sid* readIdx = nullptr);
     bool readStyleValCompat(XmlReader&);
     bool readTextStyleValCompat(XmlReader&);
 
@@ -26,7 +26,6 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QCache>
 
 #include "style.h"
 #include "sym.h"
@@ -34,6 +33,7 @@
 #include "score.h"
 #include "xml.h"
 #include "mscore.h"
+#include "fontmetricscache.h"
 
 #include FT_GLYPH_H
 #include FT_IMAGE_H
@@ -136,6 +136,139 @@ bool GlyphKey::operator==(const GlyphKey& k) const
            && (magX == k.magX) && (magY == k.magY) && (worldScale == k.worldScale) && (color == k.color);
 }
 
+//---------------------------------------------------------
+//   GlyphCache
+//---------------------------------------------------------
+
+GlyphCache* GlyphCache::instance()
+{
+    static GlyphCache* cache = new GlyphCache;
+    return cache;
+}
+
+//---------------------------------------------------------
+//   find
+//---------------------------------------------------------
+
+bool GlyphCache::find(const GlyphKey& key, GlyphPixmap& glyph)
+{
+    QMutexLocker locker(&_mutex);
+    auto i = _entries.find(key);
+    if (i == _entries.end()) {
+        ++_misses;
+        return false;
+    }
+    ++_hits;
+    _lru.splice(_lru.begin(), _lru, i->lru);
+    glyph = i->glyph;
+    return true;
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void GlyphCache::insert(const GlyphKey& key, const GlyphPixmap& glyph)
+{
+    QMutexLocker locker(&_mutex);
+    if (_entries.contains(key)) {           // inserted by another thread
+        return;
+    }
+    Entry e;
+    e.glyph = glyph;
+    e.bytes = size_t(glyph.image.bytesPerLine()) * glyph.image.height();
+    _lru.push_front(key);
+    e.lru = _lru.begin();
+    _entries.insert(key, e);
+    _bytes += e.bytes;
+    evict();
+}
+
+//---------------------------------------------------------
+//   evict
+//    drop least recently used glyphs until the cache
+//    fits into the memory budget
+//---------------------------------------------------------
+
+void GlyphCache::evict()
+{
+    while (_bytes > _budget && _lru.size() > 1) {
+        auto i = _entries.find(_lru.back());
+        _bytes -= i->bytes;
+        _entries.erase(i);
+        _lru.pop_back();
+        ++_evictions;
+    }
+}
+
+//---------------------------------------------------------
+//   removeFace
+//---------------------------------------------------------
+
+void GlyphCache::removeFace(FT_Face face)
+{
+    QMutexLocker locker(&_mutex);
+    for (auto i = _lru.begin(); i != _lru.end();) {
+        if (i->face == face) {
+            auto e = _entries.find(*i);
+            _bytes -= e->bytes;
+            _entries.erase(e);
+            i = _lru.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void GlyphCache::clear()
+{
+    QMutexLocker locker(&_mutex);
+    _entries.clear();
+    _lru.clear();
+    _bytes = 0;
+}
+
+//---------------------------------------------------------
+//   memoryBudget
+//---------------------------------------------------------
+
+size_t GlyphCache::memoryBudget() const
+{
+    QMutexLocker locker(&_mutex);
+    return _budget;
+}
+
+//---------------------------------------------------------
+//   setMemoryBudget
+//---------------------------------------------------------
+
+void GlyphCache::setMemoryBudget(size_t bytes)
+{
+    QMutexLocker locker(&_mutex);
+    _budget = bytes;
+    evict();
+}
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+GlyphCache::Statistics GlyphCache::statistics() const
+{
+    QMutexLocker locker(&_mutex);
+    Statistics s;
+    s.hits      = _hits;
+    s.misses    = _misses;
+    s.evictions = _evictions;
+    s.entries   = _entries.size();
+    s.bytes     = _bytes;
+    return s;
+}
+
 Sym ScoreFont::sym(SymId id) const
 {
     int index = static_cast<int>(id);
@@ -195,6 +328,7 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
                 qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
                 return;
             }
+            FontMetricsCache::clear();
             font = new QFont;
             font->setWeight(QFont::Normal);
             font->setItalic(false);
@@ -223,9 +357,9 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
     int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
     GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-    GlyphPixmap* pm = cache->object(gk);
+    GlyphPixmap pm;
 
-    if (!pm) {
+    if (!GlyphCache::instance()->find(gk, pm)) {
         FT_Matrix matrix {
             scale16X, 0,
             0,       scale16Y
@@ -259,16 +393,15 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
                 *dst++ = color.rgba();
             }
         }
-        pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
-        pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
-        }
+        img.setDevicePixelRatio(worldScale);
+        pm.image = img;
+        pm.offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
+        GlyphCache::instance()->insert(gk, pm);
         FT_Done_Glyph(glyph);
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
+    QPixmap pixmap = QPixmap::fromImage(pm.image, Qt::NoFormatConversion);
+    pixmap.setDevicePixelRatio(worldScale);
+    painter->drawPixmap(pos + pm.offset, pixmap);
 }
 
 void ScoreFont::draw(SymId id, mu::draw::Painter* painter, qreal mag, const QPointF& pos, int n) const
@@ -429,8 +562,6 @@ void ScoreFont::load()
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
-
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
 
@@ -895,11 +1026,12 @@ ScoreFont::ScoreFont(const ScoreFont& f)
     _filename = f._filename;
 
     // fontImage;
-    cache = 0;
 }
 
 ScoreFont::~ScoreFont()
 {
-    delete cache;
+    if (face) {
+        GlyphCache::instance()->removeFace(face);
+    }
 }
 }
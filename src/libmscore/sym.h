@@ -23,7 +23,10 @@
 #ifndef __SYM_H__
 #define __SYM_H__
 
+#include <list>
 #include <QApplication>
+#include <QImage>
+#include <QMutex>
 
 #include "config.h"
 #include "style.h"
@@ -137,15 +140,73 @@ public:
 //---------------------------------------------------------
 
 struct GlyphPixmap {
-    QPixmap pm;
+    QImage image;           // QPixmap may only be used in the GUI thread
     QPointF offset;
 };
 
 inline uint qHash(const GlyphKey& k)
 {
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+    uint h = qHash(quintptr(k.face));
+    h = h * 31 + uint(k.id);
+    h = h * 31 + qHash(k.magX);
+    h = h * 31 + qHash(k.magY);
+    h = h * 31 + qHash(k.worldScale);
+    return h * 31 + k.color.rgba();
 }
 
+//---------------------------------------------------------
+//   GlyphCache
+//    process wide cache of rasterized glyphs, shared by
+//    all ScoreFont's, thread safe
+//    Least recently used glyphs are dropped when the
+//    memory budget is exceeded.
+//    The instance is never destroyed: ScoreFont's in
+//    static storage remove their glyphs on exit.
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+class GlyphCache
+{
+public:
+    struct Statistics {
+        quint64 hits      { 0 };
+        quint64 misses    { 0 };
+        quint64 evictions { 0 };
+        int entries       { 0 };
+        size_t bytes      { 0 };
+    };
+
+    static GlyphCache* instance();
+
+    bool find(const GlyphKey&, GlyphPixmap& glyph);
+    void insert(const GlyphKey&, const GlyphPixmap& glyph);
+    void removeFace(FT_Face face);
+    void clear();
+
+    size_t memoryBudget() const;
+    void setMemoryBudget(size_t bytes);
+
+    Statistics statistics() const;
+
+private:
+    struct Entry {
+        GlyphPixmap glyph;
+        size_t bytes;
+        std::list<GlyphKey>::iterator lru;
+    };
+
+    void evict();
+
+    mutable QMutex _mutex;
+    QHash<GlyphKey, Entry> _entries;
+    std::list<GlyphKey> _lru;               // most recently used first
+    size_t _bytes  { 0 };
+    size_t _budget { 64 * 1024 * 1024 };
+    quint64 _hits      { 0 };
+    quint64 _misses    { 0 };
+    quint64 _evictions { 0 };
+};
+
 //---------------------------------------------------------
 //   ScoreFont
 ///   \cond PLUGIN_API \private \endcond
@@ -160,7 +221,6 @@ class ScoreFont
     QString _fontPath;
     QString _filename;
     QByteArray fontImage;
-    QCache<GlyphKey, GlyphPixmap>* cache { 0 };
     std::list<std::pair<Sid, QVariant> > _engravingDefaults;
     double _textEnclosureThickness = 0;
     mutable QFont* font { 0 };
@@ -26,6 +26,10 @@
 */
 
 #include "system.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "measure.h"
 #include "segment.h"
 #include "score.h"
@@ -95,6 +99,55 @@ void SysStaff::restoreLayout()
     bbox().setHeight(_height);
 }
 
+//---------------------------------------------------------
+//   build
+//    same segments as walking from the first segment of
+//    the system up to the last one with next1()
+//---------------------------------------------------------
+
+void SegmentShapeIndex::build(const System* system)
+{
+    clear();
+    Measure* fm = system->firstMeasure();
+    Measure* lm = system->lastMeasure();
+    if (!fm || !lm) {
+        return;
+    }
+    Segment* ls = lm->last();
+    qreal maxX2 = -std::numeric_limits<qreal>::max();
+    for (Segment* s = fm->first(); s && s != ls; s = s->next1()) {
+        if (!s->enabled() || (s->segmentType() & SegmentType::BarLineType)) {
+            continue;
+        }
+        const qreal x1 = s->x() + s->measure()->x();
+        const qreal x2 = x1 + s->width();
+        maxX2 = std::max(maxX2, x2);
+        _entries.push_back({ s, x1, x2, maxX2 });
+    }
+    _valid = true;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SegmentShapeIndex::clear()
+{
+    _entries.clear();
+    _valid = false;
+}
+
+//---------------------------------------------------------
+//   find
+//    first entry which may reach x; all entries before
+//    it end left of x
+//---------------------------------------------------------
+
+SegmentShapeIndex::const_iterator SegmentShapeIndex::find(qreal x) const
+{
+    return std::partition_point(_entries.begin(), _entries.end(), [x](const Entry& e) { return e.maxX2 < x; });
+}
+
 //---------------------------------------------------------
 //   System
 //---------------------------------------------------------
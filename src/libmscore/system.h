@@ -91,6 +91,38 @@ public:
     ~SysStaff();
 };
 
+//---------------------------------------------------------
+//   SegmentShapeIndex
+//    x ranges of the enabled segments of a system (barlines
+//    excluded) in system coordinates, in segment order
+//    Used by spanner segments to find the segments they
+//    may collide with. Only valid while the system
+//    elements are laid out.
+//---------------------------------------------------------
+
+class SegmentShapeIndex
+{
+public:
+    struct Entry {
+        Segment* segment;
+        qreal x1, x2;
+        qreal maxX2;            // of this and all previous entries
+    };
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+    void build(const System*);
+    void clear();
+    bool valid() const { return _valid; }
+
+    const_iterator find(qreal x) const;
+    const_iterator begin() const { return _entries.begin(); }
+    const_iterator end() const { return _entries.end(); }
+
+private:
+    std::vector<Entry> _entries;
+    bool _valid { false };
+};
+
 //---------------------------------------------------------
 //   System
 ///    One row of measures for all instruments;
@@ -111,6 +143,7 @@ class System final : public Element
     mutable bool fixedDownDistance { false };
     qreal _distance                { 0.0 };     /// temp. variable used during layout
     qreal _systemHeight            { 0.0 };
+    SegmentShapeIndex _segmentShapes;
 
     int firstVisibleSysStaff() const;
     int lastVisibleSysStaff() const;
@@ -160,6 +193,8 @@ public:
     QRectF bboxStaff(int staff) const { return _staves[staff]->bbox(); }
     QList<SysStaff*>* staves() { return &_staves; }
     const QList<SysStaff*>* staves() const { return &_staves; }
+    const SegmentShapeIndex& segmentShapes() const { return _segmentShapes; }
+    SegmentShapeIndex& segmentShapes() { return _segmentShapes; }
     qreal staffYpage(int staffIdx) const;
     qreal staffCanvasYpage(int staffIdx) const;
     SysStaff* staff(int staffIdx) const;
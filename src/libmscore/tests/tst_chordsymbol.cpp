@@ -73,6 +73,9 @@ private slots:
     void testRealizeTriplet();
     void testRealizeDuration();
     void testRealizeJazz();
+    void testParseCache();
+    void testSharedChordList();
+    void testRenderCache();
 };
 
 //---------------------------------------------------------
@@ -422,5 +425,116 @@ void TestChordSymbol::testRealizeJazz()
     test_post(score, "realize-jazz");
 }
 
+//---------------------------------------------------------
+//   testParseCache
+//    cached parse results must equal fresh ones
+//---------------------------------------------------------
+
+void TestChordSymbol::testParseCache()
+{
+    MasterScore* score = test_pre("realize-jazz");
+    const ChordList* cl = score->style().chordList();
+    const QStringList names { "m7b5", "7(#9)", "maj9", "sus4", "13(b9#11)", "dim7", "mi(maj7)", "6/9" };
+
+    ChordCacheStatistics s0 = ChordList::cacheStatistics();
+    for (const QString& n : names) {
+        ParsedChord first;
+        bool ok1 = first.parse(n, cl, false, true);
+        ParsedChord second;
+        bool ok2 = second.parse(n, cl, false, true);
+        QCOMPARE(ok2, ok1);
+        QCOMPARE(second.handle(), first.handle());
+        QCOMPARE(second.name(), first.name());
+        QCOMPARE(second.xmlKind(), first.xmlKind());
+        QCOMPARE(second.xmlDegrees(), first.xmlDegrees());
+        QCOMPARE(second.keys(), first.keys());
+        QCOMPARE(second.renderList(cl).size(), first.renderList(cl).size());
+
+        ParsedChord syntax;            // different options, different entry
+        syntax.parse(n, cl, true, false);
+    }
+    ChordCacheStatistics s1 = ChordList::cacheStatistics();
+    QVERIFY(s1.parseHits - s0.parseHits >= uint64_t(names.size()));
+    qDebug("chord parse cache: %llu hits, %llu misses",
+           (unsigned long long)s1.parseHits, (unsigned long long)s1.parseMisses);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testSharedChordList
+//    styles with the same chord style share one chord list
+//---------------------------------------------------------
+
+void TestChordSymbol::testSharedChordList()
+{
+    ChordCacheStatistics s0 = ChordList::cacheStatistics();
+    ChordList cl1;
+    cl1.configureAutoAdjust(1.5, 0.0, 1.0, 0.0);
+    cl1.readShared("chords_jazz.xml", false);
+    ChordList cl2;
+    cl2.configureAutoAdjust(1.5, 0.0, 1.0, 0.0);
+    cl2.readShared("chords_jazz.xml", false);
+    ChordCacheStatistics s1 = ChordList::cacheStatistics();
+
+    QVERIFY(cl1.loaded());
+    QCOMPARE(s1.listHits - s0.listHits, uint64_t(1));
+    QCOMPARE(cl2.identity(), cl1.identity());
+    QCOMPARE(cl2.size(), cl1.size());
+    QVERIFY(cl2.chordTokenList.isSharedWith(cl1.chordTokenList));
+
+    // changing one list must not touch the other
+    ChordDescription cd("xyz");
+    cl2.insert(cd.id, cd);
+    QCOMPARE(cl2.size(), cl1.size() + 1);
+
+    // other settings, other list
+    ChordList cl3;
+    cl3.configureAutoAdjust(1.0, 0.0, 1.0, 0.0);
+    cl3.readShared("chords_jazz.xml", false);
+    QVERIFY(cl3.identity() != cl1.identity());
+    QCOMPARE(ChordList::cacheStatistics().listHits, s1.listHits);
+}
+
+//---------------------------------------------------------
+//   testRenderCache
+//    chord symbols taken from the render cache must be
+//    laid out like freshly rendered ones
+//---------------------------------------------------------
+
+void TestChordSymbol::testRenderCache()
+{
+    MasterScore* score = test_pre("realize-jazz");
+    QList<Harmony*> harmonies;
+    for (Segment* seg = score->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        for (Element* e : seg->annotations()) {
+            if (e->isHarmony()) {
+                harmonies.append(toHarmony(e));
+            }
+        }
+    }
+    QVERIFY(!harmonies.empty());
+
+    Harmony::clearRenderCache();
+    QList<QRectF> fresh;
+    HarmonyRenderStatistics s0 = Harmony::renderStatistics();
+    for (Harmony* h : harmonies) {
+        h->render();
+        h->layout();
+        fresh.append(h->bbox());
+    }
+    HarmonyRenderStatistics s1 = Harmony::renderStatistics();
+    QVERIFY(s1.misses > s0.misses);
+
+    for (int i = 0; i < harmonies.size(); ++i) {
+        harmonies[i]->render();
+        harmonies[i]->layout();
+        QCOMPARE(harmonies[i]->bbox(), fresh[i]);
+    }
+    HarmonyRenderStatistics s2 = Harmony::renderStatistics();
+    QCOMPARE(s2.hits - s1.hits, uint64_t(harmonies.size()));
+    QCOMPARE(s2.misses, s1.misses);
+    delete score;
+}
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
@@ -20,10 +20,14 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <vector>
+
 #include "testing/qtestsuite.h"
 #include "testbase.h"
 #include "libmscore/score.h"
 #include "libmscore/element.h"
+#include "libmscore/elementpool.h"
+#include "libmscore/note.h"
 
 using namespace Ms;
 
@@ -38,6 +42,9 @@ class TestElement : public QObject, public MTest
 private slots:
     void initTestCase() { initMTest(); }
     void testIds();
+    void testPool();
+    void testPoolRelease();
+    void testArena();
 };
 
 //---------------------------------------------------------
@@ -113,6 +120,106 @@ void TestElement::testIds()
     }
 }
 
+//---------------------------------------------------------
+//   testPool
+//    freed elements are reused by the next allocation
+//    of the same size class
+//---------------------------------------------------------
+
+void TestElement::testPool()
+{
+    AllocationStatistics start = ElementPool::statistics();
+    Note* n1 = new Note(score);
+    void* p = n1;
+    delete n1;
+    Note* n2 = new Note(score);
+    QCOMPARE(static_cast<void*>(n2), p);
+    delete n2;
+
+    AllocationStatistics s = ElementPool::statistics() - start;
+    QCOMPARE(s.allocations, uint64_t(2));
+    QCOMPARE(s.deallocations, uint64_t(2));
+    QVERIFY(s.reused >= 1);
+}
+
+//---------------------------------------------------------
+//   testPoolRelease
+//    when all blocks of a size class are freed, all its
+//    chunks but the newest are given back
+//---------------------------------------------------------
+
+void TestElement::testPoolRelease()
+{
+    // no element is that small, the size class is only used here
+    const size_t size = ElementPool::Granularity;
+    const size_t n    = 3 * ElementPool::ChunkSize / size;
+
+    AllocationStatistics start = ElementPool::statistics();
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < n; ++i) {
+        blocks.push_back(ElementPool::allocate(size));
+    }
+    AllocationStatistics s = ElementPool::statistics() - start;
+    QVERIFY(s.chunks >= 3);
+    QCOMPARE(s.released, uint64_t(0));
+
+    for (void* p : blocks) {
+        ElementPool::deallocate(p, size);
+    }
+    s = ElementPool::statistics() - start;
+    QCOMPARE(s.released, s.chunks - 1);
+
+    // the kept chunk is used again
+    void* p = ElementPool::allocate(size);
+    ElementPool::deallocate(p, size);
+    s = ElementPool::statistics() - start;
+    QCOMPARE(s.released, s.chunks - 1);
+}
+
+//---------------------------------------------------------
+//   testArena
+//---------------------------------------------------------
+
+void TestElement::testArena()
+{
+    LayoutArena arena;
+    {
+        LayoutArenaScope scope(&arena);
+        QCOMPARE(LayoutArena::current(), &arena);
+        std::vector<int, ArenaAllocator<int> > v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        QCOMPARE(v[999], 999);
+        QVERIFY(arena.used() >= 1000 * sizeof(int));
+    }
+    QVERIFY(LayoutArena::current() != &arena);
+    QCOMPARE(arena.used(), size_t(0));
+
+    // a nested scope of another arena releases only its own data
+    LayoutArena inner;
+    {
+        LayoutArenaScope scope(&arena);
+        arena.allocate(100);
+        {
+            LayoutArenaScope innerScope(&inner);
+            inner.allocate(100);
+            QCOMPARE(LayoutArena::current(), &inner);
+        }
+        QCOMPARE(inner.used(), size_t(0));
+        QCOMPARE(arena.used(), size_t(100));
+    }
+
+    // memory above the high-water mark is given back on rewind
+    for (size_t i = 0; i < 2 * LayoutArena::MaxKeptSize / LayoutArena::BlockSize; ++i) {
+        arena.allocate(LayoutArena::BlockSize);
+    }
+    QVERIFY(arena.capacity() > LayoutArena::MaxKeptSize);
+    arena.rewind();
+    QVERIFY(arena.capacity() <= LayoutArena::MaxKeptSize);
+    QVERIFY(arena.capacity() > 0);
+}
+
 QTEST_MAIN(TestElement)
 
 #include "tst_element.moc"
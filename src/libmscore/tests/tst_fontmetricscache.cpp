@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <QGuiApplication>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/fontmetricscache.h"
+#include "libmscore/mscore.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestFontMetricsCache
+//---------------------------------------------------------
+
+class TestFontMetricsCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sameAsQFontMetrics();
+    void counters();
+    void fontDatabaseChanged();
+    void threads();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFontMetricsCache::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   sameAsQFontMetrics
+//---------------------------------------------------------
+
+void TestFontMetricsCache::sameAsQFontMetrics()
+{
+    QFont font("Edwin");
+    font.setPointSizeF(10.5);
+    font.setItalic(true);
+
+    for (QPaintDevice* device : { static_cast<QPaintDevice*>(MScore::paintDevice()), static_cast<QPaintDevice*>(nullptr) }) {
+        QFontMetricsF fm = device ? QFontMetricsF(font, device) : QFontMetricsF(font);
+        CachedFontMetrics cfm(font, device);
+        QCOMPARE(cfm.ascent(), fm.ascent());
+        QCOMPARE(cfm.descent(), fm.descent());
+        QCOMPARE(cfm.height(), fm.height());
+        QCOMPARE(cfm.lineSpacing(), fm.lineSpacing());
+        QCOMPARE(cfm.xHeight(), fm.xHeight());
+        for (int i = 0; i < 2; ++i) {         // miss, then hit
+            for (const char* s : { "", "Allegro", "la-", "Glo - ri - a" }) {
+                QCOMPARE(cfm.width(s), fm.width(s));
+                QCOMPARE(cfm.boundingRect(s), fm.boundingRect(s));
+                QCOMPARE(cfm.tightBoundingRect(s), fm.tightBoundingRect(s));
+            }
+        }
+        QCOMPARE(cfm.width(QChar('n')), fm.width(QChar('n')));
+    }
+}
+
+//---------------------------------------------------------
+//   counters
+//---------------------------------------------------------
+
+void TestFontMetricsCache::counters()
+{
+    FontMetricsCache::clear();
+    QFont font("FreeSerif");
+    font.setPointSizeF(12.0);
+
+    FontMetricsCache::Statistics s0 = FontMetricsCache::statistics();
+    CachedFontMetrics fm1(font, MScore::paintDevice());
+    fm1.width("Kyrie");
+    CachedFontMetrics fm2(font, MScore::paintDevice());
+    fm2.width("Kyrie");
+    fm2.width("eleison");
+    FontMetricsCache::Statistics s1 = FontMetricsCache::statistics();
+
+    QCOMPARE(s1.fontMisses - s0.fontMisses, uint64_t(1));
+    QCOMPARE(s1.fontHits - s0.fontHits, uint64_t(1));
+    QCOMPARE(s1.textMisses - s0.textMisses, uint64_t(2));
+    QCOMPARE(s1.textHits - s0.textHits, uint64_t(1));
+
+    font.setBold(true);          // style flags are part of the key
+    CachedFontMetrics fm3(font, MScore::paintDevice());
+    QCOMPARE(FontMetricsCache::statistics().fontMisses - s1.fontMisses, uint64_t(1));
+}
+
+//---------------------------------------------------------
+//   fontDatabaseChanged
+//    fonts are resolved again after the font database changed,
+//    entries in use stay valid
+//---------------------------------------------------------
+
+void TestFontMetricsCache::fontDatabaseChanged()
+{
+    QFont font("FreeSerif");
+    font.setPointSizeF(13.0);
+    CachedFontMetrics fm1(font, MScore::paintDevice());
+    const qreal width = fm1.width("Gloria");
+
+    FontMetricsCache::Statistics s0 = FontMetricsCache::statistics();
+    CachedFontMetrics fm2(font, MScore::paintDevice());
+    QCOMPARE(FontMetricsCache::statistics().fontHits - s0.fontHits, uint64_t(1));
+
+    QGuiApplication* app = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+    QVERIFY(app);
+    emit app->fontDatabaseChanged();
+
+    FontMetricsCache::Statistics s1 = FontMetricsCache::statistics();
+    CachedFontMetrics fm3(font, MScore::paintDevice());
+    QCOMPARE(FontMetricsCache::statistics().fontMisses - s1.fontMisses, uint64_t(1));
+    QCOMPARE(fm3.width("Gloria"), width);
+    QCOMPARE(fm1.width("Gloria"), width);
+}
+
+//---------------------------------------------------------
+//   threads
+//---------------------------------------------------------
+
+void TestFontMetricsCache::threads()
+{
+    QFont font("FreeSerif");
+    font.setPointSizeF(11.0);
+    const qreal expected = QFontMetricsF(font, MScore::paintDevice()).width("Sanctus");
+
+    std::vector<std::thread> threads;
+    std::vector<qreal> widths(8);
+    for (size_t i = 0; i < widths.size(); ++i) {
+        threads.emplace_back([&font, &widths, i]() {
+            for (int n = 0; n < 1000; ++n) {
+                widths[i] = CachedFontMetrics(font, MScore::paintDevice()).width("Sanctus");
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    for (qreal w : widths) {
+        QCOMPARE(w, expected);
+    }
+}
+
+QTEST_MAIN(TestFontMetricsCache)
+#include "tst_fontmetricscache.moc"
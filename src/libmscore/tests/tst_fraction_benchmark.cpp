@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/fraction.h"
+#include "libmscore/synthesizerstate.h"
+#include "framework/midi_old/event.h"
+
+static const QString CONCERTPITCH_DATA_DIR("concertpitch_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestFractionBenchmark
+//    Fraction arithmetic and the Fraction heavy paths of
+//    layout (Score::getNextMeasure) and MIDI rendering
+//    (MidiRenderer::collectMeasureEvents)
+//---------------------------------------------------------
+
+class TestFractionBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score { nullptr };
+
+private slots:
+    void initTestCase();
+    void fractionArithmetic();
+    void benchmarkTickSum();
+    void benchmarkTupletSum();
+    void benchmarkCompare();
+    void benchmarkLayout();
+    void benchmarkRenderMidi();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFractionBenchmark::initTestCase()
+{
+    initMTest();
+    score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+}
+
+//---------------------------------------------------------
+//   fractionArithmetic
+//    the fast paths must give the same representation as
+//    the general algorithm
+//---------------------------------------------------------
+
+void TestFractionBenchmark::fractionArithmetic()
+{
+    QVERIFY((Fraction(1, 4) + Fraction(1, 8)).identical(Fraction(3, 8)));
+    QVERIFY((Fraction(1, 8) + Fraction(1, 4)).identical(Fraction(3, 8)));
+    QVERIFY((Fraction(1, 4) - Fraction(1, 8)).identical(Fraction(1, 8)));
+    QVERIFY((Fraction(1, 3) + Fraction(1, 6)).identical(Fraction(3, 6)));
+    QVERIFY((Fraction(2, 4) + Fraction(2, 4)).identical(Fraction(4, 4)));
+    QVERIFY((Fraction(3, 12) * Fraction(2, 3)).identical(Fraction(1, 6)));
+    QVERIFY(Fraction(6, 8).reduced().identical(Fraction(3, 4)));
+    QVERIFY(Fraction(0, 8).reduced().identical(Fraction(0, 1)));
+    QVERIFY(Fraction(-6, 8).reduced().identical(Fraction(-3, 4)));
+
+    QVERIFY(Fraction(1, 2) == Fraction(2, 4));
+    QVERIFY(Fraction(1, 3) < Fraction(1, 2));
+    QVERIFY(Fraction(-1, 2) < Fraction(1, 4));
+    QVERIFY(Fraction(3, 8) >= Fraction(3, 8));
+
+    QCOMPARE(gcd(12, 18), int_least64_t(6));
+    QCOMPARE(gcd(-12, 18), int_least64_t(6));
+    QCOMPARE(gcd(0, 7), int_least64_t(7));
+    QCOMPARE(gcd(1920, 1), int_least64_t(1));
+}
+
+//---------------------------------------------------------
+//   benchmarkTickSum
+//    sum of durations, as done when walking segments
+//---------------------------------------------------------
+
+void TestFractionBenchmark::benchmarkTickSum()
+{
+    static const Fraction durations[] = {
+        Fraction(1, 4), Fraction(1, 8), Fraction(1, 16), Fraction(3, 8), Fraction(1, 2), Fraction(1, 32)
+    };
+    Fraction sum;
+    QBENCHMARK {
+        sum = Fraction(0, 1);
+        for (int i = 0; i < 10000; ++i) {
+            sum += durations[i % 6];
+        }
+    }
+    QVERIFY(sum > Fraction(0, 1));
+}
+
+//---------------------------------------------------------
+//   benchmarkTupletSum
+//    durations without common power of two denominator
+//---------------------------------------------------------
+
+void TestFractionBenchmark::benchmarkTupletSum()
+{
+    static const Fraction durations[] = {
+        Fraction(1, 12), Fraction(1, 8), Fraction(1, 24), Fraction(1, 5), Fraction(1, 6), Fraction(1, 16)
+    };
+    Fraction sum;
+    QBENCHMARK {
+        sum = Fraction(0, 1);
+        for (int i = 0; i < 10000; ++i) {
+            sum += durations[i % 6];
+            sum.reduce();
+        }
+    }
+    QVERIFY(sum > Fraction(0, 1));
+}
+
+//---------------------------------------------------------
+//   benchmarkCompare
+//---------------------------------------------------------
+
+void TestFractionBenchmark::benchmarkCompare()
+{
+    std::vector<Fraction> ticks;
+    for (int i = 0; i < 10000; ++i) {
+        ticks.push_back(Fraction(i * 7 % 1000, (i % 3) ? 4 : 8));
+    }
+    int less = 0;
+    QBENCHMARK {
+        less = 0;
+        for (size_t i = 1; i < ticks.size(); ++i) {
+            if (ticks[i - 1] < ticks[i]) {
+                ++less;
+            }
+        }
+    }
+    QVERIFY(less > 0);
+}
+
+//---------------------------------------------------------
+//   benchmarkLayout
+//    Score::getNextMeasure
+//---------------------------------------------------------
+
+void TestFractionBenchmark::benchmarkLayout()
+{
+    QBENCHMARK {
+        score->doLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkRenderMidi
+//    MidiRenderer::collectMeasureEvents
+//---------------------------------------------------------
+
+void TestFractionBenchmark::benchmarkRenderMidi()
+{
+    SynthesizerState synthState;
+    QBENCHMARK {
+        EventMap events;
+        score->renderMidi(&events, synthState);
+    }
+}
+
+QTEST_MAIN(TestFractionBenchmark)
+#include "tst_fraction_benchmark.moc"
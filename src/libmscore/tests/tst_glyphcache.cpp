@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/sym.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestGlyphCache
+//---------------------------------------------------------
+
+class TestGlyphCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+    size_t defaultBudget { 0 };
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void lruOrder();
+    void byteBudget();
+    void removeFace();
+};
+
+//---------------------------------------------------------
+//   helpers
+//    the faces are never dereferenced, only compared
+//---------------------------------------------------------
+
+static FT_Face fakeFace(quintptr n)
+{
+    return reinterpret_cast<FT_Face>(n);
+}
+
+static GlyphKey key(quintptr face, int id)
+{
+    return GlyphKey(fakeFace(face), SymId(id), 1.0, 1.0, 1.0, QColor(Qt::black));
+}
+
+static GlyphPixmap glyph(int size)
+{
+    GlyphPixmap g;
+    g.image = QImage(size, size, QImage::Format_ARGB32);
+    g.image.fill(Qt::black);
+    return g;
+}
+
+static bool contains(const GlyphKey& k)
+{
+    GlyphPixmap g;
+    return GlyphCache::instance()->find(k, g);
+}
+
+static size_t glyphBytes(int size)
+{
+    QImage img = glyph(size).image;
+    return size_t(img.bytesPerLine()) * img.height();
+}
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestGlyphCache::initTestCase()
+{
+    initMTest();
+    defaultBudget = GlyphCache::instance()->memoryBudget();
+}
+
+//---------------------------------------------------------
+//   cleanup
+//    the cache is shared with the other tests
+//---------------------------------------------------------
+
+void TestGlyphCache::cleanup()
+{
+    GlyphCache::instance()->clear();
+    GlyphCache::instance()->setMemoryBudget(defaultBudget);
+}
+
+//---------------------------------------------------------
+//   lruOrder
+//    a lookup makes a glyph the most recently used one,
+//    the least recently used glyph goes first
+//---------------------------------------------------------
+
+void TestGlyphCache::lruOrder()
+{
+    GlyphCache* cache = GlyphCache::instance();
+    cache->clear();
+    cache->setMemoryBudget(3 * glyphBytes(10));
+
+    cache->insert(key(1, 1), glyph(10));
+    cache->insert(key(1, 2), glyph(10));
+    cache->insert(key(1, 3), glyph(10));
+    QVERIFY(contains(key(1, 1)));           // 1 is now the most recently used
+
+    const quint64 evictions = cache->statistics().evictions;
+    cache->insert(key(1, 4), glyph(10));    // drops 2
+    QCOMPARE(cache->statistics().evictions - evictions, quint64(1));
+    QVERIFY(!contains(key(1, 2)));
+    QVERIFY(contains(key(1, 3)));
+    QVERIFY(contains(key(1, 1)));
+    QVERIFY(contains(key(1, 4)));
+
+    cache->insert(key(1, 5), glyph(10));    // drops 3, the oldest lookup
+    QVERIFY(!contains(key(1, 3)));
+    QVERIFY(contains(key(1, 1)));
+    QVERIFY(contains(key(1, 4)));
+    QVERIFY(contains(key(1, 5)));
+    QCOMPARE(cache->statistics().entries, 3);
+}
+
+//---------------------------------------------------------
+//   byteBudget
+//    the cache never holds more bytes than its budget,
+//    except for a single glyph larger than the budget
+//---------------------------------------------------------
+
+void TestGlyphCache::byteBudget()
+{
+    GlyphCache* cache = GlyphCache::instance();
+    cache->clear();
+    const size_t budget = 10 * glyphBytes(8);
+    cache->setMemoryBudget(budget);
+
+    for (int id = 0; id < 100; ++id) {
+        cache->insert(key(2, id), glyph(id % 2 ? 8 : 4));
+        QVERIFY(cache->statistics().bytes <= budget);
+    }
+    QVERIFY(contains(key(2, 99)));
+    QVERIFY(!contains(key(2, 0)));
+
+    // lowering the budget evicts right away
+    cache->setMemoryBudget(2 * glyphBytes(8));
+    QVERIFY(cache->statistics().bytes <= 2 * glyphBytes(8));
+    QVERIFY(contains(key(2, 99)));
+
+    // a glyph larger than the budget is kept on its own
+    cache->insert(key(2, 100), glyph(32));
+    GlyphCache::Statistics s = cache->statistics();
+    QCOMPARE(s.entries, 1);
+    QCOMPARE(s.bytes, glyphBytes(32));
+    QVERIFY(contains(key(2, 100)));
+}
+
+//---------------------------------------------------------
+//   removeFace
+//---------------------------------------------------------
+
+void TestGlyphCache::removeFace()
+{
+    GlyphCache* cache = GlyphCache::instance();
+    cache->clear();
+    cache->insert(key(3, 1), glyph(10));
+    cache->insert(key(4, 1), glyph(10));
+    cache->insert(key(3, 2), glyph(10));
+
+    cache->removeFace(fakeFace(3));
+    GlyphCache::Statistics s = cache->statistics();
+    QCOMPARE(s.entries, 1);
+    QCOMPARE(s.bytes, glyphBytes(10));
+    QVERIFY(contains(key(4, 1)));
+    QVERIFY(!contains(key(3, 1)));
+}
+
+QTEST_MAIN(TestGlyphCache)
+#include "tst_glyphcache.moc"
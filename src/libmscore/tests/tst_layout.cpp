@@ -0,0 +1,318 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/chord.h"
+#include "libmscore/layoutstatistics.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/part.h"
+#include "libmscore/segment.h"
+#include "libmscore/spanner.h"
+#include "libmscore/staff.h"
+#include "libmscore/system.h"
+#include "libmscore/tie.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLayout
+//    caches and bookkeeping of the layout
+//---------------------------------------------------------
+
+class TestLayout : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void staffOccupancy();
+    void minWidthCache();
+    void layoutStatistics();
+    void linearKeptWindows();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLayout::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   bruteIsEmpty
+//    the segment scan Measure::isEmpty() used before the
+//    occupancy bits were cached
+//---------------------------------------------------------
+
+static bool bruteIsEmpty(const Measure* m, int staffIdx)
+{
+    Score* score = m->score();
+    bool hasStaves = score->staff(staffIdx)->part()->staves()->size() > 1;
+    int strack = staffIdx * VOICES;
+    int etrack = strack + VOICES;
+    for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        for (int track = strack; track < etrack; ++track) {
+            Element* e = s->element(track);
+            if (e && !e->isRest()) {
+                return false;
+            }
+            if (hasStaves) {
+                if (strack >= VOICES) {
+                    e = s->element(track - VOICES);
+                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
+                        return false;
+                    }
+                }
+                if (etrack < score->nstaves() * VOICES) {
+                    e = s->element(track + VOICES);
+                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
+                        return false;
+                    }
+                }
+            }
+        }
+        for (Element* a : s->annotations()) {
+            if (!a || a->systemFlag() || !a->visible() || a->isFermata()) {
+                continue;
+            }
+            if (a->track() >= strack && a->track() < etrack) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void checkOccupancy(MasterScore* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            QCOMPARE(m->isEmpty(staffIdx), bruteIsEmpty(m, staffIdx));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   staffOccupancy
+//    cached occupancy bits must follow edits and undo
+//---------------------------------------------------------
+
+void TestLayout::staffOccupancy()
+{
+    MasterScore* score = readScore("all_elements_data/moonlight.mscx");
+    score->doLayout();
+    checkOccupancy(score);
+
+    Measure* m = score->firstMeasure()->nextMeasure();
+    QVERIFY(!m->isEmpty(0));
+
+    score->startCmd();
+    score->select(m, SelectType::RANGE, 0);
+    score->cmdDeleteSelection();
+    score->endCmd();
+    checkOccupancy(score);
+
+    score->undoRedo(true, 0);
+    QVERIFY(!m->isEmpty(0));
+    checkOccupancy(score);
+
+    score->undoRedo(false, 0);
+    checkOccupancy(score);
+
+    // hiding an annotation goes through ChangeProperty, not the segment hooks
+    Element* annotation = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s && !annotation; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* a : s->annotations()) {
+            if (!a->systemFlag() && a->visible() && !a->isFermata()) {
+                annotation = a;
+                break;
+            }
+        }
+    }
+    QVERIFY(annotation);
+
+    score->startCmd();
+    annotation->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+    checkOccupancy(score);
+
+    score->undoRedo(true, 0);
+    checkOccupancy(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   minWidthCache
+//    remembered segment spacing must equal a fresh computation
+//---------------------------------------------------------
+
+static std::vector<qreal> spacing(MasterScore* score)
+{
+    std::vector<qreal> v;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        m->computeMinWidth();
+        v.push_back(m->width());
+        for (Segment* s = m->first(); s; s = s->next()) {
+            v.push_back(s->rxpos());
+            v.push_back(s->width());
+        }
+    }
+    return v;
+}
+
+void TestLayout::minWidthCache()
+{
+    MasterScore* score = readScore("all_elements_data/moonlight.mscx");
+    score->doLayout();
+    int measures = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ++measures;
+    }
+
+    std::vector<qreal> first = spacing(score);
+
+    Measure::clearMinWidthStatistics();
+    std::vector<qreal> cached = spacing(score);
+    QCOMPARE(Measure::minWidthStatistics().hits, uint64_t(measures));
+    QCOMPARE(Measure::minWidthStatistics().misses, uint64_t(0));
+    QVERIFY(cached == first);
+
+    // a style change starts a new epoch: everything is computed again
+    score->style().set(Sid::minNoteDistance, score->styleV(Sid::minNoteDistance));
+    Measure::clearMinWidthStatistics();
+    std::vector<qreal> fresh = spacing(score);
+    QCOMPARE(Measure::minWidthStatistics().hits, uint64_t(0));
+    QCOMPARE(Measure::minWidthStatistics().misses, uint64_t(measures));
+    QVERIFY(fresh == first);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   layoutStatistics
+//    the phase timings add up to the total and a relayout
+//    of one measure does no more work than a full layout
+//---------------------------------------------------------
+
+void TestLayout::layoutStatistics()
+{
+    MasterScore* score = readScore("all_elements_data/moonlight.mscx");
+    score->doLayout();
+    int measures = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ++measures;
+    }
+
+    const LayoutStatistics full = score->layoutStatistics();
+    QVERIFY(full.measures >= uint64_t(measures));
+    QCOMPARE(full.pages, uint64_t(score->npages()));
+    QVERIFY(full.systems >= full.pages);
+    QVERIFY(full.shapes > 0);
+    double sum = 0.0;
+    for (int i = 0; i < int(LayoutStatistics::Phase::PHASES); ++i) {
+        QVERIFY(full.phaseMs[i] >= 0.0);
+        sum += full.phaseMs[i];
+    }
+    QVERIFY(qAbs(sum - full.totalMs) < 0.001);
+
+    Measure* m = score->firstMeasure()->nextMeasure();
+    score->startCmd();
+    score->setLayout(m->tick(), m->endTick(), 0, 0);
+    score->endCmd();
+    const LayoutStatistics partial = score->layoutStatistics();
+    QVERIFY(partial.measures > 0);
+    QVERIFY(partial.measures <= full.measures);
+    QVERIFY(partial.pages <= full.pages);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   linearKeptWindows
+//    ties and glissandi of windows kept in continuous view
+//    are still attached to the system after an edit
+//---------------------------------------------------------
+
+static int checkNoteSpanners(MasterScore* score)
+{
+    System* system = score->systems().front();
+    const QList<SpannerSegment*>& segments = system->spannerSegments();
+    int spanners = 0;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (int track = 0; track < score->ntracks(); ++track) {
+            ChordRest* cr = s->cr(track);
+            if (!cr || !cr->isChord()) {
+                continue;
+            }
+            for (Note* note : toChord(cr)->notes()) {
+                QVector<Spanner*> sl = note->spannerFor();
+                if (note->tieFor()) {
+                    sl.push_back(note->tieFor());
+                }
+                for (Spanner* sp : sl) {
+                    ++spanners;
+                    if (sp->spannerSegments().empty()) {
+                        return -1;
+                    }
+                    for (SpannerSegment* ss : sp->spannerSegments()) {
+                        if (ss->system() != system || !segments.contains(ss)) {
+                            return -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return spanners;
+}
+
+void TestLayout::linearKeptWindows()
+{
+    MasterScore* score = readScore("midi_data/testGlissando.mscx");
+    QVERIFY(score);
+    score->setLayoutMode(LayoutMode::LINE);
+    score->startCmd();
+    score->appendMeasures(100);
+    score->endCmd();
+    score->doLayout();
+    const int spanners = checkNoteSpanners(score);
+    QVERIFY(spanners > 0);
+
+    // relayout the end of the line only, the first windows are kept
+    Measure* m = score->lastMeasure();
+    score->startCmd();
+    score->setLayout(m->tick(), m->endTick(), 0, 0);
+    score->endCmd();
+    QCOMPARE(checkNoteSpanners(score), spanners);
+
+    delete score;
+}
+
+QTEST_MAIN(TestLayout)
+
+#include "tst_layout.moc"
@@ -23,6 +23,11 @@
 #include "testing/qtestsuite.h"
 #include "testbase.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chordrest.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/layout.h"
 
 static const QString LAYOUT_DATA_DIR("layout_data/");
 
@@ -49,6 +54,8 @@ private slots:
     void benchmark1();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void benchmarkLyrics_data();
+    void benchmarkLyrics();         // many verses on every staff
 };
 
 //---------------------------------------------------------
@@ -100,5 +107,49 @@ void TestLayoutBenchmark::benchmark4()
     }
 }
 
+//---------------------------------------------------------
+//   benchmarkLyrics
+//    layout with eight verses below and one above every
+//    chord or rest, for all vertical align ranges
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmarkLyrics_data()
+{
+    QTest::addColumn<int>("range");
+    QTest::newRow("segment") << int(VerticalAlignRange::SEGMENT);
+    QTest::newRow("measure") << int(VerticalAlignRange::MEASURE);
+    QTest::newRow("system") << int(VerticalAlignRange::SYSTEM);
+}
+
+void TestLayoutBenchmark::benchmarkLyrics()
+{
+    QFETCH(int, range);
+    MasterScore* s = readScore("all_elements_data/moonlight.mscx");
+    for (Segment* seg = s->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        for (int staffIdx = 0; staffIdx < s->nstaves(); ++staffIdx) {
+            ChordRest* cr = seg->cr(staffIdx * VOICES);
+            if (!cr) {
+                continue;
+            }
+            for (int verse = 0; verse < 9; ++verse) {
+                Lyrics* l = new Lyrics(s);
+                l->setTrack(cr->track());
+                l->setNo(verse);
+                l->setPlainText(QString("la%1").arg(verse));
+                if (verse == 8) {
+                    l->setPlacement(Placement::ABOVE);
+                }
+                cr->add(l);
+            }
+        }
+    }
+    s->style().set(Sid::autoplaceVerticalAlignRange, range);
+    s->doLayout();
+    QBENCHMARK {
+        s->doLayout();
+    }
+    delete s;
+}
+
 QTEST_MAIN(TestLayoutBenchmark)
 #include "tst_layout_benchmark.moc"
@@ -0,0 +1,400 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <thread>
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/imageStore.h"
+#include "libmscore/mscsnapshot.h"
+#include "libmscore/style.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
+
+static const QString MSCZ_DATA_DIR("concertpitch_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestMscz
+//    streamed loading of compressed scores
+//---------------------------------------------------------
+
+class TestMscz : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QByteArray _text;
+
+private slots:
+    void initTestCase();
+    void entryDevice_data();
+    void entryDevice();
+    void entryDeviceClosedEarly();
+    void lazyImage();
+    void loadCompressed();
+    void snapshotSave();
+    void editDuringSave();
+    void styleDefaultsVersion();
+    void styleDefaultsVersionCompat();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    some MB of compressible text, many inflate chunks
+//---------------------------------------------------------
+
+void TestMscz::initTestCase()
+{
+    initMTest();
+    for (int i = 0; _text.size() < 4 * 1024 * 1024; ++i) {
+        _text.append(QByteArray::number(i * 7919 % 10007)).append(i % 16 ? ' ' : '\n');
+    }
+}
+
+//---------------------------------------------------------
+//   entryDevice
+//    the device delivers the same bytes as fileData()
+//---------------------------------------------------------
+
+void TestMscz::entryDevice_data()
+{
+    QTest::addColumn<int>("policy");
+    QTest::newRow("deflated") << int(MQZipWriter::AlwaysCompress);
+    QTest::newRow("stored") << int(MQZipWriter::NeverCompress);
+}
+
+void TestMscz::entryDevice()
+{
+    QFETCH(int, policy);
+
+    QBuffer zip;
+    zip.open(QIODevice::ReadWrite);
+    {
+        MQZipWriter writer(&zip);
+        writer.setCompressionPolicy(MQZipWriter::CompressionPolicy(policy));
+        writer.addFile("text.txt", _text);
+        writer.addFile("empty.txt", QByteArray());
+        writer.close();
+    }
+    zip.seek(0);
+
+    MQZipReader reader(&zip);
+    QCOMPARE(reader.fileData("text.txt"), _text);
+    QVERIFY(!reader.fileDevice("missing.txt"));
+
+    std::unique_ptr<QIODevice> device(reader.fileDevice("text.txt"));
+    QVERIFY(device);
+    reader.close();                 // the device does not need the archive
+
+    QVERIFY(device->open(QIODevice::ReadOnly));
+    QVERIFY(device->isSequential());
+    QByteArray data;
+    char buf[1000];
+    for (;;) {
+        qint64 n = device->read(buf, sizeof(buf));
+        QVERIFY(n >= 0);
+        if (n == 0) {
+            break;
+        }
+        data.append(buf, int(n));
+    }
+    QVERIFY(device->atEnd());
+    device->close();
+    QCOMPARE(data, _text);
+
+    // a device can be read again
+    QVERIFY(device->open(QIODevice::ReadOnly));
+    QCOMPARE(device->readAll(), _text);
+    device->close();
+}
+
+//---------------------------------------------------------
+//   entryDeviceClosedEarly
+//    closing before the end stops the worker
+//---------------------------------------------------------
+
+void TestMscz::entryDeviceClosedEarly()
+{
+    QBuffer zip;
+    zip.open(QIODevice::ReadWrite);
+    {
+        MQZipWriter writer(&zip);
+        writer.addFile("text.txt", _text);
+        writer.close();
+    }
+    zip.seek(0);
+
+    MQZipReader reader(&zip);
+    std::unique_ptr<QIODevice> device(reader.fileDevice("text.txt"));
+    QVERIFY(device);
+    QVERIFY(device->open(QIODevice::ReadOnly));
+    QCOMPARE(device->read(100), _text.left(100));
+    device->close();
+    QVERIFY(!device->isOpen());
+}
+
+//---------------------------------------------------------
+//   lazyImage
+//---------------------------------------------------------
+
+void TestMscz::lazyImage()
+{
+    const QByteArray png("not really a png");
+    const QString name = QString(QCryptographicHash::hash(png, QCryptographicHash::Md4).toHex()) + ".png";
+    ImageStore store;
+    int calls = 0;
+    auto loader = [&calls, png]() { ++calls; return png; };
+
+    ImageStoreItem* item = store.addLazy("Pictures/" + name, loader);
+    QCOMPARE(calls, 0);
+    QVERIFY(item->loaded());
+    QCOMPARE(item->hashName(), name);
+    QCOMPARE(store.getImage(name), item);
+    QCOMPARE(store.addLazy("Pictures/" + name, loader), item);
+    QCOMPARE(calls, 0);
+
+    QCOMPARE(item->buffer(), png);
+    QCOMPARE(item->buffer(), png);
+    QCOMPARE(calls, 1);
+
+    // no hash name, loaded immediately
+    store.addLazy("Pictures/image.png", loader);
+    QCOMPARE(calls, 2);
+
+    // content not matching the name is dropped on first use
+    ImageStoreItem* bad = store.addLazy("Pictures/0123456789abcdef0123456789abcdef.png", loader);
+    QCOMPARE(calls, 2);
+    QVERIFY(bad->buffer().isEmpty());
+    QCOMPARE(calls, 3);
+    QVERIFY(!bad->loaded());
+}
+
+//---------------------------------------------------------
+//   loadCompressed
+//    a streamed .mscz reads the same as the .mscx
+//---------------------------------------------------------
+
+void TestMscz::loadCompressed()
+{
+    MasterScore* score = readScore(MSCZ_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "mscz-ref.mscx"));
+
+    QBuffer mscz;
+    mscz.open(QIODevice::ReadWrite);
+    QVERIFY(score->saveCompressedFile(&mscz, "mscz.mscx", false, false));
+    delete score;
+
+    mscz.seek(0);
+    score = new MasterScore(mscore->baseStyle());
+    score->setName("mscz");
+    score->fileInfo()->setFile("mscz.mscz");
+    QVERIFY(score->loadCompressedMsc(&mscz, false) == Score::FileError::FILE_NO_ERROR);
+    score->doLayout();
+    QVERIFY(saveScore(score, "mscz-streamed.mscx"));
+    delete score;
+
+    QVERIFY(compareFilesFromPaths("mscz-streamed.mscx", "mscz-ref.mscx"));
+}
+
+//---------------------------------------------------------
+//   snapshotSave
+//    a snapshot written on another thread has the same
+//    content as saveCompressedFile(); the previous file is
+//    kept as backup
+//---------------------------------------------------------
+
+void TestMscz::snapshotSave()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("snapshot.mscz");
+    const QString backupDir = dir.filePath(".backup");
+
+    MasterScore* score = readScore(MSCZ_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    QBuffer ref;
+    ref.open(QIODevice::WriteOnly);
+    QVERIFY(score->saveCompressedFile(&ref, "snapshot.mscx", false, false));
+
+    QFile old(path);
+    QVERIFY(old.open(QIODevice::WriteOnly));
+    old.write("old");
+    old.close();
+
+    MscSnapshot snapshot = score->createSnapshot("snapshot.mscx", false, false);
+    delete score;       // the snapshot does not refer to the score
+
+    bool ok = false;
+    QString error;
+    std::thread writer([&]() { ok = snapshot.saveFile(path, backupDir, &error); });
+    writer.join();
+    QVERIFY2(ok, qPrintable(error));
+
+    ref.close();
+    QVERIFY(ref.open(QIODevice::ReadOnly));
+    MQZipReader refZip(&ref);
+    MQZipReader savedZip(path);
+    QCOMPARE(savedZip.fileData("snapshot.mscx"), refZip.fileData("snapshot.mscx"));
+    QCOMPARE(savedZip.fileData("META-INF/container.xml"), refZip.fileData("META-INF/container.xml"));
+
+    QFile backup(QDir(backupDir).filePath(".snapshot.mscz,"));
+    QVERIFY(backup.open(QIODevice::ReadOnly));
+    QCOMPARE(backup.readAll(), QByteArray("old"));
+    QVERIFY(!QFile::exists(path + ".temp"));
+}
+
+//---------------------------------------------------------
+//   editDuringSave
+//    an edit made while the snapshot is written keeps the
+//    score unsaved (MasterNotation::needSave() is !saved()),
+//    undoing it returns to the saved state
+//---------------------------------------------------------
+
+void TestMscz::editDuringSave()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("edit.mscz");
+
+    MasterScore* score = readScore(MSCZ_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    score->fileInfo()->setFile(path);
+    score->setSaved(false);
+
+    MscSnapshot snapshot;
+    QVERIFY(score->createSaveSnapshot(snapshot, false));
+    const int undoState = score->undoStack()->state();
+
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::staffUpperBorder, QVariant::fromValue(Spatium(9.0)));
+    score->endCmd();
+
+    QString error;
+    QVERIFY2(snapshot.saveFile(path, QString(), &error), qPrintable(error));
+    score->setSaveFinished(QString(), undoState);
+    QVERIFY(!score->saved());
+    QVERIFY(!score->undoStack()->isClean());
+
+    score->undoRedo(true, 0);
+    QVERIFY(score->undoStack()->isClean());
+
+    // without an edit the save is complete
+    QVERIFY(score->createSaveSnapshot(snapshot, false));
+    QVERIFY2(snapshot.saveFile(path, QString(), &error), qPrintable(error));
+    score->setSaveFinished(QString(), score->undoStack()->state());
+    QVERIFY(score->saved());
+    delete score;
+}
+
+//---------------------------------------------------------
+//   styleDefaultsVersion
+//    the style values not in the file are taken from the
+//    defaults named by <defaultsVersion>, not from the
+//    defaults of the file version
+//---------------------------------------------------------
+
+void TestMscz::styleDefaultsVersion()
+{
+    const MStyle* fileDefaults = MStyle::resolveStyleDefaults(301);
+    const MStyle* defaults = MStyle::resolveStyleDefaults(MSCVERSION);
+    Sid changed = Sid::NOSTYLE;
+    for (int i = 0; i < int(Sid::STYLES); ++i) {
+        const Sid idx = Sid(i);
+        if (idx != Sid::defaultsVersion && idx != Sid::staffUpperBorder && idx != Sid::spatium
+            && fileDefaults->value(idx) != defaults->value(idx)) {
+            changed = idx;
+            break;
+        }
+    }
+    QVERIFY(changed != Sid::NOSTYLE);
+
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<museScore version=\"3.02\">\n"
+                     "  <Score>\n"
+                     "    <Style>\n"
+                     "      <staffUpperBorder>3.5</staffUpperBorder>\n"
+                     "      <defaultsVersion>" + QByteArray::number(MSCVERSION) + "</defaultsVersion>\n"
+                     "      </Style>\n"
+                     "    </Score>\n"
+                     "  </museScore>\n";
+    QBuffer buffer(&xml);
+    buffer.open(QIODevice::ReadOnly);
+
+    MasterScore* score = new MasterScore(mscore->baseStyle());
+    QVERIFY(score->loadMsc("defaults.mscx", &buffer, false) == Score::FileError::FILE_NO_ERROR);
+    QCOMPARE(score->style().defaultStyleVersion(), MSCVERSION);
+    QCOMPARE(score->style().value(Sid::staffUpperBorder).value<Spatium>().val(), 3.5);
+    QVERIFY(score->style().value(changed) == defaults->value(changed));
+    delete score;
+}
+
+//---------------------------------------------------------
+//   styleDefaultsVersionCompat
+//    an obsolete <page-layout> before <defaultsVersion>
+//    completes the page format from the resolved defaults,
+//    as if these had been set before reading the file
+//---------------------------------------------------------
+
+void TestMscz::styleDefaultsVersionCompat()
+{
+    const MStyle* defaults = MStyle::resolveStyleDefaults(MSCVERSION);
+    const qreal height = 300.0;
+
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<museScore version=\"3.02\">\n"
+                     "  <Score>\n"
+                     "    <Style>\n"
+                     "      <page-layout>\n"
+                     "        <page-height>" + QByteArray::number(height * PPI * 2.0) + "</page-height>\n"
+                     "        </page-layout>\n"
+                     "      <staffUpperBorder>3.5</staffUpperBorder>\n"
+                     "      <defaultsVersion>" + QByteArray::number(MSCVERSION) + "</defaultsVersion>\n"
+                     "      </Style>\n"
+                     "    </Score>\n"
+                     "  </museScore>\n";
+    QBuffer buffer(&xml);
+    buffer.open(QIODevice::ReadOnly);
+
+    MasterScore* score = new MasterScore(mscore->baseStyle());
+    QVERIFY(score->loadMsc("compat.mscx", &buffer, false) == Score::FileError::FILE_NO_ERROR);
+    const MStyle& style = score->style();
+    QCOMPARE(style.value(Sid::pageHeight).toReal(), height);
+    QCOMPARE(style.value(Sid::pageWidth).toReal(), defaults->value(Sid::pageWidth).toReal());
+    QCOMPARE(style.value(Sid::pageOddLeftMargin).toReal(), defaults->value(Sid::pageOddLeftMargin).toReal());
+    const qreal width = defaults->value(Sid::pageWidth).toReal();
+    QCOMPARE(style.value(Sid::pagePrintableWidth).toReal(),
+             qMin(width - defaults->value(Sid::pageOddLeftMargin).toReal(), width - defaults->value(Sid::pageEvenLeftMargin).toReal()));
+    QCOMPARE(style.value(Sid::staffUpperBorder).value<Spatium>().val(), 3.5);
+    delete score;
+}
+
+QTEST_MAIN(TestMscz)
+#include "tst_mscz.moc"
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/xml.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestReadBenchmark
+//    reading of .mscx files, the corpus are the
+//    visual test scores; the compat corpus are the
+//    1.14 and 2.06 files of the compatibility tests,
+//    which go through the older readers
+//---------------------------------------------------------
+
+class TestReadBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    typedef QList<QPair<QString, QByteArray> > Corpus;
+    Corpus _corpus;
+    Corpus _compatCorpus;
+
+    void addFiles(Corpus& corpus, const QString& path);
+    MasterScore* read(const QString& name, QByteArray& data);
+
+private slots:
+    void initTestCase();
+    void tagLookup();
+    void readCorpus();
+    void readCompatCorpus();
+    void benchmarkTagLookup();
+    void benchmarkReadCorpus();
+    void benchmarkReadCompatCorpus();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestReadBenchmark::initTestCase()
+{
+    initMTest();
+
+    addFiles(_corpus, root + "/../../../vtest/scores");
+    QFile f(root + "/concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    _corpus.append({ "concertpitchbenchmark.mscx", f.readAll() });
+
+    addFiles(_compatCorpus, root + "/compat114_data");
+    addFiles(_compatCorpus, root + "/compat206_data");
+}
+
+//---------------------------------------------------------
+//   addFiles
+//    the .mscx files in path, without the reference
+//    files written by the tests
+//---------------------------------------------------------
+
+void TestReadBenchmark::addFiles(Corpus& corpus, const QString& path)
+{
+    QDir dir(path);
+    for (const QString& name : dir.entryList({ "*.mscx" }, QDir::Files, QDir::Name)) {
+        if (name.endsWith("-ref.mscx")) {
+            continue;
+        }
+        QFile f(dir.filePath(name));
+        if (f.open(QIODevice::ReadOnly)) {
+            corpus.append({ name, f.readAll() });
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   read
+//---------------------------------------------------------
+
+MasterScore* TestReadBenchmark::read(const QString& name, QByteArray& data)
+{
+    MasterScore* score = new MasterScore(mscore->baseStyle());
+    score->setName(QFileInfo(name).completeBaseName());
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    if (score->loadMsc(name, &buffer, true) != Score::FileError::FILE_NO_ERROR) {
+        delete score;
+        return nullptr;
+    }
+    return score;
+}
+
+//---------------------------------------------------------
+//   tagLookup
+//    every interned name maps to its tag, everything
+//    else is unknown
+//---------------------------------------------------------
+
+void TestReadBenchmark::tagLookup()
+{
+    for (const XmlTagName& n : xmlTagNames) {
+        const QString name(n.name);
+        QCOMPARE(xmlTag(QStringRef(&name)), n.tag);
+        QCOMPARE(QString(xmlTagName(n.tag)), name);
+    }
+    for (const char* s : { "", "note", "Notes", "Not", "museScore", "Staff", "tpc3", "StemDirectio" }) {
+        const QString name(s);
+        QCOMPARE(xmlTag(QStringRef(&name)), XmlTag::UNKNOWN);
+    }
+    const QString umlaut = QString::fromUtf8("Nöte");
+    QCOMPARE(xmlTag(QStringRef(&umlaut)), XmlTag::UNKNOWN);
+
+    const QString xml("<Chord><Note><pitch>60</pitch></Note><foo/></Chord>");
+    XmlReader e(xml);
+    QVERIFY(e.readNextStartElement());
+    QCOMPARE(e.tag(), XmlTag::CHORD);
+    QVERIFY(e.readNextStartElement());
+    QCOMPARE(e.tag(), XmlTag::NOTE);
+    QVERIFY(e.readNextStartElement());
+    QCOMPARE(e.tag(), XmlTag::PITCH);
+    e.skipCurrentElement();
+    QVERIFY(!e.readNextStartElement());
+    QVERIFY(e.readNextStartElement());
+    QCOMPARE(e.tag(), XmlTag::UNKNOWN);
+}
+
+//---------------------------------------------------------
+//   readCorpus
+//---------------------------------------------------------
+
+void TestReadBenchmark::readCorpus()
+{
+    QVERIFY(!_corpus.isEmpty());
+    for (auto& s : _corpus) {
+        MasterScore* score = read(s.first, s.second);
+        QVERIFY2(score, qPrintable(s.first));
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   readCompatCorpus
+//---------------------------------------------------------
+
+void TestReadBenchmark::readCompatCorpus()
+{
+    QVERIFY(!_compatCorpus.isEmpty());
+    for (auto& s : _compatCorpus) {
+        MasterScore* score = read(s.first, s.second);
+        QVERIFY2(score, qPrintable(s.first));
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkTagLookup
+//---------------------------------------------------------
+
+void TestReadBenchmark::benchmarkTagLookup()
+{
+    QStringList names;
+    for (const XmlTagName& n : xmlTagNames) {
+        names.append(n.name);
+    }
+    names.append("museScore");
+    names.append("Staff");
+
+    int found = 0;
+    QBENCHMARK {
+        for (const QString& name : names) {
+            found += xmlTag(QStringRef(&name)) != XmlTag::UNKNOWN;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+//---------------------------------------------------------
+//   benchmarkReadCorpus
+//    read only, no layout
+//---------------------------------------------------------
+
+void TestReadBenchmark::benchmarkReadCorpus()
+{
+    QBENCHMARK {
+        for (auto& s : _corpus) {
+            delete read(s.first, s.second);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkReadCompatCorpus
+//    read only, no layout
+//---------------------------------------------------------
+
+void TestReadBenchmark::benchmarkReadCompatCorpus()
+{
+    QBENCHMARK {
+        for (auto& s : _compatCorpus) {
+            delete read(s.first, s.second);
+        }
+    }
+}
+
+QTEST_MAIN(TestReadBenchmark)
+#include "tst_readbenchmark.moc"
@@ -0,0 +1,308 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/scorecache.h"
+
+static const QString SCORECACHE_DATA_DIR("concertpitch_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreCache
+//---------------------------------------------------------
+
+class TestScoreCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QTemporaryDir _dir;
+    QString _scorePath;
+
+    MasterScore* load();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cachedLoad();
+    void invalidCache();
+    void pruneDirectory();
+    void benchmarkLoadCompressed();
+    void benchmarkLoadCached();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    a compressed copy of the benchmark score is the source
+//---------------------------------------------------------
+
+void TestScoreCache::initTestCase()
+{
+    initMTest();
+    QVERIFY(_dir.isValid());
+
+    MasterScore* score = readScore(SCORECACHE_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    _scorePath = _dir.filePath("scorecache.mscz");
+    QFileInfo fi(_scorePath);
+    QVERIFY(score->saveCompressedFile(fi, false, false));
+    delete score;
+}
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestScoreCache::cleanupTestCase()
+{
+    ScoreCache::setCacheDirectory(QString());
+}
+
+//---------------------------------------------------------
+//   load
+//---------------------------------------------------------
+
+MasterScore* TestScoreCache::load()
+{
+    MasterScore* score = new MasterScore(mscore->baseStyle());
+    score->setName("scorecache");
+    if (score->loadMsc(_scorePath, false) != Score::FileError::FILE_NO_ERROR) {
+        delete score;
+        return nullptr;
+    }
+    score->doLayout();
+    return score;
+}
+
+//---------------------------------------------------------
+//   cachedLoad
+//    a score read from the cache is saved identical to
+//    the score read from the .mscz
+//---------------------------------------------------------
+
+void TestScoreCache::cachedLoad()
+{
+    ScoreCache::setCacheDirectory(QString());
+    MasterScore* score = load();
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "scorecache-xml.mscx"));
+    delete score;
+
+    ScoreCache::setCacheDirectory(_dir.filePath("cache"));
+    QFile source(_scorePath);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    ScoreCache cache(_scorePath);
+    cache.setSourceData(source.readAll());
+    QVERIFY(!cache.open());
+
+    // first load writes the cache
+    score = load();
+    QVERIFY(score);
+    delete score;
+    QVERIFY(QFileInfo::exists(cache.filePath()));
+    QVERIFY(cache.open());
+    QVERIFY(!cache.names().isEmpty());
+    QVERIFY(cache.names().first().endsWith(".mscx"));
+    cache.close();
+
+    // second load reads it
+    score = load();
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "scorecache-cached.mscx"));
+    delete score;
+
+    QVERIFY(compareFilesFromPaths("scorecache-cached.mscx", "scorecache-xml.mscx"));
+
+    // the cache is not used for other source data
+    QBuffer empty;
+    empty.open(QIODevice::ReadOnly);
+    score = new MasterScore(mscore->baseStyle());
+    QVERIFY(score->loadMsc(_scorePath, &empty, false) != Score::FileError::FILE_NO_ERROR);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   invalidCache
+//    the cache is used only for source data of the same
+//    size and hash; damaged entries are rejected
+//---------------------------------------------------------
+
+void TestScoreCache::invalidCache()
+{
+    ScoreCache::setCacheDirectory(_dir.filePath("cache"));
+    const QString path = _dir.filePath("invalid.mscz");
+    QFile::remove(path);
+    QVERIFY(QFile::copy(_scorePath, path));
+    QFile source(path);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QByteArray data = source.readAll();
+    source.close();
+
+    const QList<ScoreCache::Entry> entries { { "score.mscx", QByteArray("<museScore/>") },
+                                             { "Pictures/image.png", QByteArray("image") } };
+    ScoreCache cache(path);
+    QVERIFY(!cache.write(entries));         // needs the source data for the hash
+    cache.setSourceData(data);
+    QVERIFY(cache.write(entries));
+    QVERIFY(cache.open());
+    QCOMPARE(cache.data("score.mscx"), QByteArray("<museScore/>"));
+    QCOMPARE(cache.data("Pictures/image.png"), QByteArray("image"));
+    cache.close();
+
+    ScoreCache unchanged(path);
+    QVERIFY(!unchanged.open());             // needs the source data for the hash
+    unchanged.setSourceData(data);
+    QVERIFY(unchanged.open());
+    unchanged.close();
+
+    // a changed source of the same size and time is rejected
+    const QDateTime modified = QFileInfo(path).lastModified();
+    QByteArray changedData = data;
+    const int pos = data.size() / 2;
+    changedData[pos] = char(~changedData.at(pos));
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    source.write(changedData);
+    QVERIFY(source.setFileTime(modified, QFileDevice::FileModificationTime));
+    source.close();
+    ScoreCache changed(path);
+    changed.setSourceData(changedData);
+    QVERIFY(!changed.open());
+
+    // the payload is not read on open, a damaged image is
+    // found on first access; the damaged root file on open
+    QFile f(cache.filePath());
+    auto damage = [&f](qint64 offset) {
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        f.seek(f.size() - offset);
+        f.write("x");
+        f.close();
+    };
+    damage(8);                              // image, "image" padded to 8 bytes
+    ScoreCache damagedImage(path);
+    damagedImage.setSourceData(data);
+    QVERIFY(damagedImage.open());
+    QVERIFY(damagedImage.data("Pictures/image.png").isEmpty());
+    damagedImage.close();
+
+    damage(24);                             // root file, padded to 16 bytes
+    ScoreCache damaged(path);
+    damaged.setSourceData(data);
+    QVERIFY(!damaged.open());
+
+    cache.remove();
+    QVERIFY(!QFileInfo::exists(cache.filePath()));
+}
+
+//---------------------------------------------------------
+//   pruneDirectory
+//    old files go first, then the least recently used until
+//    the directory fits; the last used file is kept
+//---------------------------------------------------------
+
+void TestScoreCache::pruneDirectory()
+{
+    const QString dirPath = _dir.filePath("prune");
+    ScoreCache::setCacheDirectory(dirPath);
+    QDir dir(dirPath);
+    QVERIFY(dir.mkpath("."));
+
+    const QDateTime now = QDateTime::currentDateTime();
+    auto add = [&dir](const QString& name, int size, const QDateTime& time) {
+        QFile f(dir.filePath(name));
+        f.open(QIODevice::WriteOnly);
+        f.write(QByteArray(size, 'x'));
+        f.flush();
+        f.setFileTime(time, QFileDevice::FileModificationTime);
+    };
+    add("a.mscache", 100, now);
+    add("b.mscache", 100, now.addSecs(-60));
+    add("c.mscache", 100, now.addSecs(-120));
+    add("old.mscache", 10, now.addDays(-ScoreCache::MAX_AGE_DAYS - 1));
+    add("other.txt", 1000, now.addDays(-ScoreCache::MAX_AGE_DAYS - 1));
+
+    ScoreCache::prune(250);
+    QVERIFY(dir.exists("a.mscache"));
+    QVERIFY(dir.exists("b.mscache"));
+    QVERIFY(!dir.exists("c.mscache"));
+    QVERIFY(!dir.exists("old.mscache"));
+    QVERIFY(dir.exists("other.txt"));
+
+    ScoreCache::prune(50);
+    QVERIFY(dir.exists("a.mscache"));
+    QVERIFY(!dir.exists("b.mscache"));
+}
+
+//---------------------------------------------------------
+//   benchmarkLoadCompressed
+//---------------------------------------------------------
+
+void TestScoreCache::benchmarkLoadCompressed()
+{
+    ScoreCache::setCacheDirectory(QString());
+    QFile f(_scorePath);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QByteArray data = f.readAll();
+
+    QBENCHMARK {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        score->fileInfo()->setFile(_scorePath);
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        QVERIFY(score->loadCompressedMsc(&buffer, false) == Score::FileError::FILE_NO_ERROR);
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkLoadCached
+//    loadMsc additionally reads and hashes the source
+//    file, this is not measured here
+//---------------------------------------------------------
+
+void TestScoreCache::benchmarkLoadCached()
+{
+    ScoreCache::setCacheDirectory(_dir.filePath("cache"));
+    QFile f(_scorePath);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    ScoreCache cache(_scorePath);
+    cache.setSourceData(f.readAll());
+    if (!cache.open()) {
+        delete load();
+        QVERIFY(cache.open());
+    }
+
+    QBENCHMARK {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        score->fileInfo()->setFile(_scorePath);
+        QVERIFY(score->loadCachedMsc(cache, false) == Score::FileError::FILE_NO_ERROR);
+        delete score;
+    }
+}
+
+QTEST_MAIN(TestScoreCache)
+#include "tst_scorecache.moc"
@@ -0,0 +1,257 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <random>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+
+static const QString SHAPE_DATA_DIR("all_elements_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestShape
+//---------------------------------------------------------
+
+class TestShape : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score { nullptr };
+    std::vector<std::pair<Shape, Shape> > pairs;        // adjacent segment shapes of one staff
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void indexRandom();
+    void indexSegments();
+    void benchmarkHorizontalBrute();
+    void benchmarkHorizontalIndex();
+    void benchmarkVerticalBrute();
+    void benchmarkVerticalIndex();
+    void benchmarkRepeatedBrute();
+    void benchmarkRepeatedIndex();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    collect the shapes of adjacent segments
+//---------------------------------------------------------
+
+void TestShape::initTestCase()
+{
+    initMTest();
+    score = readScore(SHAPE_DATA_DIR + "moonlight.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    size_t rects = 0;
+    size_t maxRects = 0;
+    for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+        Segment* ns = s->next1();
+        if (!ns || !s->enabled() || !ns->enabled()) {
+            continue;
+        }
+        for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            const Shape& a = s->staffShape(staffIdx);
+            const Shape& b = ns->staffShape(staffIdx);
+            if (a.empty() || b.empty()) {
+                continue;
+            }
+            Shape bb = b.translated(QPointF(ns->x() - s->x(), 0.0));
+            pairs.push_back({ a, bb });
+            rects += a.size();
+            maxRects = std::max(maxRects, a.size());
+        }
+    }
+    QVERIFY(!pairs.empty());
+    qDebug("%zu shape pairs, %.1f rects per shape, max %zu", pairs.size(), double(rects) / pairs.size(), maxRects);
+}
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestShape::cleanupTestCase()
+{
+    delete score;
+}
+
+//---------------------------------------------------------
+//   indexRandom
+//    ShapeIndex must give exactly the Shape results
+//---------------------------------------------------------
+
+void TestShape::indexRandom()
+{
+    std::mt19937 rng(815);
+    std::uniform_real_distribution<qreal> pos(-50.0, 50.0);
+    std::uniform_real_distribution<qreal> size(-5.0, 30.0);
+    std::uniform_int_distribution<int> special(0, 7);
+    std::uniform_int_distribution<int> count(0, 40);
+
+    auto randomShape = [&]() {
+        Shape s;
+        int n = count(rng);
+        for (int i = 0; i < n; ++i) {
+            qreal x = std::round(pos(rng));           // equal coordinates are common
+            qreal y = std::round(pos(rng));
+            qreal w = size(rng);
+            qreal h = size(rng);
+            switch (special(rng)) {
+            case 0: w = 0.0;
+                break;
+            case 1: h = 0.0;
+                break;
+            case 2: w = h = 0.0;
+                break;
+            default:
+                break;
+            }
+            s.add(QRectF(x, y, w, h));
+        }
+        return s;
+    };
+
+    for (int run = 0; run < 2000; ++run) {
+        Shape a = randomShape();
+        Shape b = randomShape();
+        ShapeIndex index(a);
+        QCOMPARE(index.minHorizontalDistance(b), a.minHorizontalDistance(b));
+        QCOMPARE(index.minVerticalDistance(b), a.minVerticalDistance(b));
+    }
+}
+
+//---------------------------------------------------------
+//   indexSegments
+//---------------------------------------------------------
+
+void TestShape::indexSegments()
+{
+    for (const auto& p : pairs) {
+        ShapeIndex index(p.first);
+        QCOMPARE(index.minHorizontalDistance(p.second), p.first.minHorizontalDistance(p.second));
+        QCOMPARE(index.minVerticalDistance(p.second), p.first.minVerticalDistance(p.second));
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarks
+//    the index benchmarks include building the index for
+//    every query
+//---------------------------------------------------------
+
+void TestShape::benchmarkHorizontalBrute()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (const auto& p : pairs) {
+            sum += p.first.minHorizontalDistance(p.second);
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+void TestShape::benchmarkHorizontalIndex()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (const auto& p : pairs) {
+            sum += ShapeIndex(p.first).minHorizontalDistance(p.second);
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+void TestShape::benchmarkVerticalBrute()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (const auto& p : pairs) {
+            sum += p.first.minVerticalDistance(p.second);
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+void TestShape::benchmarkVerticalIndex()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (const auto& p : pairs) {
+            sum += ShapeIndex(p.first).minVerticalDistance(p.second);
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+//---------------------------------------------------------
+//   benchmarkRepeated
+//    one shape queried against the shapes of the following
+//    pairs, the index is built once per shape
+//---------------------------------------------------------
+
+static constexpr size_t REPEATED_QUERIES = 16;
+
+void TestShape::benchmarkRepeatedBrute()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            const Shape& a = pairs[i].first;
+            for (size_t k = 0; k < REPEATED_QUERIES; ++k) {
+                sum += a.minHorizontalDistance(pairs[(i + k) % pairs.size()].second);
+            }
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+void TestShape::benchmarkRepeatedIndex()
+{
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            const Shape& a = pairs[i].first;
+            if (a.size() < ShapeIndex::MinSize) {
+                for (size_t k = 0; k < REPEATED_QUERIES; ++k) {
+                    sum += a.minHorizontalDistance(pairs[(i + k) % pairs.size()].second);
+                }
+                continue;
+            }
+            ShapeIndex index(a);
+            for (size_t k = 0; k < REPEATED_QUERIES; ++k) {
+                sum += index.minHorizontalDistance(pairs[(i + k) % pairs.size()].second);
+            }
+        }
+    }
+    QVERIFY(sum != 0.0);
+}
+
+QTEST_MAIN(TestShape)
+#include "tst_shape.moc"
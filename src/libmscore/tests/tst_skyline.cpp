@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+
+#include "testing/qtestsuite.h"
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSkyline
+//---------------------------------------------------------
+
+class TestSkyline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void horizontalEmpty();
+    void horizontalBound();
+};
+
+//---------------------------------------------------------
+//   horizontalEmpty
+//---------------------------------------------------------
+
+void TestSkyline::horizontalEmpty()
+{
+    HorizontalSkyline sk(10.0);
+    QVERIFY(sk.empty());
+    QCOMPARE(sk.minDistance(Shape(QRectF(0.0, 0.0, 5.0, 5.0))), HorizontalSkyline::MinRight);
+
+    sk.add(Shape(QRectF(0.0, 0.0, 5.0, 5.0)), 20.0);
+    QVERIFY(!sk.empty());
+    QCOMPARE(sk.minDistance(Shape(QRectF(1.0, 2.0, 5.0, 5.0))), 24.0);
+    QCOMPARE(sk.minDistance(Shape(QRectF(1.0, 200.0, 5.0, 5.0))), HorizontalSkyline::MinRight);
+
+    sk.clear();
+    QVERIFY(sk.empty());
+}
+
+//---------------------------------------------------------
+//   horizontalBound
+//    the skyline distance is never smaller than the exact
+//    distance to the union of the shapes
+//---------------------------------------------------------
+
+void TestSkyline::horizontalBound()
+{
+    std::mt19937 rng(4711);
+    std::uniform_real_distribution<qreal> pos(-150.0, 150.0);
+    std::uniform_real_distribution<qreal> size(0.0, 40.0);
+    std::uniform_int_distribution<int> special(0, 9);
+
+    auto randomRect = [&]() {
+        qreal w = size(rng);
+        qreal h = size(rng);
+        switch (special(rng)) {
+        case 0: w = 0.0;
+            break;
+        case 1: h = 0.0;
+            break;
+        case 2: h = 3000000.0;          // outside of the bands
+            break;
+        default:
+            break;
+        }
+        return QRectF(pos(rng), pos(rng), w, h);
+    };
+
+    for (int run = 0; run < 200; ++run) {
+        HorizontalSkyline sk(12.5);
+        Shape all;
+        for (int i = 0; i < 20; ++i) {
+            Shape s;
+            for (int k = 0; k < 4; ++k) {
+                s.add(randomRect());
+            }
+            qreal x = pos(rng);
+            sk.add(s, x);
+            all.add(s.translated(QPointF(x, 0.0)));
+        }
+        Shape ns;
+        for (int k = 0; k < 4; ++k) {
+            ns.add(randomRect());
+        }
+        const qreal exact = all.minHorizontalDistance(ns);
+        QVERIFY(sk.minDistance(ns) >= exact - 1e-9);
+    }
+}
+
+QTEST_MAIN(TestSkyline)
+#include "tst_skyline.moc"
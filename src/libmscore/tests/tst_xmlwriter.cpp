@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/xml.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestXmlWriter
+//    output format of XmlWriter and save benchmarks over
+//    the visual test scores
+//---------------------------------------------------------
+
+class TestXmlWriter : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QList<MasterScore*> _corpus;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void tags();
+    void flushing();
+    void toString();
+    void benchmarkSaveCorpus();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestXmlWriter::initTestCase()
+{
+    initMTest();
+
+    QDir dir(root + "/../../../vtest/scores");
+    for (const QString& name : dir.entryList({ "*.mscx" }, QDir::Files, QDir::Name)) {
+        MasterScore* score = readCreatedScore(dir.filePath(name));
+        if (score) {
+            _corpus.append(score);
+        }
+    }
+    MasterScore* score = readScore("concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    _corpus.append(score);
+}
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestXmlWriter::cleanupTestCase()
+{
+    qDeleteAll(_corpus);
+}
+
+//---------------------------------------------------------
+//   tags
+//    the output as it was written by the QTextStream
+//    based writer
+//---------------------------------------------------------
+
+void TestXmlWriter::tags()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        XmlWriter xml(nullptr, &buffer);
+        xml.header();
+        xml.stag("museScore version=\"3.02\"");
+        xml.tag("int", 42);
+        xml.tag("negative", -7);
+        xml.tag("long", QVariant(qint64(-1234567890123LL)));
+        xml.tag("double", 0.1);
+        xml.tag("small", 1e-05);
+        xml.tag("big", 1234567.0);
+        xml.tag("third", 1.0 / 3.0);
+        xml.tag("string", QString::fromUtf8("a<b & \"c\" é♭"));
+        xml.tag("voice id=\"2\"", 3);
+        xml.tag("color", QColor(1, 2, 3, 4));
+        xml.tag("offset", QPointF(0.5, -2.25));
+        xml.tag("size", QSizeF(10, 20.125));
+        xml.tag("rect", QRectF(1, 2, 3.5, 4));
+        xml.tag("duration", Fraction(3, 8));
+        xml.tag("sp", QVariant::fromValue(Spatium(1.5)));
+        xml.tagE("empty a=\"%d\"", 1);
+        xml.comment("comment");
+        xml.writeXml("text", "<b>bold</b>");
+        xml.etag();
+    }
+    buffer.close();
+
+    const QByteArray expected
+        = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          "<museScore version=\"3.02\">\n"
+          "  <int>42</int>\n"
+          "  <negative>-7</negative>\n"
+          "  <long>-1234567890123</long>\n"
+          "  <double>0.1</double>\n"
+          "  <small>1e-05</small>\n"
+          "  <big>1.23457e+06</big>\n"
+          "  <third>0.333333</third>\n"
+          "  <string>a&lt;b &amp; &quot;c&quot; \xc3\xa9\xe2\x99\xad</string>\n"
+          "  <voice id=\"2\">3</voice>\n"
+          "  <color r=\"1\" g=\"2\" b=\"3\" a=\"4\"/>\n"
+          "  <offset x=\"0.5\" y=\"-2.25\"/>\n"
+          "  <size w=\"10\" h=\"20.125\"/>\n"
+          "  <rect x=\"1\" y=\"2\" w=\"3.5\" h=\"4\"/>\n"
+          "  <duration>3/8</duration>\n"
+          "  <sp>1.5</sp>\n"
+          "  <empty a=\"1\"/>\n"
+          "  <!-- comment -->\n"
+          "  <text><b>bold</b></text>\n"
+          "  </museScore>\n";
+    QCOMPARE(buffer.data(), expected);
+}
+
+//---------------------------------------------------------
+//   flushing
+//    the device has the data when the outermost element
+//    is closed or the device is closed
+//---------------------------------------------------------
+
+void TestXmlWriter::flushing()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    XmlWriter xml(nullptr, &buffer);
+    xml.stag("a");
+    xml.tag("b", 1);
+    QVERIFY(buffer.data().isEmpty());
+    xml.etag();
+    QCOMPARE(buffer.data(), QByteArray("<a>\n  <b>1</b>\n  </a>\n"));
+
+    xml.tag("c", 2);
+    QCOMPARE(buffer.data().size(), 22 + 9);
+
+    xml.stag("d");
+    buffer.close();
+    QVERIFY(buffer.data().endsWith("<d>\n"));
+}
+
+//---------------------------------------------------------
+//   toString
+//---------------------------------------------------------
+
+void TestXmlWriter::toString()
+{
+    QString s;
+    XmlWriter xml(nullptr);
+    xml.setString(&s);
+    xml.tag("name", QString::fromUtf8("♯"));
+    xml.flush();
+    QCOMPARE(s, QString::fromUtf8("<name>♯</name>\n"));
+}
+
+//---------------------------------------------------------
+//   benchmarkSaveCorpus
+//---------------------------------------------------------
+
+void TestXmlWriter::benchmarkSaveCorpus()
+{
+    QByteArray data;
+    QBENCHMARK {
+        for (MasterScore* score : _corpus) {
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly | QIODevice::Truncate);
+            score->Score::saveFile(&buffer, false);
+            buffer.close();
+        }
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+QTEST_MAIN(TestXmlWriter)
+#include "tst_xmlwriter.moc"
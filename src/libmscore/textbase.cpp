@@ -269,7 +269,7 @@ QRectF TextCursor::cursorRect() const
     const TextFragment* fragment = tline.fragment(column());
 
     QFont _font  = fragment ? fragment->font(_text) : _text->font();
-    qreal ascent = QFontMetricsF(_font, MScore::paintDevice()).ascent();
+    qreal ascent = CachedFontMetrics(_font, MScore::paintDevice()).ascent();
     qreal h = ascent;
     qreal x = tline.xpos(column(), _text);
     qreal y = tline.y() - ascent * .9;
@@ -1002,7 +1002,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
+        CachedFontMetrics fm(font);
 
         bool fail = false;
         for (int i = 0; i < text.size(); ++i) {
@@ -1095,14 +1095,14 @@ void TextBlock::layout(TextBase* t)
     }
 
     if (_fragments.empty()) {
-        QFontMetricsF fm = t->fontMetrics();
+        CachedFontMetrics fm = t->fontMetrics();
         _bbox.setRect(0.0, -fm.ascent(), 1.0, fm.descent());
         _lineSpacing = fm.lineSpacing();
     } else if (_fragments.size() == 1 && _fragments.at(0).text.isEmpty()) {
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        CachedFontMetrics fm(f.font(t), MScore::paintDevice());
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
             qreal voffset = fm.xHeight() / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1124,7 +1124,7 @@ void TextBlock::layout(TextBase* t)
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            CachedFontMetrics fm(f.font(t), MScore::paintDevice());
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
                 qreal voffset = fm.xHeight() / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1196,7 +1196,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        CachedFontMetrics fm(f.font(t), MScore::paintDevice());
         int idx = 0;
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
@@ -1296,12 +1296,12 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        CachedFontMetrics fm(f.font(t), MScore::paintDevice());
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
             qreal xo = fm.width(f.text.left(idx));
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
@@ -2081,7 +2081,7 @@ void TextBase::layoutFrame()
 //      if (empty()) {    // or bbox.width() <= 1.0
     if (bbox().width() <= 1.0 || bbox().height() < 1.0) {      // or bbox.width() <= 1.0
         // this does not work for Harmony:
-        QFontMetricsF fm = QFontMetricsF(font(), MScore::paintDevice());
+        CachedFontMetrics fm(font(), MScore::paintDevice());
         qreal ch = fm.ascent();
         qreal cw = fm.width('n');
         frame = QRectF(0.0, -ch, cw, ch);
@@ -3021,9 +3021,9 @@ QFont TextBase::font() const
 //   fontMetrics
 //---------------------------------------------------------
 
-QFontMetricsF TextBase::fontMetrics() const
+CachedFontMetrics TextBase::fontMetrics() const
 {
-    return QFontMetricsF(font());
+    return CachedFontMetrics(font());
 }
 
 //---------------------------------------------------------
@@ -28,6 +28,7 @@
 #include "element.h"
 #include "property.h"
 #include "style.h"
+#include "fontmetricscache.h"
 
 namespace Ms {
 class MuseScoreView;
@@ -383,7 +384,7 @@ public:
     void inputTransition(EditData&, QInputMethodEvent*);
 
     QFont font() const;
-    QFontMetricsF fontMetrics() const;
+    CachedFontMetrics fontMetrics() const;
 
     virtual QVariant getProperty(Pid propertyId) const override;
     virtual bool setProperty(Pid propertyId, const QVariant& v) override;
@@ -1785,10 +1785,7 @@ void ChangeStyleVal::flip(EditData*)
             qreal mmag = score->styleD(Sid::chordModifierMag);
             qreal madjust = score->styleD(Sid::chordModifierAdjust);
             score->style().chordList()->configureAutoAdjust(emag, eadjust, mmag, madjust);
-            if (score->styleB(Sid::chordsXmlFile)) {
-                score->style().chordList()->read("chords.xml");
-            }
-            score->style().chordList()->read(score->styleSt(Sid::chordDescriptionFile));
+            score->style().chordList()->readShared(score->styleSt(Sid::chordDescriptionFile), score->styleB(Sid::chordsXmlFile));
             score->style().setCustomChordList(score->styleSt(Sid::chordStyle) == "custom");
         }
         break;
@@ -1820,6 +1817,22 @@ void ChangePageNumberOffset::flip(EditData*)
     pageOffset = po;
 }
 
+//---------------------------------------------------------
+//   invalidateStaffOccupancy
+//    for property changes the segment hooks do not see
+//---------------------------------------------------------
+
+static void invalidateStaffOccupancy(ScoreElement* se)
+{
+    if (!se->isElement()) {
+        return;
+    }
+    Measure* m = toElement(se)->findMeasure();
+    if (m) {
+        m->invalidateStaffOccupancy();
+    }
+}
+
 //---------------------------------------------------------
 //   ChangeChordStaffMove
 //---------------------------------------------------------
@@ -1836,6 +1849,7 @@ void ChangeChordStaffMove::flip(EditData*)
         ChordRest* cr = toChordRest(e);
         cr->setStaffMove(staffMove);
         cr->triggerLayout();
+        invalidateStaffOccupancy(cr);
     }
     staffMove = v;
 }
@@ -2343,6 +2357,9 @@ void ChangeProperty::flip(EditData*)
     element->setPropertyFlags(id, flags);
     property = v;
     flags = ps;
+    if (id == Pid::VISIBLE || id == Pid::STAFF_MOVE || id == Pid::SYSTEM_FLAG || id == Pid::TRACK) {
+        invalidateStaffOccupancy(element);
+    }
 }
 
 //---------------------------------------------------------
@@ -206,6 +206,7 @@ public:
     void push1(UndoCommand*);
     void pop();
     void setClean();
+    void setClean(int state) { cleanState = state; }
     bool canUndo() const { return curIdx > 0; }
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
@@ -23,6 +23,10 @@
 #ifndef __XML_H__
 #define __XML_H__
 
+#include <vector>
+
+#include <QByteArray>
+#include <QIODevice>
 #include <QMultiMap>
 #include <QXmlStreamReader>
 #include <QTextStream>
@@ -32,6 +36,7 @@
 #include "interval.h"
 #include "element.h"
 #include "select.h"
+#include "xmltag.h"
 
 namespace Ms {
 enum class PlaceText : char;
@@ -133,6 +138,8 @@ public:
     bool hasAccidental { false };                       // used for userAccidental backward compatibility
     void unknown();
 
+    XmlTag tag() const { return xmlTag(name()); }       // interned name of the current element
+
     // attribute helper routines:
     QString attribute(const char* s) const { return attributes().value(s).toString(); }
     QString attribute(const char* s, const QString&) const;
@@ -231,14 +238,23 @@ public:
 
 //---------------------------------------------------------
 //   XmlWriter
+//    writes UTF-8 into a byte buffer which is handed to the
+//    output device in large blocks
+//    The buffer is flushed when the outermost element is
+//    closed, when the device is closed and on destruction.
 //---------------------------------------------------------
 
-class XmlWriter : public QTextStream
+class XmlWriter
 {
     static const int BS = 2048;
+    static const int FlushSize = 64 * 1024;
 
     Score* _score;
-    QList<QString> stack;
+    QIODevice* _device { nullptr };
+    QString* _string   { nullptr };
+    QMetaObject::Connection _deviceClosing;
+    QByteArray _buffer;
+    std::vector<QByteArray> _stack;         // names of the open elements
     SelectionFilter _filter;
 
     Fraction _curTick    { 0, 1 };       // used to optimize output
@@ -259,10 +275,38 @@ class XmlWriter : public QTextStream
     bool _recordElements = false;
 
     void putLevel();
+    void flushIfTopLevel();
+    void append(const char* s, int len) { _buffer.append(s, len); }
+    void append(const QByteArray& s) { _buffer.append(s); }
+    void appendEscaped(const QString&);
+    void appendNumber(int);
+    void appendNumber(qint64);
+    void appendNumber(double);
+
+    void writeStag(const QByteArray& name, const ScoreElement* se, const QString& attributes);
+    void writeTag(const QByteArray& name, const QVariant& data);
 
 public:
     XmlWriter(Score*);
     XmlWriter(Score* s, QIODevice* dev);
+    XmlWriter(const XmlWriter&) = delete;
+    XmlWriter& operator=(const XmlWriter&) = delete;
+    ~XmlWriter();
+
+    void setDevice(QIODevice*);
+    QIODevice* device() const { return _device; }
+    void setString(QString*, QIODevice::OpenMode mode = QIODevice::ReadWrite);
+    void setCodec(const char*) {}         // output is always UTF-8
+    void flush();
+
+    XmlWriter& operator<<(const char* s) { _buffer.append(s); return *this; }
+    XmlWriter& operator<<(char c) { _buffer.append(c); return *this; }
+    XmlWriter& operator<<(const QByteArray& s) { _buffer.append(s); return *this; }
+    XmlWriter& operator<<(const QString& s) { _buffer.append(s.toUtf8()); return *this; }
+    XmlWriter& operator<<(int v) { appendNumber(v); return *this; }
+    XmlWriter& operator<<(unsigned v) { appendNumber(qint64(v)); return *this; }
+    XmlWriter& operator<<(qint64 v) { appendNumber(v); return *this; }
+    XmlWriter& operator<<(double v) { appendNumber(v); return *this; }
 
     Fraction curTick() const { return _curTick; }
     void setCurTick(const Fraction& v) { _curTick   = v; }
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "xmltag.h"
+
+#include <QStringRef>
+
+namespace Ms {
+static constexpr XmlTagTable xmlTagTable = makeXmlTagTable();
+
+//---------------------------------------------------------
+//   xmlTag
+//    one hash and one string compare per lookup
+//---------------------------------------------------------
+
+XmlTag xmlTag(const QStringRef& name)
+{
+    const QChar* s = name.unicode();
+    const int n    = name.size();
+    uint32_t h     = 2166136261u ^ XML_TAG_HASH_SEED;
+    for (int i = 0; i < n; ++i) {
+        const ushort c = s[i].unicode();
+        if (c > 0x7f) {
+            return XmlTag::UNKNOWN;
+        }
+        h = xmlTagHashStep(h, c);
+    }
+    const XmlTag tag = xmlTagTable.slots[xmlTagHashFinal(h)];
+    if (tag == XmlTag::UNKNOWN) {
+        return XmlTag::UNKNOWN;
+    }
+
+    const char* p = xmlTagNames[int(tag) - 1].name;
+    for (int i = 0; i < n; ++i) {
+        if (p[i] != s[i].unicode()) {     // also stops at the end of p
+            return XmlTag::UNKNOWN;
+        }
+    }
+    return p[n] == 0 ? tag : XmlTag::UNKNOWN;
+}
+
+//---------------------------------------------------------
+//   xmlTagName
+//---------------------------------------------------------
+
+const char* xmlTagName(XmlTag tag)
+{
+    if (tag == XmlTag::UNKNOWN || tag >= XmlTag::TAGS) {
+        return "";
+    }
+    return xmlTagNames[int(tag) - 1].name;
+}
+}
@@ -0,0 +1,376 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __XMLTAG_H__
+#define __XMLTAG_H__
+
+#include <cstddef>
+#include <cstdint>
+
+class QStringRef;
+
+namespace Ms {
+//---------------------------------------------------------
+//   XmlTag
+//    interned names of the tags read by the hot element
+//    readers (Note, Chord, Rest, Segment, Measure, Staff)
+//    Readers switch on XmlReader::tag() instead of
+//    comparing e.name() against a chain of literals.
+//    Tags not listed here are XmlTag::UNKNOWN.
+//---------------------------------------------------------
+
+enum class XmlTag : unsigned char {
+    UNKNOWN,
+    ACCIACCATURA,
+    ACCIDENTAL,
+    AMBITUS,
+    APPOGGIATURA,
+    ARPEGGIO,
+    BAR_LINE,
+    BAR_LINE_SPAN,
+    BAR_LINE_SPAN_FROM,
+    BAR_LINE_SPAN_TO,
+    BEAM,
+    BEND,
+    BRACKET,
+    BREAK_MULTI_MEASURE_REST,
+    BREATH,
+    CHORD,
+    CHORD_LINE,
+    CLEF,
+    COLOR,
+    CUTAWAY,
+    DEFAULT_CLEF,
+    DEFAULT_CONCERT_CLEF,
+    DEFAULT_TRANSPOSING_CLEF,
+    DIST_OFFSET,
+    DOT_POSITION,
+    DYNAMIC,
+    END_REPEAT,
+    END_TUPLET,
+    EVENTS,
+    FERMATA,
+    FIGURED_BASS,
+    FINGERING,
+    FIXED,
+    FIXED_LINE,
+    FRET,
+    FRET_DIAGRAM,
+    GHOST,
+    GRACE16,
+    GRACE16AFTER,
+    GRACE32,
+    GRACE32AFTER,
+    GRACE4,
+    GRACE8AFTER,
+    HARMONY,
+    HEAD,
+    HEAD_SCHEME,
+    HEAD_TYPE,
+    HIDE_SYSTEM_BAR_LINE,
+    HIDE_WHEN_EMPTY,
+    HOOK,
+    IMAGE,
+    INSTRUMENT_CHANGE,
+    INVISIBLE,
+    IRREGULAR,
+    JUMP,
+    KEYLIST,
+    KEY_SIG,
+    LEADING_SPACE,
+    LINE,
+    LINKED_TO,
+    LOCATION,
+    MAG,
+    MARKER,
+    MEASURE_NUMBER,
+    MEASURE_NUMBER_MODE,
+    MEASURE_REPEAT,
+    MEASURE_REPEAT_COUNT,
+    MERGE_MATCHING_RESTS,
+    MIRROR,
+    MMREST_RANGE,
+    MULTI_MEASURE_REST,
+    NOTE,
+    NOTE_DOT,
+    NO_OFFSET,
+    NO_STEM,
+    OFFSET,
+    PITCH,
+    PLAY,
+    PLAYBACK_VOICE1,
+    PLAYBACK_VOICE2,
+    PLAYBACK_VOICE3,
+    PLAYBACK_VOICE4,
+    REHEARSAL_MARK,
+    REPEAT_MEASURE,
+    REST,
+    SEGMENT,
+    SHOW_IF_SYSTEM_EMPTY,
+    SLASH_STYLE,
+    SMALL,
+    SPANNER,
+    STAFF_STATE,
+    STAFF_TEXT,
+    STAFF_TYPE,
+    START_REPEAT,
+    STEM,
+    STEMLESS,
+    STEM_DIRECTION,
+    STEM_SLASH,
+    STICKING,
+    STRETCH,
+    STRING,
+    SUBTYPE,
+    SYMBOL,
+    SYSTEM_DIVIDER,
+    SYSTEM_TEXT,
+    TEMPO,
+    TEXT,
+    TICK,
+    TICK_OFFSET,
+    TIME_SIG,
+    TPC,
+    TPC2,
+    TRACK,
+    TRAILING_SPACE,
+    TRANSPOSE_CHROMATIC,
+    TRANSPOSE_DIATONIC,
+    TREMOLO,
+    TREMOLO_BAR,
+    TUNING,
+    TUPLET,
+    VELOCITY,
+    VELO_TYPE,
+    VISIBLE,
+    VOICE,
+    VSPACER,
+    VSPACER_DOWN,
+    VSPACER_FIXED,
+    VSPACER_UP,
+    TAGS
+};
+
+struct XmlTagName {
+    XmlTag tag;
+    const char* name;
+};
+
+constexpr XmlTagName xmlTagNames[] = {
+    { XmlTag::ACCIACCATURA,               "acciaccatura" },
+    { XmlTag::ACCIDENTAL,                 "Accidental" },
+    { XmlTag::AMBITUS,                    "Ambitus" },
+    { XmlTag::APPOGGIATURA,               "appoggiatura" },
+    { XmlTag::ARPEGGIO,                   "Arpeggio" },
+    { XmlTag::BAR_LINE,                   "BarLine" },
+    { XmlTag::BAR_LINE_SPAN,              "barLineSpan" },
+    { XmlTag::BAR_LINE_SPAN_FROM,         "barLineSpanFrom" },
+    { XmlTag::BAR_LINE_SPAN_TO,           "barLineSpanTo" },
+    { XmlTag::BEAM,                       "Beam" },
+    { XmlTag::BEND,                       "Bend" },
+    { XmlTag::BRACKET,                    "bracket" },
+    { XmlTag::BREAK_MULTI_MEASURE_REST,   "breakMultiMeasureRest" },
+    { XmlTag::BREATH,                     "Breath" },
+    { XmlTag::CHORD,                      "Chord" },
+    { XmlTag::CHORD_LINE,                 "ChordLine" },
+    { XmlTag::CLEF,                       "Clef" },
+    { XmlTag::COLOR,                      "color" },
+    { XmlTag::CUTAWAY,                    "cutaway" },
+    { XmlTag::DEFAULT_CLEF,               "defaultClef" },
+    { XmlTag::DEFAULT_CONCERT_CLEF,       "defaultConcertClef" },
+    { XmlTag::DEFAULT_TRANSPOSING_CLEF,   "defaultTransposingClef" },
+    { XmlTag::DIST_OFFSET,                "distOffset" },
+    { XmlTag::DOT_POSITION,               "dotPosition" },
+    { XmlTag::DYNAMIC,                    "Dynamic" },
+    { XmlTag::END_REPEAT,                 "endRepeat" },
+    { XmlTag::END_TUPLET,                 "endTuplet" },
+    { XmlTag::EVENTS,                     "Events" },
+    { XmlTag::FERMATA,                    "Fermata" },
+    { XmlTag::FIGURED_BASS,               "FiguredBass" },
+    { XmlTag::FINGERING,                  "Fingering" },
+    { XmlTag::FIXED,                      "fixed" },
+    { XmlTag::FIXED_LINE,                 "fixedLine" },
+    { XmlTag::FRET,                       "fret" },
+    { XmlTag::FRET_DIAGRAM,               "FretDiagram" },
+    { XmlTag::GHOST,                      "ghost" },
+    { XmlTag::GRACE16,                    "grace16" },
+    { XmlTag::GRACE16AFTER,               "grace16after" },
+    { XmlTag::GRACE32,                    "grace32" },
+    { XmlTag::GRACE32AFTER,               "grace32after" },
+    { XmlTag::GRACE4,                     "grace4" },
+    { XmlTag::GRACE8AFTER,                "grace8after" },
+    { XmlTag::HARMONY,                    "Harmony" },
+    { XmlTag::HEAD,                       "head" },
+    { XmlTag::HEAD_SCHEME,                "headScheme" },
+    { XmlTag::HEAD_TYPE,                  "headType" },
+    { XmlTag::HIDE_SYSTEM_BAR_LINE,       "hideSystemBarLine" },
+    { XmlTag::HIDE_WHEN_EMPTY,            "hideWhenEmpty" },
+    { XmlTag::HOOK,                       "Hook" },
+    { XmlTag::IMAGE,                      "Image" },
+    { XmlTag::INSTRUMENT_CHANGE,          "InstrumentChange" },
+    { XmlTag::INVISIBLE,                  "invisible" },
+    { XmlTag::IRREGULAR,                  "irregular" },
+    { XmlTag::JUMP,                       "Jump" },
+    { XmlTag::KEYLIST,                    "keylist" },
+    { XmlTag::KEY_SIG,                    "KeySig" },
+    { XmlTag::LEADING_SPACE,              "leadingSpace" },
+    { XmlTag::LINE,                       "line" },
+    { XmlTag::LINKED_TO,                  "linkedTo" },
+    { XmlTag::LOCATION,                   "location" },
+    { XmlTag::MAG,                        "mag" },
+    { XmlTag::MARKER,                     "Marker" },
+    { XmlTag::MEASURE_NUMBER,             "MeasureNumber" },
+    { XmlTag::MEASURE_NUMBER_MODE,        "measureNumberMode" },
+    { XmlTag::MEASURE_REPEAT,             "MeasureRepeat" },
+    { XmlTag::MEASURE_REPEAT_COUNT,       "measureRepeatCount" },
+    { XmlTag::MERGE_MATCHING_RESTS,       "mergeMatchingRests" },
+    { XmlTag::MIRROR,                     "mirror" },
+    { XmlTag::MMREST_RANGE,               "MMRestRange" },
+    { XmlTag::MULTI_MEASURE_REST,         "multiMeasureRest" },
+    { XmlTag::NOTE,                       "Note" },
+    { XmlTag::NOTE_DOT,                   "NoteDot" },
+    { XmlTag::NO_OFFSET,                  "noOffset" },
+    { XmlTag::NO_STEM,                    "noStem" },
+    { XmlTag::OFFSET,                     "offset" },
+    { XmlTag::PITCH,                      "pitch" },
+    { XmlTag::PLAY,                       "play" },
+    { XmlTag::PLAYBACK_VOICE1,            "playbackVoice1" },
+    { XmlTag::PLAYBACK_VOICE2,            "playbackVoice2" },
+    { XmlTag::PLAYBACK_VOICE3,            "playbackVoice3" },
+    { XmlTag::PLAYBACK_VOICE4,            "playbackVoice4" },
+    { XmlTag::REHEARSAL_MARK,             "RehearsalMark" },
+    { XmlTag::REPEAT_MEASURE,             "RepeatMeasure" },
+    { XmlTag::REST,                       "Rest" },
+    { XmlTag::SEGMENT,                    "Segment" },
+    { XmlTag::SHOW_IF_SYSTEM_EMPTY,       "showIfSystemEmpty" },
+    { XmlTag::SLASH_STYLE,                "slashStyle" },
+    { XmlTag::SMALL,                      "small" },
+    { XmlTag::SPANNER,                    "Spanner" },
+    { XmlTag::STAFF_STATE,                "StaffState" },
+    { XmlTag::STAFF_TEXT,                 "StaffText" },
+    { XmlTag::STAFF_TYPE,                 "StaffType" },
+    { XmlTag::START_REPEAT,               "startRepeat" },
+    { XmlTag::STEM,                       "Stem" },
+    { XmlTag::STEMLESS,                   "stemless" },
+    { XmlTag::STEM_DIRECTION,             "StemDirection" },
+    { XmlTag::STEM_SLASH,                 "StemSlash" },
+    { XmlTag::STICKING,                   "Sticking" },
+    { XmlTag::STRETCH,                    "stretch" },
+    { XmlTag::STRING,                     "string" },
+    { XmlTag::SUBTYPE,                    "subtype" },
+    { XmlTag::SYMBOL,                     "Symbol" },
+    { XmlTag::SYSTEM_DIVIDER,             "SystemDivider" },
+    { XmlTag::SYSTEM_TEXT,                "SystemText" },
+    { XmlTag::TEMPO,                      "Tempo" },
+    { XmlTag::TEXT,                       "Text" },
+    { XmlTag::TICK,                       "tick" },
+    { XmlTag::TICK_OFFSET,                "tickOffset" },
+    { XmlTag::TIME_SIG,                   "TimeSig" },
+    { XmlTag::TPC,                        "tpc" },
+    { XmlTag::TPC2,                       "tpc2" },
+    { XmlTag::TRACK,                      "track" },
+    { XmlTag::TRAILING_SPACE,             "trailingSpace" },
+    { XmlTag::TRANSPOSE_CHROMATIC,        "transposeChromatic" },
+    { XmlTag::TRANSPOSE_DIATONIC,         "transposeDiatonic" },
+    { XmlTag::TREMOLO,                    "Tremolo" },
+    { XmlTag::TREMOLO_BAR,                "TremoloBar" },
+    { XmlTag::TUNING,                     "tuning" },
+    { XmlTag::TUPLET,                     "Tuplet" },
+    { XmlTag::VELOCITY,                   "velocity" },
+    { XmlTag::VELO_TYPE,                  "veloType" },
+    { XmlTag::VISIBLE,                    "visible" },
+    { XmlTag::VOICE,                      "voice" },
+    { XmlTag::VSPACER,                    "vspacer" },
+    { XmlTag::VSPACER_DOWN,               "vspacerDown" },
+    { XmlTag::VSPACER_FIXED,              "vspacerFixed" },
+    { XmlTag::VSPACER_UP,                 "vspacerUp" },
+};
+
+//---------------------------------------------------------
+//   xmlTagHash
+//    FNV-1a with a seed; XML_TAG_HASH_SEED is chosen so that
+//    all names above land in different slots of a table of
+//    XML_TAG_TABLE_SIZE entries (checked at compile time)
+//---------------------------------------------------------
+
+constexpr uint32_t XML_TAG_HASH_SEED  = 339;
+constexpr uint32_t XML_TAG_TABLE_SIZE = 1024;
+
+constexpr uint32_t xmlTagHashStep(uint32_t h, uint32_t c)
+{
+    return (h ^ c) * 16777619u;
+}
+
+constexpr uint32_t xmlTagHashFinal(uint32_t h)
+{
+    return (h ^ (h >> 16)) & (XML_TAG_TABLE_SIZE - 1);
+}
+
+constexpr uint32_t xmlTagHash(const char* s)
+{
+    uint32_t h = 2166136261u ^ XML_TAG_HASH_SEED;
+    while (*s) {
+        h = xmlTagHashStep(h, static_cast<unsigned char>(*s++));
+    }
+    return xmlTagHashFinal(h);
+}
+
+//---------------------------------------------------------
+//   XmlTagTable
+//    slot -> tag
+//---------------------------------------------------------
+
+struct XmlTagTable {
+    XmlTag slots[XML_TAG_TABLE_SIZE] {};
+    bool perfect { true };
+};
+
+constexpr XmlTagTable makeXmlTagTable()
+{
+    XmlTagTable t;
+    for (const XmlTagName& n : xmlTagNames) {
+        XmlTag& slot = t.slots[xmlTagHash(n.name)];
+        if (slot != XmlTag::UNKNOWN) {
+            t.perfect = false;
+        }
+        slot = n.tag;
+    }
+    return t;
+}
+
+constexpr bool xmlTagNamesOrdered()
+{
+    for (int i = 0; i < int(XmlTag::TAGS) - 1; ++i) {
+        if (int(xmlTagNames[i].tag) != i + 1) {
+            return false;
+        }
+    }
+    return sizeof(xmlTagNames) / sizeof(xmlTagNames[0]) == size_t(XmlTag::TAGS) - 1;
+}
+
+static_assert(xmlTagNamesOrdered(), "xmlTagNames must list every XmlTag in enum order");
+static_assert(makeXmlTagTable().perfect, "XmlTag hash collision, choose another XML_TAG_HASH_SEED");
+
+extern XmlTag xmlTag(const QStringRef& name);
+extern const char* xmlTagName(XmlTag tag);
+}     // namespace Ms
+#endif
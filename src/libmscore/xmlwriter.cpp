@@ -21,6 +21,12 @@
  */
 
 #include "xml.h"
+
+#include <cstring>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
 #include "property.h"
 #include "scoreElement.h"
 
@@ -32,14 +38,131 @@ namespace Ms {
 XmlWriter::XmlWriter(Score* s)
 {
     _score = s;
-    setCodec("UTF-8");
+    _buffer.reserve(FlushSize + BS);
 }
 
 XmlWriter::XmlWriter(Score* s, QIODevice* device)
-    : QTextStream(device)
+    : XmlWriter(s)
 {
-    _score = s;
-    setCodec("UTF-8");
+    setDevice(device);
+}
+
+XmlWriter::~XmlWriter()
+{
+    flush();
+    QObject::disconnect(_deviceClosing);
+}
+
+//---------------------------------------------------------
+//   setDevice
+//---------------------------------------------------------
+
+void XmlWriter::setDevice(QIODevice* device)
+{
+    flush();
+    QObject::disconnect(_deviceClosing);
+    _device = device;
+    _string = nullptr;
+    if (_device) {
+        // like QTextStream, write the pending output before the device is closed
+        _deviceClosing = QObject::connect(_device, &QIODevice::aboutToClose, [this]() { flush(); });
+    }
+}
+
+//---------------------------------------------------------
+//   setString
+//    the output is appended to s
+//---------------------------------------------------------
+
+void XmlWriter::setString(QString* s, QIODevice::OpenMode)
+{
+    setDevice(nullptr);
+    _string = s;
+}
+
+//---------------------------------------------------------
+//   flush
+//---------------------------------------------------------
+
+void XmlWriter::flush()
+{
+    if (_buffer.isEmpty()) {
+        return;
+    }
+    if (_device) {
+        _device->write(_buffer);
+    } else if (_string) {
+        _string->append(QString::fromUtf8(_buffer));
+    } else {
+        return;
+    }
+    _buffer.resize(0);          // keeps the reserved capacity
+}
+
+//---------------------------------------------------------
+//   flushIfTopLevel
+//    the outermost element is complete, callers may read
+//    the device now
+//---------------------------------------------------------
+
+void XmlWriter::flushIfTopLevel()
+{
+    if (_stack.empty()) {
+        flush();
+    }
+}
+
+//---------------------------------------------------------
+//   appendNumber
+//---------------------------------------------------------
+
+void XmlWriter::appendNumber(int v)
+{
+    appendNumber(qint64(v));
+}
+
+void XmlWriter::appendNumber(qint64 v)
+{
+    char buf[24];
+    char* end = buf + sizeof(buf);
+    char* p   = end;
+    quint64 u = v < 0 ? 0 - quint64(v) : quint64(v);
+    do {
+        *--p = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) {
+        *--p = '-';
+    }
+    append(p, int(end - p));
+}
+
+void XmlWriter::appendNumber(double v)
+{
+    // same as QTextStream and QString::arg(): %g with 6 significant digits
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    char buf[32];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::general, 6);
+    append(buf, int(r.ptr - buf));
+#else
+    append(QByteArray::number(v, 'g', 6));
+#endif
+}
+
+//---------------------------------------------------------
+//   appendEscaped
+//---------------------------------------------------------
+
+void XmlWriter::appendEscaped(const QString& s)
+{
+    for (const QChar& qc : s) {
+        ushort c = qc.unicode();
+        if (c == '<' || c == '>' || c == '&' || c == '\"' || (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D)) {
+            append(xmlString(s).toUtf8());
+            return;
+        }
+    }
+    append(s.toUtf8());
 }
 
 //---------------------------------------------------------
@@ -60,10 +183,10 @@ void XmlWriter::pTag(const char* name, PlaceText place)
 
 void XmlWriter::putLevel()
 {
-    int level = stack.size();
-    for (int i = 0; i < level * 2; ++i) {
-        *this << ' ';
+    if (_buffer.size() >= FlushSize) {
+        flush();
     }
+    _buffer.append(int(_stack.size()) * 2, ' ');
 }
 
 //---------------------------------------------------------
@@ -83,8 +206,10 @@ void XmlWriter::header()
 void XmlWriter::stag(const QString& s)
 {
     putLevel();
-    *this << '<' << s << '>' << Qt::endl;
-    stack.append(s.split(' ')[0]);
+    const QByteArray b = s.toUtf8();
+    _buffer.append('<').append(b).append(">\n");
+    const int space = b.indexOf(' ');
+    _stack.push_back(space < 0 ? b : b.left(space));
 }
 
 //---------------------------------------------------------
@@ -94,7 +219,9 @@ void XmlWriter::stag(const QString& s)
 
 void XmlWriter::stag(const ScoreElement* se, const QString& attributes)
 {
-    stag(se->name(), se, attributes);
+    // element names are static strings
+    const char* name = se->name();
+    writeStag(QByteArray::fromRawData(name, int(strlen(name))), se, attributes);
 }
 
 //---------------------------------------------------------
@@ -103,17 +230,22 @@ void XmlWriter::stag(const ScoreElement* se, const QString& attributes)
 //---------------------------------------------------------
 
 void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString& attributes)
+{
+    writeStag(name.toUtf8(), se, attributes);
+}
+
+void XmlWriter::writeStag(const QByteArray& name, const ScoreElement* se, const QString& attributes)
 {
     putLevel();
-    *this << '<' << name;
+    _buffer.append('<').append(name);
     if (!attributes.isEmpty()) {
-        *this << ' ' << attributes;
+        _buffer.append(' ').append(attributes.toUtf8());
     }
-    *this << '>' << Qt::endl;
-    stack.append(name);
+    _buffer.append(">\n");
+    _stack.push_back(name);
 
     if (_recordElements) {
-        _elements.emplace_back(se, name);
+        _elements.emplace_back(se, QString::fromUtf8(name));
     }
 }
 
@@ -125,7 +257,9 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
 void XmlWriter::etag()
 {
     putLevel();
-    *this << "</" << stack.takeLast() << '>' << Qt::endl;
+    _buffer.append("</").append(_stack.back()).append(">\n");
+    _stack.pop_back();
+    flushIfTopLevel();
 }
 
 //---------------------------------------------------------
@@ -138,12 +272,13 @@ void XmlWriter::tagE(const char* format, ...)
     va_list args;
     va_start(args, format);
     putLevel();
-    *this << '<';
+    _buffer.append('<');
     char buffer[BS];
     vsnprintf(buffer, BS, format, args);
-    *this << buffer;
+    _buffer.append(buffer);
     va_end(args);
-    *this << "/>" << Qt::endl;
+    _buffer.append("/>\n");
+    flushIfTopLevel();
 }
 
 //---------------------------------------------------------
@@ -153,7 +288,8 @@ void XmlWriter::tagE(const char* format, ...)
 void XmlWriter::tagE(const QString& s)
 {
     putLevel();
-    *this << '<' << s << "/>\n";
+    _buffer.append('<').append(s.toUtf8()).append("/>\n");
+    flushIfTopLevel();
 }
 
 //---------------------------------------------------------
@@ -164,7 +300,7 @@ void XmlWriter::tagE(const QString& s)
 void XmlWriter::ntag(const char* name)
 {
     putLevel();
-    *this << "<" << name << ">";
+    _buffer.append('<').append(name).append('>');
 }
 
 //---------------------------------------------------------
@@ -174,7 +310,7 @@ void XmlWriter::ntag(const char* name)
 
 void XmlWriter::netag(const char* s)
 {
-    *this << "</" << s << '>' << Qt::endl;
+    _buffer.append("</").append(s).append(">\n");
 }
 
 //---------------------------------------------------------
@@ -207,13 +343,19 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
 void XmlWriter::tag(const char* name, QVariant data, QVariant defaultData)
 {
     if (data != defaultData) {
-        tag(QString(name), data);
+        writeTag(QByteArray::fromRawData(name, int(strlen(name))), data);
     }
 }
 
 void XmlWriter::tag(const QString& name, QVariant data)
 {
-    QString ename(name.split(' ')[0]);
+    writeTag(name.toUtf8(), data);
+}
+
+void XmlWriter::writeTag(const QByteArray& name, const QVariant& data)
+{
+    const int space = name.indexOf(' ');
+    const QByteArray ename = space < 0 ? name : QByteArray::fromRawData(name.constData(), space);
 
     putLevel();
     switch (data.type()) {
@@ -221,67 +363,105 @@ void XmlWriter::tag(const QString& name, QVariant data)
     case QVariant::Char:
     case QVariant::Int:
     case QVariant::UInt:
-        *this << "<" << name << ">";
-        *this << data.toInt();
-        *this << "</" << ename << ">\n";
+        _buffer.append('<').append(name).append('>');
+        appendNumber(data.toInt());
+        _buffer.append("</").append(ename).append(">\n");
         break;
     case QVariant::LongLong:
-        *this << "<" << name << ">";
-        *this << data.toLongLong();
-        *this << "</" << ename << ">\n";
+        _buffer.append('<').append(name).append('>');
+        appendNumber(data.toLongLong());
+        _buffer.append("</").append(ename).append(">\n");
         break;
     case QVariant::Double:
-        *this << "<" << name << ">";
-        *this << data.value<double>();
-        *this << "</" << ename << ">\n";
+        _buffer.append('<').append(name).append('>');
+        appendNumber(data.value<double>());
+        _buffer.append("</").append(ename).append(">\n");
         break;
     case QVariant::String:
-        *this << "<" << name << ">";
-        *this << xmlString(data.value<QString>());
-        *this << "</" << ename << ">\n";
+        _buffer.append('<').append(name).append('>');
+        appendEscaped(data.value<QString>());
+        _buffer.append("</").append(ename).append(">\n");
         break;
     case QVariant::Color:
     {
         QColor color(data.value<QColor>());
-        *this << QString("<%1 r=\"%2\" g=\"%3\" b=\"%4\" a=\"%5\"/>\n")
-            .arg(name).arg(color.red()).arg(color.green()).arg(color.blue()).arg(color.alpha());
+        _buffer.append('<').append(name).append(" r=\"");
+        appendNumber(color.red());
+        _buffer.append("\" g=\"");
+        appendNumber(color.green());
+        _buffer.append("\" b=\"");
+        appendNumber(color.blue());
+        _buffer.append("\" a=\"");
+        appendNumber(color.alpha());
+        _buffer.append("\"/>\n");
     }
     break;
     case QVariant::Rect:
     {
         const QRect& r(data.value<QRect>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"/>\n").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+        _buffer.append('<').append(name).append(" x=\"");
+        appendNumber(r.x());
+        _buffer.append("\" y=\"");
+        appendNumber(r.y());
+        _buffer.append("\" w=\"");
+        appendNumber(r.width());
+        _buffer.append("\" h=\"");
+        appendNumber(r.height());
+        _buffer.append("\"/>\n");
     }
     break;
     case QVariant::RectF:
     {
         const QRectF& r(data.value<QRectF>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"/>\n").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+        _buffer.append('<').append(name).append(" x=\"");
+        appendNumber(r.x());
+        _buffer.append("\" y=\"");
+        appendNumber(r.y());
+        _buffer.append("\" w=\"");
+        appendNumber(r.width());
+        _buffer.append("\" h=\"");
+        appendNumber(r.height());
+        _buffer.append("\"/>\n");
     }
     break;
     case QVariant::PointF:
     {
         const QPointF& p(data.value<QPointF>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\"/>\n").arg(name).arg(p.x()).arg(p.y());
+        _buffer.append('<').append(name).append(" x=\"");
+        appendNumber(p.x());
+        _buffer.append("\" y=\"");
+        appendNumber(p.y());
+        _buffer.append("\"/>\n");
     }
     break;
     case QVariant::SizeF:
     {
         const QSizeF& p(data.value<QSizeF>());
-        *this << QString("<%1 w=\"%2\" h=\"%3\"/>\n").arg(name).arg(p.width()).arg(p.height());
+        _buffer.append('<').append(name).append(" w=\"");
+        appendNumber(p.width());
+        _buffer.append("\" h=\"");
+        appendNumber(p.height());
+        _buffer.append("\"/>\n");
     }
     break;
     default: {
         const char* type = data.typeName();
         if (strcmp(type, "Ms::Spatium") == 0) {
-            *this << "<" << name << ">";
-            *this << data.value<Spatium>().val();
-            *this << "</" << ename << ">\n";
+            _buffer.append('<').append(name).append('>');
+            appendNumber(data.value<Spatium>().val());
+            _buffer.append("</").append(ename).append(">\n");
         } else if (strcmp(type, "Ms::Fraction") == 0) {
+            // the closing tag repeats the attributes, as it always did
             const Fraction& f = data.value<Fraction>();
-            *this << QString("<%1>%2/%3</%1>\n").arg(name).arg(f.numerator()).arg(f.denominator());
+            _buffer.append('<').append(name).append('>');
+            appendNumber(f.numerator());
+            _buffer.append('/');
+            appendNumber(f.denominator());
+            _buffer.append("</").append(name).append(">\n");
         } else if (strcmp(type, "Ms::Direction") == 0) {
-            *this << QString("<%1>%2</%1>\n").arg(name, toString(data.value<Direction>()));
+            _buffer.append('<').append(name).append('>');
+            _buffer.append(toString(data.value<Direction>()).toUtf8());
+            _buffer.append("</").append(name).append(">\n");
         } else if (strcmp(type, "Ms::Align") == 0) {
             // TODO: remove from here? (handled in Ms::propertyWritableValue())
             Align a = Align(data.toInt());
@@ -303,14 +483,16 @@ void XmlWriter::tag(const QString& name, QVariant data)
             } else {
                 v = "top";
             }
-            *this << QString("<%1>%2,%3</%1>\n").arg(name)
-                .arg(h, v);
+            _buffer.append('<').append(name).append('>');
+            _buffer.append(h).append(',').append(v);
+            _buffer.append("</").append(name).append(">\n");
         } else {
             qFatal("XmlWriter::tag: unsupported type %d %s", data.type(), type);
         }
     }
     break;
     }
+    flushIfTopLevel();
 }
 
 void XmlWriter::tag(const char* name, const QWidget* g)
@@ -325,7 +507,7 @@ void XmlWriter::tag(const char* name, const QWidget* g)
 void XmlWriter::comment(const QString& text)
 {
     putLevel();
-    *this << "<!-- " << text << " -->" << Qt::endl;
+    _buffer.append("<!-- ").append(text.toUtf8()).append(" -->\n");
 }
 
 //---------------------------------------------------------
@@ -375,24 +557,22 @@ void XmlWriter::dump(int len, const unsigned char* p)
 {
     putLevel();
     int col = 0;
-    setFieldWidth(5);
-    setNumberFlags(numberFlags() | QTextStream::ShowBase);
-    setIntegerBase(16);
+    char hex[8];
+    char buffer[16];
     for (int i = 0; i < len; ++i, ++col) {
         if (col >= 16) {
-            setFieldWidth(0);
-            *this << Qt::endl;
+            _buffer.append('\n');
             col = 0;
             putLevel();
-            setFieldWidth(5);
         }
-        *this << (p[i] & 0xff);
+        // hex with base prefix, right aligned in 5 columns
+        snprintf(hex, sizeof(hex), "0x%x", p[i] & 0xff);
+        int n = snprintf(buffer, sizeof(buffer), "%5s", hex);
+        append(buffer, n);
     }
     if (col) {
-        *this << Qt::endl << Qt::dec;
+        _buffer.append('\n');
     }
-    setFieldWidth(0);
-    setIntegerBase(10);
 }
 
 //---------------------------------------------------------
@@ -402,7 +582,8 @@ void XmlWriter::dump(int len, const unsigned char* p)
 
 void XmlWriter::writeXml(const QString& name, QString s)
 {
-    QString ename(name.split(' ')[0]);
+    const QByteArray b = name.toUtf8();
+    const int space = b.indexOf(' ');
     putLevel();
     for (int i = 0; i < s.size(); ++i) {
         ushort c = s.at(i).unicode();
@@ -410,9 +591,9 @@ void XmlWriter::writeXml(const QString& name, QString s)
             s[i] = '?';
         }
     }
-    *this << "<" << name << ">";
-    *this << s;
-    *this << "</" << ename << ">\n";
+    _buffer.append('<').append(b).append('>');
+    _buffer.append(s.toUtf8());
+    _buffer.append("</").append(space < 0 ? b : b.left(space)).append(">\n");
 }
 
 //---------------------------------------------------------
@@ -27,6 +27,7 @@
 #include "iexcerptnotation.h"
 #include "retval.h"
 #include "io/path.h"
+#include "async/channel.h"
 
 namespace mu::notation {
 using ExcerptNotationList = std::vector<IExcerptNotationPtr>;
@@ -44,9 +45,16 @@ public:
     virtual Ret createNew(const ScoreCreateOptions& scoreInfo) = 0;
     virtual RetVal<bool> created() const = 0;
 
+    //! NOTE .mscz/.mscx files are written in the background: save() returns
+    //! once the score is serialized, saveFinished() sends the result of the write
     virtual Ret save(const io::path& path = io::path(), SaveMode saveMode = SaveMode::Save) = 0;
+    virtual async::Channel<Ret> saveFinished() const = 0;
     virtual ValNt<bool> needSave() const = 0;
 
+    //! NOTE The autosave file is written in the background
+    virtual bool needAutosave() const = 0;
+    virtual void autosave(const io::path& path) = 0;
+
     virtual ValCh<ExcerptNotationList> excerpts() const = 0;
     virtual void setExcerpts(const ExcerptNotationList& excerpts) = 0;
 
@@ -146,6 +146,9 @@ public:
 
     virtual int notePlayDurationMilliseconds() const = 0;
     virtual void setNotePlayDurationMilliseconds(int durationMs) = 0;
+
+    virtual bool isScoreCacheEnabled() const = 0;
+    virtual void setIsScoreCacheEnabled(bool enabled) = 0;
 };
 }
 
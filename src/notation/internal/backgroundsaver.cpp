@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "backgroundsaver.h"
+
+#include "async/async.h"
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+BackgroundSaver::~BackgroundSaver()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_jobAdded.notify_all();
+
+    //! NOTE pending jobs are still written, the file must not be lost on exit
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void BackgroundSaver::save(Ms::MscSnapshot snapshot, const QString& path, const QString& backupDir,
+                           const async::Asyncable* receiver, const Finished& finished)
+{
+    Job job;
+    job.snapshot = std::move(snapshot);
+    job.path = path;
+    job.backupDir = backupDir;
+    job.receiver = receiver;
+    job.finished = finished;
+    job.callerThreadId = std::this_thread::get_id();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+        if (!m_thread.joinable()) {
+            m_thread = std::thread([this]() { run(); });
+        }
+    }
+    m_jobAdded.notify_one();
+}
+
+bool BackgroundSaver::isBusy() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_working || !m_jobs.empty();
+}
+
+void BackgroundSaver::waitForFinished()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this]() { return !m_working && m_jobs.empty(); });
+}
+
+void BackgroundSaver::run()
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAdded.wait(lock, [this]() { return m_quit || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_working = true;
+        }
+
+        QString error;
+        Ret ret = make_ret(Ret::Code::Ok);
+        if (!job.snapshot.saveFile(job.path, job.backupDir, &error)) {
+            ret = make_ret(Ret::Code::UnknownError, error.toStdString());
+        }
+
+        if (job.finished) {
+            Finished finished = job.finished;
+            async::Async::call(job.receiver, [finished, ret]() {
+                finished(ret);
+            }, job.callerThreadId);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_working = false;
+        }
+        m_jobDone.notify_all();
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_BACKGROUNDSAVER_H
+#define MU_NOTATION_BACKGROUNDSAVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <QString>
+
+#include "async/asyncable.h"
+#include "libmscore/mscsnapshot.h"
+#include "ret.h"
+
+namespace mu::notation {
+//! NOTE Writes score snapshots (compression, thumbnail encoding, fsync)
+//! on a worker thread. Jobs are done in the order they were queued,
+//! the finished callback is invoked on the thread that queued the job.
+class BackgroundSaver
+{
+public:
+    using Finished = std::function<void (const Ret&)>;
+
+    BackgroundSaver() = default;
+    BackgroundSaver(const BackgroundSaver&) = delete;
+    BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+    ~BackgroundSaver();
+
+    void save(Ms::MscSnapshot snapshot, const QString& path, const QString& backupDir, const async::Asyncable* receiver,
+              const Finished& finished);
+
+    bool isBusy() const;
+    void waitForFinished();
+
+private:
+    struct Job {
+        Ms::MscSnapshot snapshot;
+        QString path;
+        QString backupDir;
+        const async::Asyncable* receiver = nullptr;
+        Finished finished;
+        std::thread::id callerThreadId;
+    };
+
+    void run();
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAdded;
+    std::condition_variable m_jobDone;
+    std::deque<Job> m_jobs;
+    bool m_working = false;
+    bool m_quit = false;
+};
+}
+
+#endif // MU_NOTATION_BACKGROUNDSAVER_H
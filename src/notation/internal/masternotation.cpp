@@ -96,6 +96,10 @@ Ms::MasterScore* MasterNotation::masterScore() const
 mu::Ret MasterNotation::load(const io::path& path, const INotationReaderPtr& reader)
 {
     TRACEFUNC;
+    framework::TraceSpan span("load");
+    if (span.isActive()) {
+        span.arg("path", path.toStdString());
+    }
 
     Ms::ScoreLoad sl;
 
@@ -514,13 +518,19 @@ mu::RetVal<bool> MasterNotation::created() const
 
 mu::Ret MasterNotation::save(const io::path& path, SaveMode saveMode)
 {
+    framework::TraceSpan span("save");
+    if (span.isActive()) {
+        span.arg("path", path.toStdString());
+        span.arg("mode", static_cast<int64_t>(saveMode));
+    }
+
     switch (saveMode) {
     case SaveMode::SaveSelection:
         return saveSelectionOnScore(path);
     case SaveMode::Save:
     case SaveMode::SaveAs:
     case SaveMode::SaveCopy:
-        return saveScore(path);
+        return saveScore(path, saveMode);
     case SaveMode::SaveOnline:
         return make_ret(Ret::Code::NotSupported);
     }
@@ -528,8 +538,18 @@ mu::Ret MasterNotation::save(const io::path& path, SaveMode saveMode)
     return make_ret(Err::UnknownError);
 }
 
+mu::async::Channel<mu::Ret> MasterNotation::saveFinished() const
+{
+    return m_saveFinished;
+}
+
 mu::Ret MasterNotation::exportScore(const io::path& path, const std::string& suffix)
 {
+    framework::TraceSpan span("export");
+    if (span.isActive()) {
+        span.arg("path", path.toStdString());
+    }
+
     QFile file(path.toQString());
     file.open(QFile::WriteOnly);
 
@@ -667,23 +687,72 @@ mu::Ret MasterNotation::saveScore(const mu::io::path& path, SaveMode saveMode)
         return exportScore(path, suffix);
     }
 
-    io::path oldFilePath = score()->masterScore()->fileInfo()->filePath().toStdString();
+    Ms::MasterScore* score = masterScore();
+    io::path oldFilePath = score->fileInfo()->filePath().toStdString();
 
     if (!path.empty()) {
-        score()->masterScore()->fileInfo()->setFile(path.toQString());
+        score->fileInfo()->setFile(path.toQString());
     }
 
-    Ret ret = score()->masterScore()->saveFile(true);
-    if (!ret) {
+    //! NOTE Only the serialization is done here, compression and writing
+    //! are done in the background while the score can be edited
+    Ms::MscSnapshot snapshot;
+    if (!score->createSaveSnapshot(snapshot)) {
+        Ret ret = make_ret(Err::UnknownError);
         ret.setText(Ms::MScore::lastError.toStdString());
-    } else if (saveMode != SaveMode::SaveCopy || oldFilePath == path) {
-        score()->setCreated(false);
-        undoStack()->stackChanged().notify();
+        return ret;
     }
 
+    //! NOTE a pending save of this session already makes the backup
+    const QString backupDir = m_pendingSaves > 0 ? QString() : score->saveBackupDir(true);
+    const int undoState = score->undoStack()->state();
+    const bool isCopy = saveMode == SaveMode::SaveCopy && oldFilePath != path;
+
+    ++m_pendingSaves;
+    m_saver.save(std::move(snapshot), score->fileInfo()->filePath(), backupDir, this,
+                 [this, backupDir, undoState, isCopy](const Ret& ret) {
+        --m_pendingSaves;
+        if (!ret) {
+            LOGE() << "save failed: " << ret.text();
+            m_saveFinished.send(ret);
+            return;
+        }
+
+        masterScore()->setSaveFinished(backupDir, undoState);
+        if (!isCopy) {
+            masterScore()->setCreated(false);
+        }
+        undoStack()->stackChanged().notify();
+        m_saveFinished.send(ret);
+    });
+
     return make_ret(Ret::Code::Ok);
 }
 
+bool MasterNotation::needAutosave() const
+{
+    return masterScore()->autosaveDirty();
+}
+
+void MasterNotation::autosave(const io::path& path)
+{
+    Ms::MasterScore* score = masterScore();
+    QString rootFile = score->fileInfo()->completeBaseName();
+    if (rootFile.isEmpty()) {
+        rootFile = "score";
+    }
+
+    Ms::MscSnapshot snapshot = score->createSnapshot(rootFile + ".mscx", false, false);
+    score->setAutosaveDirty(false);
+
+    m_saver.save(std::move(snapshot), path.toQString(), QString(), this, [this, path](const Ret& ret) {
+        if (!ret) {
+            LOGE() << "autosave to " << path << " failed: " << ret.text();
+            masterScore()->setAutosaveDirty(true);
+        }
+    });
+}
+
 mu::Ret MasterNotation::saveSelectionOnScore(const mu::io::path& path)
 {
     QFileInfo fileInfo(path.toQString());
@@ -30,6 +30,7 @@
 
 #include "modularity/ioc.h"
 #include "notation.h"
+#include "backgroundsaver.h"
 #include "retval.h"
 
 namespace Ms {
@@ -56,8 +57,12 @@ public:
     RetVal<bool> created() const override;
 
     Ret save(const io::path& path = io::path(), SaveMode saveMode = SaveMode::Save) override;
+    async::Channel<Ret> saveFinished() const override;
     mu::ValNt<bool> needSave() const override;
 
+    bool needAutosave() const override;
+    void autosave(const io::path& path) override;
+
     ValCh<ExcerptNotationList> excerpts() const override;
     void setExcerpts(const ExcerptNotationList& excerpts) override;
 
@@ -87,6 +92,9 @@ private:
 
     ValCh<ExcerptNotationList> m_excerpts;
     INotationPartsPtr m_parts;
+    BackgroundSaver m_saver;
+    int m_pendingSaves = 0;
+    async::Channel<Ret> m_saveFinished;
 };
 }
 
@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "msczmetacache.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "log.h"
+
+using namespace mu::notation;
+
+static const quint32 CACHE_MAGIC = 0x4d534d43; // "MSMC"
+static const quint32 CACHE_VERSION = 1;
+
+//! NOTE: the oldest entries are dropped when there are more, the recent scores and
+//! templates lists never get close to this
+static const int MAX_CACHE_ENTRIES = 1000;
+
+static QDataStream& operator<<(QDataStream& stream, const Meta& meta)
+{
+    stream << meta.fileName.toQString()
+           << meta.title
+           << meta.subtitle
+           << meta.composer
+           << meta.lyricist
+           << meta.copyright
+           << meta.translator
+           << meta.arranger
+           << quint64(meta.partsCount)
+           << meta.thumbnailData
+           << meta.creationDate;
+
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, Meta& meta)
+{
+    QString fileName;
+    quint64 partsCount = 0;
+
+    stream >> fileName
+    >> meta.title
+    >> meta.subtitle
+    >> meta.composer
+    >> meta.lyricist
+    >> meta.copyright
+    >> meta.translator
+    >> meta.arranger
+    >> partsCount
+    >> meta.thumbnailData
+    >> meta.creationDate;
+
+    meta.fileName = fileName;
+    meta.partsCount = static_cast<size_t>(partsCount);
+
+    return stream;
+}
+
+MsczMetaCache::MsczMetaCache(const io::path& cacheFilePath)
+    : m_cacheFilePath(cacheFilePath)
+{
+}
+
+void MsczMetaCache::setCacheFilePath(const io::path& cacheFilePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_cacheFilePath == cacheFilePath) {
+        return;
+    }
+
+    m_cacheFilePath = cacheFilePath;
+    m_entries.clear();
+    m_order.clear();
+    m_loaded = false;
+    m_dirty = false;
+}
+
+bool MsczMetaCache::find(const io::path& filePath, qint64 fileSize, const QDateTime& lastModified, Meta& meta) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.constFind(filePath.toQString());
+    if (it == m_entries.constEnd()) {
+        return false;
+    }
+
+    if (it->fileSize != fileSize || it->lastModified != lastModified.toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    meta = it->meta;
+    meta.filePath = filePath;
+
+    return true;
+}
+
+void MsczMetaCache::insert(const io::path& filePath, qint64 fileSize, const QDateTime& lastModified, const Meta& meta)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Entry entry;
+    entry.fileSize = fileSize;
+    entry.lastModified = lastModified.toMSecsSinceEpoch();
+    entry.meta = meta;
+
+    const QString key = filePath.toQString();
+    if (m_entries.contains(key)) {
+        m_order.removeOne(key);
+    } else if (m_entries.size() >= MAX_CACHE_ENTRIES) {
+        m_entries.remove(m_order.takeFirst());
+    }
+
+    m_entries.insert(key, entry);
+    m_order.append(key);
+    m_dirty = true;
+}
+
+void MsczMetaCache::load()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_loaded || m_cacheFilePath.empty()) {
+        return;
+    }
+
+    m_loaded = true;
+
+    QFile file(m_cacheFilePath.toQString());
+    if (!file.exists()) {
+        return;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        LOGW() << "Can't open meta cache: " << m_cacheFilePath;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    stream >> magic >> version >> count;
+
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || count < 0) {
+        LOGD() << "Meta cache has an unknown format, ignored: " << m_cacheFilePath;
+        return;
+    }
+
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString filePath;
+        Entry entry;
+        stream >> filePath >> entry.fileSize >> entry.lastModified >> entry.meta;
+
+        if (stream.status() == QDataStream::Ok) {
+            entry.meta.filePath = filePath;
+            if (m_entries.contains(filePath)) {
+                m_order.removeOne(filePath);
+            }
+            m_entries.insert(filePath, entry);
+            m_order.append(filePath);
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        LOGW() << "Meta cache is corrupted, ignored: " << m_cacheFilePath;
+        m_entries.clear();
+        m_order.clear();
+    }
+}
+
+void MsczMetaCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_dirty || m_cacheFilePath.empty()) {
+        return;
+    }
+
+    QDir().mkpath(io::dirpath(m_cacheFilePath).toQString());
+
+    QSaveFile file(m_cacheFilePath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGW() << "Can't write meta cache: " << m_cacheFilePath;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    stream << CACHE_MAGIC << CACHE_VERSION << qint32(m_entries.size());
+
+    //! NOTE: written oldest first, so that load() restores the eviction order
+    for (const QString& key : m_order) {
+        const Entry& entry = m_entries[key];
+        stream << key << entry.fileSize << entry.lastModified << entry.meta;
+    }
+
+    if (!file.commit()) {
+        LOGW() << "Can't write meta cache: " << m_cacheFilePath;
+        return;
+    }
+
+    m_dirty = false;
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_MSCZMETACACHE_H
+#define MU_NOTATION_MSCZMETACACHE_H
+
+#include <mutex>
+
+#include <QHash>
+#include <QList>
+#include <QDateTime>
+
+#include "io/path.h"
+#include "notationtypes.h"
+
+namespace mu::notation {
+//! NOTE: Persistent cache of the score meta data (title, composer, parts, thumbnail)
+//! read by MsczMetaReader. An entry is valid as long as the size and the modification
+//! time of the score file did not change.
+class MsczMetaCache
+{
+public:
+    explicit MsczMetaCache(const io::path& cacheFilePath = io::path());
+
+    void setCacheFilePath(const io::path& cacheFilePath);
+
+    bool find(const io::path& filePath, qint64 fileSize, const QDateTime& lastModified, Meta& meta) const;
+    void insert(const io::path& filePath, qint64 fileSize, const QDateTime& lastModified, const Meta& meta);
+
+    void load();
+    void save();
+
+private:
+    struct Entry {
+        qint64 fileSize = 0;
+        qint64 lastModified = 0;
+        Meta meta;
+    };
+
+    io::path m_cacheFilePath;
+    QHash<QString, Entry> m_entries;
+    QList<QString> m_order; // keys of m_entries, oldest insertion first
+    bool m_loaded = false;
+    bool m_dirty = false;
+    mutable std::mutex m_mutex;
+};
+}
+
+#endif // MU_NOTATION_MSCZMETACACHE_H
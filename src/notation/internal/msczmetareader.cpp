@@ -21,9 +21,12 @@
  */
 #include "msczmetareader.h"
 
+#include <memory>
 #include <sstream>
 
-#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent>
 
 #include "log.h"
 #include "stringutils.h"
@@ -37,13 +40,23 @@ using namespace mu::notation;
 using namespace mu::framework;
 using namespace mu::system;
 
+static const QString META_CACHE_FILE_NAME("/scoremetacache.dat");
+
 MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
 {
-    MetaList result;
+    m_cache.setCacheFilePath(globalConfiguration()->dataPath() + META_CACHE_FILE_NAME);
+    m_cache.load();
+
+    //! NOTE: the files are independent, read them in parallel
+    QList<io::path> paths(filePaths.cbegin(), filePaths.cend());
+    std::function<RetVal<Meta>(const io::path&)> read = [this](const io::path& path) {
+        return readMeta(path);
+    };
+    QList<RetVal<Meta> > metas = QtConcurrent::blockingMapped<QList<RetVal<Meta> > >(paths, read);
 
-    for (const io::path& path: filePaths) {
-        RetVal<Meta> meta = readMeta(path);
+    MetaList result;
 
+    for (const RetVal<Meta>& meta : metas) {
         if (!meta.ret) {
             LOGE() << meta.ret.toString();
             continue;
@@ -52,6 +65,8 @@ MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
         result.push_back(meta.val);
     }
 
+    m_cache.save();
+
     return result;
 }
 
@@ -59,12 +74,19 @@ mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
 {
     RetVal<Meta> meta;
 
-    if (!fileSystem()->exists(filePath)) {
+    //! NOTE: called from worker threads, so the file system service is not used here
+    QFileInfo fileInfo(filePath.toQString());
+    if (!fileInfo.exists()) {
         LOGE() << "File not exists: " << filePath;
         meta.ret = make_ret(Err::FileNotFound);
         return meta;
     }
 
+    if (m_cache.find(filePath, fileInfo.size(), fileInfo.lastModified(), meta.val)) {
+        meta.ret = make_ret(Err::NoError);
+        return meta;
+    }
+
     bool compressed = io::syffix(filePath) == "mscz";
 
     if (compressed) {
@@ -80,6 +102,10 @@ mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
 
     meta.val.filePath = filePath;
 
+    if (meta.ret) {
+        m_cache.insert(filePath, fileInfo.size(), fileInfo.lastModified(), meta.val);
+    }
+
     return meta;
 }
 
@@ -87,15 +113,13 @@ mu::RetVal<Meta> MsczMetaReader::loadCompressedMsc(const io::path& filePath) con
 {
     RetVal<Meta> meta;
 
-    RetVal<QByteArray> data = fileSystem()->readFile(filePath);
-    if (!data.ret) {
-        meta.ret = data.ret;
+    QFile file(filePath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        meta.ret = make_ret(Err::FileOpenError);
         return meta;
     }
 
-    QBuffer buffer(&data.val);
-
-    MQZipReader zipReader(&buffer);
+    MQZipReader zipReader(&file);
 
     io::path rootFile = readRootFile(&zipReader);
     if (rootFile.empty()) {
@@ -103,21 +127,29 @@ mu::RetVal<Meta> MsczMetaReader::loadCompressedMsc(const io::path& filePath) con
         return meta;
     }
 
-    QByteArray rootBuffer = zipReader.fileData(rootFile.toQString());
-    if (rootBuffer.isEmpty()) {
+    //! NOTE: the root file is inflated while it is parsed, parsing stops at the
+    //! first <Staff>, so the music itself is never inflated
+    std::unique_ptr<QIODevice> rootDevice(zipReader.fileDevice(rootFile.toQString()));
+    if (!rootDevice) {
         auto fil = zipReader.fileInfoList();
         for (const MQZipReader::FileInfo& fi : fil) {
             if (mu::strings::endsWith(fi.filePath.toStdString(), ".mscx")) {
-                rootBuffer = zipReader.fileData(fi.filePath);
+                rootDevice.reset(zipReader.fileDevice(fi.filePath));
                 break;
             }
         }
     }
 
-    framework::XmlReader xmlReader(rootBuffer);
+    if (!rootDevice || !rootDevice->open(QIODevice::ReadOnly)) {
+        meta.ret = make_ret(Err::FileNoRootFile);
+        return meta;
+    }
+
+    framework::XmlReader xmlReader(rootDevice.get());
     meta = doReadMeta(xmlReader);
+    rootDevice->close();
 
-    meta.val.thumbnail = loadThumbnail(&zipReader);
+    meta.val.thumbnailData = loadThumbnail(&zipReader);
 
     return meta;
 }
@@ -215,6 +247,8 @@ MsczMetaReader::RawMeta MsczMetaReader::doReadRawMeta(framework::XmlReader& xmlR
                 xmlReader.skipCurrentElement();
             }
         } else if (tag == "Staff") {
+            meta.isComplete = true;
+
             if (meta.titleStyle.isEmpty()) {
                 while (xmlReader.readNextStartElement()) {
                     std::string boxTag(xmlReader.tagName());
@@ -240,6 +274,8 @@ MsczMetaReader::RawMeta MsczMetaReader::doReadRawMeta(framework::XmlReader& xmlR
             } else {
                 xmlReader.skipCurrentElement();
             }
+
+            break;
         } else if (tag == "Part") {
             meta.partsCount++;
             xmlReader.skipCurrentElement();
@@ -266,11 +302,18 @@ mu::RetVal<Meta> MsczMetaReader::doReadMeta(framework::XmlReader& xmlReader) con
                 while (xmlReader.readNextStartElement()) {
                     if (xmlReader.tagName() == "Score") {
                         rawMeta = doReadRawMeta(xmlReader);
+                        if (rawMeta.isComplete) {
+                            break;
+                        }
                     } else {
                         xmlReader.skipCurrentElement();
                     }
                 }
             }
+
+            if (rawMeta.isComplete) {
+                break;
+            }
         } else {
             xmlReader.skipCurrentElement();
         }
@@ -358,19 +401,16 @@ mu::io::path MsczMetaReader::readRootFile(MQZipReader* zipReader) const
     return rootFile;
 }
 
-QPixmap MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
+QByteArray MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
 {
+    //! NOTE: the thumbnail is decoded only when it is shown
     QByteArray thumbnailBuffer = zipReader->fileData("Thumbnails/thumbnail.png");
 
     if (thumbnailBuffer.isEmpty()) {
         LOGD() << "Can't find thumbnail";
-        return QPixmap();
     }
 
-    QPixmap thumbnail;
-    thumbnail.loadFromData(thumbnailBuffer, "PNG");
-
-    return thumbnail;
+    return thumbnailBuffer;
 }
 
 QString MsczMetaReader::formatFromXml(const std::string& xml) const
@@ -25,7 +25,9 @@
 #include "imsczmetareader.h"
 
 #include "system/ifilesystem.h"
+#include "iglobalconfiguration.h"
 #include "modularity/ioc.h"
+#include "msczmetacache.h"
 
 namespace mu::framework {
 class XmlReader;
@@ -37,6 +39,7 @@ namespace mu::notation {
 class MsczMetaReader : public IMsczMetaReader
 {
     INJECT(notation, system::IFileSystem, fileSystem)
+    INJECT(notation, framework::IGlobalConfiguration, globalConfiguration)
 
 public:
     MetaList readMetaList(const io::paths& filePaths) const override;
@@ -68,13 +71,17 @@ private:
         QString creationDate;
 
         size_t partsCount = 0;
+
+        //! NOTE: all meta data is stored before the first staff,
+        //! the rest of the file doesn't need to be parsed
+        bool isComplete = false;
     };
 
     RetVal<Meta> doReadMeta(framework::XmlReader& xmlReader) const;
     RawMeta doReadBox(framework::XmlReader& xmlReader) const;
     RetVal<Meta> loadCompressedMsc(const io::path& filePath) const;
     io::path readRootFile(MQZipReader* zipReader) const;
-    QPixmap loadThumbnail(MQZipReader* zipReader) const;
+    QByteArray loadThumbnail(MQZipReader* zipReader) const;
     RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
@@ -85,6 +92,8 @@ private:
 
     QString readText(framework::XmlReader& xmlReader) const;
     QString readMetaTagText(framework::XmlReader& xmlReader) const;
+
+    mutable MsczMetaCache m_cache;
 };
 }
 
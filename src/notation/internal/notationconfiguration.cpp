@@ -23,6 +23,7 @@
 
 #include "libmscore/preferences.h"
 #include "libmscore/mscore.h"
+#include "libmscore/scorecache.h"
 
 #include "log.h"
 #include "settings.h"
@@ -79,6 +80,7 @@ static const Settings::Key ADVANCE_TO_NEXT_NOTE_ON_KEY_RELEASE(module_name, "io/
 static const Settings::Key COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE(module_name, "score/note/warnPitchRange");
 static const Settings::Key REALTIME_DELAY(module_name, "io/midi/realtimeDelay");
 static const Settings::Key NOTE_DEFAULT_PLAY_DURATION(module_name, "score/note/defaultPlayDuration");
+static const Settings::Key SCORE_CACHE_ENABLED(module_name, "application/scoreCache/enabled");
 
 static const Settings::Key VOICE1_COLOR_KEY(module_name, "ui/score/voice1/color");
 static const Settings::Key VOICE2_COLOR_KEY(module_name, "ui/score/voice2/color");
@@ -156,6 +158,7 @@ void NotationConfiguration::init()
     settings()->setDefaultValue(COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE, Val(true));
     settings()->setDefaultValue(REALTIME_DELAY, Val(750));
     settings()->setDefaultValue(NOTE_DEFAULT_PLAY_DURATION, Val(300));
+    settings()->setDefaultValue(SCORE_CACHE_ENABLED, Val(false));
 
     std::vector<std::pair<Settings::Key, QColor> > voicesColors {
         { VOICE1_COLOR_KEY, QColor(0x0065BF) },
@@ -183,6 +186,7 @@ void NotationConfiguration::init()
 
     Ms::MScore::warnPitchRange = colorNotesOusideOfUsablePitchRange();
     Ms::MScore::defaultPlayDuration = notePlayDurationMilliseconds();
+    Ms::ScoreCache::setCacheDirectory(isScoreCacheEnabled() ? scoreCachePath() : QString());
 }
 
 QColor NotationConfiguration::anchorLineColor() const
@@ -597,3 +601,19 @@ void NotationConfiguration::setNotePlayDurationMilliseconds(int durationMs)
     Ms::MScore::defaultPlayDuration = durationMs;
     settings()->setValue(NOTE_DEFAULT_PLAY_DURATION, Val(durationMs));
 }
+
+QString NotationConfiguration::scoreCachePath() const
+{
+    return globalConfiguration()->dataPath().toQString() + "/scorecache";
+}
+
+bool NotationConfiguration::isScoreCacheEnabled() const
+{
+    return settings()->value(SCORE_CACHE_ENABLED).toBool();
+}
+
+void NotationConfiguration::setIsScoreCacheEnabled(bool enabled)
+{
+    Ms::ScoreCache::setCacheDirectory(enabled ? scoreCachePath() : QString());
+    settings()->setValue(SCORE_CACHE_ENABLED, Val(enabled));
+}
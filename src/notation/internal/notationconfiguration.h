@@ -150,11 +150,16 @@ public:
     int notePlayDurationMilliseconds() const override;
     void setNotePlayDurationMilliseconds(int durationMs) override;
 
+    bool isScoreCacheEnabled() const override;
+    void setIsScoreCacheEnabled(bool enabled) override;
+
 private:
     std::vector<std::string> parseToolbarActions(const std::string& actions) const;
 
     framework::Settings::Key toolbarSettingsKey(const std::string& toolbarName) const;
 
+    QString scoreCachePath() const;
+
     async::Notification m_backgroundChanged;
     async::Notification m_foregroundChanged;
     async::Channel<int> m_currentZoomChanged;
@@ -236,7 +236,7 @@ struct Meta
     QString translator;
     QString arranger;
     size_t partsCount = 0;
-    QPixmap thumbnail;
+    QByteArray thumbnailData; // PNG, decoded when shown
     QDate creationDate;
 
     QString source;
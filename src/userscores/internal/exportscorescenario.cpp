@@ -283,7 +283,16 @@ bool ExportScoreScenario::doExportLoop(const io::path& scorePath, std::function<
             }
         }
 
-        if (!exportFunction(outputFile)) {
+        bool ok = false;
+        {
+            TraceSpan span("export");
+            if (span.isActive()) {
+                span.arg("path", scorePath.toStdString());
+            }
+            ok = exportFunction(outputFile);
+        }
+
+        if (!ok) {
             outputFile.close();
             if (askForRetry(filename)) {
                 continue;
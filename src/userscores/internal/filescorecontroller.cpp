@@ -267,6 +267,14 @@ void FileScoreController::doSaveScore(const io::path& filePath, SaveMode saveMod
 {
     io::path oldPath = currentMasterNotation()->metaInfo().filePath;
 
+    //! NOTE the file is written in the background, a failed write is reported here
+    currentMasterNotation()->saveFinished().onReceive(this, [this](const Ret& ret) {
+        if (!ret) {
+            LOGE() << ret.toString();
+            interactive()->error(trc("userscores", "Your score could not be saved"), ret.text());
+        }
+    });
+
     Ret ret = currentMasterNotation()->save(filePath, saveMode);
     if (!ret) {
         LOGE() << ret.toString();
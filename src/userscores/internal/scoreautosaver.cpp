@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scoreautosaver.h"
+
+#include <algorithm>
+
+#include <QCryptographicHash>
+#include <QUuid>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::userscores;
+using namespace mu::notation;
+
+static constexpr int MS_PER_MINUTE = 60 * 1000;
+
+void ScoreAutoSaver::init()
+{
+    QObject::connect(&m_timer, &QTimer::timeout, [this]() {
+        onTrySave();
+    });
+
+    configuration()->autoSaveEnabledChanged().onReceive(this, [this](bool) {
+        updateTimer();
+    });
+
+    configuration()->autoSaveIntervalChanged().onReceive(this, [this](int) {
+        updateTimer();
+    });
+
+    globalContext()->masterNotationRemoved().onReceive(this, [this](const IMasterNotationPtr& notation) {
+        removeAutoSave(notation.get());
+    });
+
+    updateTimer();
+}
+
+void ScoreAutoSaver::updateTimer()
+{
+    int minutes = configuration()->autoSaveIntervalMinutes();
+    if (!configuration()->isAutoSaveEnabled() || minutes <= 0) {
+        m_timer.stop();
+        return;
+    }
+
+    m_timer.start(minutes * MS_PER_MINUTE);
+}
+
+void ScoreAutoSaver::onTrySave()
+{
+    TRACEFUNC;
+
+    for (const IMasterNotationPtr& notation : globalContext()->masterNotations()) {
+        io::path path = autoSavePath(notation);
+        AutoSave& autoSave = m_autoSaves[notation.get()];
+
+        //! NOTE the score got a file, the autosave under the old name is outdated
+        if (!autoSave.path.empty() && autoSave.path != path && fileSystem()->exists(autoSave.path)) {
+            fileSystem()->remove(autoSave.path);
+        }
+        autoSave.path = path;
+
+        if (!notation->needSave().val) {
+            //! NOTE the score was saved, the autosave file is outdated
+            if (fileSystem()->exists(path)) {
+                fileSystem()->remove(path);
+            }
+            continue;
+        }
+
+        if (!notation->needAutosave()) {
+            continue;
+        }
+
+        notation->autosave(path);
+    }
+
+    //! NOTE a score may have been opened again since it was closed
+    for (const io::path& path : m_closedPaths) {
+        bool isOpen = std::any_of(m_autoSaves.cbegin(), m_autoSaves.cend(), [&path](const auto& autoSave) {
+            return autoSave.second.path == path;
+        });
+        if (!isOpen && fileSystem()->exists(path)) {
+            fileSystem()->remove(path);
+        }
+    }
+    m_closedPaths.clear();
+}
+
+void ScoreAutoSaver::removeAutoSave(const IMasterNotation* notation)
+{
+    auto it = m_autoSaves.find(notation);
+    if (it == m_autoSaves.end()) {
+        return;
+    }
+
+    const io::path& path = it->second.path;
+    if (!path.empty()) {
+        if (fileSystem()->exists(path)) {
+            fileSystem()->remove(path);
+        }
+        m_closedPaths.push_back(path);
+    }
+    m_autoSaves.erase(it);
+}
+
+io::path ScoreAutoSaver::autoSavePath(const IMasterNotationPtr& notation)
+{
+    QString name = notation->path().toQString();
+    if (name.isEmpty()) {
+        QString& id = m_autoSaves[notation.get()].id;
+        if (id.isEmpty()) {
+            id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        }
+        name = id;
+    }
+
+    QByteArray hash = QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Md5).toHex();
+    return configuration()->autoSavePath() + "/" + QString::fromLatin1(hash) + ".mscz";
+}
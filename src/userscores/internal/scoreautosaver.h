@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_USERSCORES_SCOREAUTOSAVER_H
+#define MU_USERSCORES_SCOREAUTOSAVER_H
+
+#include <map>
+
+#include <QString>
+#include <QTimer>
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "context/iglobalcontext.h"
+#include "system/ifilesystem.h"
+#include "iuserscoresconfiguration.h"
+
+namespace mu::userscores {
+//! NOTE Periodically writes the open scores with unsaved changes
+//! into the autosave directory. The scores are only serialized
+//! on the main thread, the files are written in the background.
+//! The autosave file of a score is removed when the score is saved
+//! or closed.
+class ScoreAutoSaver : public async::Asyncable
+{
+    INJECT(userscores, context::IGlobalContext, globalContext)
+    INJECT(userscores, IUserScoresConfiguration, configuration)
+    INJECT(userscores, system::IFileSystem, fileSystem)
+
+public:
+    void init();
+
+private:
+    struct AutoSave {
+        QString id;         // of a score without a file, stable while it is open
+        io::path path;      // last autosave file written
+    };
+
+    void updateTimer();
+    void onTrySave();
+    void removeAutoSave(const notation::IMasterNotation* notation);
+
+    io::path autoSavePath(const notation::IMasterNotationPtr& notation);
+
+    QTimer m_timer;
+    std::map<const notation::IMasterNotation*, AutoSave> m_autoSaves;
+    io::paths m_closedPaths;        // autosaves of closed scores, a pending write may recreate them
+};
+}
+
+#endif // MU_USERSCORES_SCOREAUTOSAVER_H
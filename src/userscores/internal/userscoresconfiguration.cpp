@@ -35,6 +35,8 @@ static const Settings::Key RECENT_SCORE_PATHS(module_name, "userscores/recentLis
 static const Settings::Key USER_TEMPLATES_PATH(module_name, "application/paths/myTemplates");
 static const Settings::Key USER_SCORES_PATH(module_name, "application/paths/myScores");
 static const Settings::Key PREFERRED_SCORE_CREATION_MODE_KEY(module_name, "userscores/preferredScoreCreationMode");
+static const Settings::Key AUTOSAVE_ENABLED_KEY(module_name, "application/autosave/autosave");
+static const Settings::Key AUTOSAVE_INTERVAL_KEY(module_name, "application/autosave/autosaveTime");
 
 const QString UserScoresConfiguration::DEFAULT_FILE_SUFFIX(".mscz");
 
@@ -60,11 +62,22 @@ void UserScoresConfiguration::init()
     Val preferredScoreCreationMode = Val(static_cast<int>(PreferredScoreCreationMode::FromInstruments));
     settings()->setDefaultValue(PREFERRED_SCORE_CREATION_MODE_KEY, preferredScoreCreationMode);
 
+    settings()->setDefaultValue(AUTOSAVE_ENABLED_KEY, Val(true));
+    settings()->valueChanged(AUTOSAVE_ENABLED_KEY).onReceive(nullptr, [this](const Val& val) {
+        m_autoSaveEnabledChanged.send(val.toBool());
+    });
+
+    settings()->setDefaultValue(AUTOSAVE_INTERVAL_KEY, Val(2));
+    settings()->valueChanged(AUTOSAVE_INTERVAL_KEY).onReceive(nullptr, [this](const Val& val) {
+        m_autoSaveIntervalChanged.send(val.toInt());
+    });
+
     io::paths paths = actualRecentScorePaths();
     setRecentScorePaths(paths);
 
     fileSystem()->makePath(templatesPath().val);
     fileSystem()->makePath(scoresPath().val);
+    fileSystem()->makePath(autoSavePath());
 }
 
 io::path UserScoresConfiguration::mainTemplatesDirPath() const
@@ -212,3 +225,38 @@ void UserScoresConfiguration::setPreferredScoreCreationMode(PreferredScoreCreati
 {
     settings()->setValue(PREFERRED_SCORE_CREATION_MODE_KEY, Val(static_cast<int>(mode)));
 }
+
+bool UserScoresConfiguration::isAutoSaveEnabled() const
+{
+    return settings()->value(AUTOSAVE_ENABLED_KEY).toBool();
+}
+
+void UserScoresConfiguration::setAutoSaveEnabled(bool enabled)
+{
+    settings()->setValue(AUTOSAVE_ENABLED_KEY, Val(enabled));
+}
+
+async::Channel<bool> UserScoresConfiguration::autoSaveEnabledChanged() const
+{
+    return m_autoSaveEnabledChanged;
+}
+
+int UserScoresConfiguration::autoSaveIntervalMinutes() const
+{
+    return settings()->value(AUTOSAVE_INTERVAL_KEY).toInt();
+}
+
+void UserScoresConfiguration::setAutoSaveInterval(int minutes)
+{
+    settings()->setValue(AUTOSAVE_INTERVAL_KEY, Val(minutes));
+}
+
+async::Channel<int> UserScoresConfiguration::autoSaveIntervalChanged() const
+{
+    return m_autoSaveIntervalChanged;
+}
+
+io::path UserScoresConfiguration::autoSavePath() const
+{
+    return globalConfiguration()->dataPath() + "/autosave";
+}
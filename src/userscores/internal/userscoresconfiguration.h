@@ -65,6 +65,16 @@ public:
     PreferredScoreCreationMode preferredScoreCreationMode() const override;
     void setPreferredScoreCreationMode(PreferredScoreCreationMode mode) override;
 
+    bool isAutoSaveEnabled() const override;
+    void setAutoSaveEnabled(bool enabled) override;
+    async::Channel<bool> autoSaveEnabledChanged() const override;
+
+    int autoSaveIntervalMinutes() const override;
+    void setAutoSaveInterval(int minutes) override;
+    async::Channel<int> autoSaveIntervalChanged() const override;
+
+    io::path autoSavePath() const override;
+
 private:
     io::path mainTemplatesDirPath() const;
 
@@ -77,6 +87,8 @@ private:
     async::Channel<io::paths> m_recentScorePathsChanged;
     async::Channel<io::path> m_templatesPathChanged;
     async::Channel<io::path> m_scoresPathChanged;
+    async::Channel<bool> m_autoSaveEnabledChanged;
+    async::Channel<int> m_autoSaveIntervalChanged;
 };
 }
 
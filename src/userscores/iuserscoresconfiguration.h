@@ -64,6 +64,16 @@ public:
 
     virtual PreferredScoreCreationMode preferredScoreCreationMode() const = 0;
     virtual void setPreferredScoreCreationMode(PreferredScoreCreationMode mode) = 0;
+
+    virtual bool isAutoSaveEnabled() const = 0;
+    virtual void setAutoSaveEnabled(bool enabled) = 0;
+    virtual async::Channel<bool> autoSaveEnabledChanged() const = 0;
+
+    virtual int autoSaveIntervalMinutes() const = 0;
+    virtual void setAutoSaveInterval(int minutes) = 0;
+    virtual async::Channel<int> autoSaveIntervalChanged() const = 0;
+
+    virtual io::path autoSavePath() const = 0;
 };
 }
 
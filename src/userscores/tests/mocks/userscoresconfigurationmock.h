@@ -50,6 +50,16 @@ public:
 
     MOCK_METHOD(PreferredScoreCreationMode, preferredScoreCreationMode, (), (const, override));
     MOCK_METHOD(void, setPreferredScoreCreationMode, (PreferredScoreCreationMode), (override));
+
+    MOCK_METHOD(bool, isAutoSaveEnabled, (), (const, override));
+    MOCK_METHOD(void, setAutoSaveEnabled, (bool), (override));
+    MOCK_METHOD(async::Channel<bool>, autoSaveEnabledChanged, (), (const, override));
+
+    MOCK_METHOD(int, autoSaveIntervalMinutes, (), (const, override));
+    MOCK_METHOD(void, setAutoSaveInterval, (int), (override));
+    MOCK_METHOD(async::Channel<int>, autoSaveIntervalChanged, (), (const, override));
+
+    MOCK_METHOD(io::path, autoSavePath, (), (const, override));
 };
 }
 
@@ -39,6 +39,7 @@
 #include "internal/exportscorescenario.h"
 #include "internal/templatesrepository.h"
 #include "internal/userscoresuiactions.h"
+#include "internal/scoreautosaver.h"
 
 #include "ui/iinteractiveuriregister.h"
 #include "ui/iuiactionsregister.h"
@@ -51,6 +52,7 @@ static std::shared_ptr<FileScoreController> s_fileController = std::make_shared<
 static std::shared_ptr<UserScoresConfiguration> s_userScoresConfiguration = std::make_shared<UserScoresConfiguration>();
 static std::shared_ptr<UserScoresService> s_userScoresService = std::make_shared<UserScoresService>();
 static std::shared_ptr<ExportScoreScenario> s_exportScoreScenario = std::make_shared<ExportScoreScenario>();
+static std::shared_ptr<ScoreAutoSaver> s_scoreAutoSaver = std::make_shared<ScoreAutoSaver>();
 
 static void userscores_init_qrc()
 {
@@ -115,4 +117,5 @@ void UserScoresModule::onInit(const IApplication::RunMode& mode)
     s_userScoresConfiguration->init();
     s_userScoresService->init();
     s_fileController->init();
+    s_scoreAutoSaver->init();
 }
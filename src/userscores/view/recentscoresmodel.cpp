@@ -113,7 +113,7 @@ void RecentScoresModel::updateRecentScores(const MetaList& recentScoresList)
 
         obj[SCORE_TITLE_KEY] = !meta.title.isEmpty() ? meta.title : meta.fileName.toQString();
         obj[SCORE_PATH_KEY] = meta.filePath.toQString();
-        obj[SCORE_THUMBNAIL_KEY] = meta.thumbnail;
+        obj[SCORE_THUMBNAIL_KEY] = meta.thumbnailData;
         obj[SCORE_TIME_SINCE_CREATION_KEY] = DataFormatter::formatTimeSinceCreation(meta.creationDate);
         obj[SCORE_ADD_NEW_KEY] = false;
 
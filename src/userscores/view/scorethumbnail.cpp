@@ -36,11 +36,24 @@ void ScoreThumbnail::setThumbnail(QVariant pixmap)
         return;
     }
 
-    m_thumbnail = pixmap.value<QPixmap>();
+    //! NOTE: encoded thumbnails are decoded on the first paint
+    if (pixmap.type() == QVariant::ByteArray) {
+        m_thumbnail = QPixmap();
+        m_thumbnailData = pixmap.toByteArray();
+    } else {
+        m_thumbnail = pixmap.value<QPixmap>();
+        m_thumbnailData.clear();
+    }
+
     update();
 }
 
 void ScoreThumbnail::paint(QPainter* painter)
 {
+    if (!m_thumbnailData.isEmpty()) {
+        m_thumbnail.loadFromData(m_thumbnailData, "PNG");
+        m_thumbnailData.clear();
+    }
+
     painter->drawPixmap(0, 0, width(), height(), m_thumbnail);
 }
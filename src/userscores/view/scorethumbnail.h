@@ -40,6 +40,7 @@ protected:
 
 private:
     QPixmap m_thumbnail;
+    QByteArray m_thumbnailData;
 };
 }
 
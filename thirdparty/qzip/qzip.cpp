@@ -42,12 +42,18 @@
 #include <QDir>
 #include <QDebug>
 #include <QFileInfo>
+#include <QThreadPool>
 
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
 
 #include <zlib.h>
 
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
@@ -542,6 +548,7 @@ public:
     }
 
     void scanFiles();
+    bool readEntry(const QString& fileName, QByteArray* compressed, int* method, int* uncompressedSize);
 
     MQZipReader::Status status;
 };
@@ -966,27 +973,28 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 }
 
 /*!
-    Fetch the file contents from the zip archive and return the uncompressed bytes.
+    Read the still compressed data of the entry \a fileName.
+    Returns \c false if there is no such entry or it cannot be extracted.
 */
-QByteArray MQZipReader::fileData(const QString& fileName) const
+bool MQZipReaderPrivate::readEntry(const QString& fileName, QByteArray* compressed, int* method, int* uncompressedSize)
 {
-    d->scanFiles();
+    scanFiles();
     int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
+    for (i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromUtf8(fileHeaders.at(i).file_name) == fileName) {
             break;
         }
     }
-    if (i == d->fileHeaders.size()) {
-        return QByteArray();
+    if (i == fileHeaders.size()) {
+        return false;
     }
 
-    FileHeader header = d->fileHeaders.at(i);
+    FileHeader header = fileHeaders.at(i);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+        return false;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
@@ -995,60 +1003,323 @@ QByteArray MQZipReader::fileData(const QString& fileName) const
     int start = readUInt(header.h.offset_local_header);
     //qDebug("uncompressing file %d: local header at %d", i, start);
 
-    d->device->seek(start);
+    device->seek(start);
     LocalFileHeader lh;
-    d->device->read((char*)&lh, sizeof(LocalFileHeader));
+    device->read((char*)&lh, sizeof(LocalFileHeader));
     uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
+    device->seek(device->pos() + skip);
 
     int compression_method = readUShort(lh.compression_method);
     //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+    if (compression_method != CompressionMethodStored && compression_method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return false;
+    }
+
+    //qDebug("file at %lld", device->pos());
+    *compressed = device->read(compressed_size);
+    compressed->truncate(compressed_size);
+    *method = compression_method;
+    *uncompressedSize = uncompressed_size;
+    return true;
+}
+
+/*!
+    Fetch the file contents from the zip archive and return the uncompressed bytes.
+*/
+QByteArray MQZipReader::fileData(const QString& fileName) const
+{
+    QByteArray compressed;
+    int compression_method;
+    int uncompressed_size;
+    if (!d->readEntry(fileName, &compressed, &compression_method, &uncompressed_size)) {
         return QByteArray();
     }
+    int compressed_size = compressed.size();
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
         compressed.truncate(uncompressed_size);
         return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        QByteArray baunzip;
-        ulong len = qMax(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
+    }
 
-            switch (res) {
-            case Z_OK:
-                if ((int)len != baunzip.size()) {
-                    baunzip.resize(len);
-                }
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
+    // Deflate
+    //qDebug("compressed=%d", compressed.size());
+    QByteArray baunzip;
+    ulong len = qMax(uncompressed_size,  1);
+    int res;
+    do {
+        baunzip.resize(len);
+        res = inflate((uchar*)baunzip.data(), &len,
+                      (const uchar*)compressed.constData(), compressed_size);
+
+        switch (res) {
+        case Z_OK:
+            if ((int)len != baunzip.size()) {
+                baunzip.resize(len);
+            }
+            break;
+        case Z_MEM_ERROR:
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        case Z_DATA_ERROR:
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+    return baunzip;
+}
+
+/*!
+    \internal
+    Pool shared by all entry devices, so reading many entries does not
+    start a thread for each of them.
+*/
+static QThreadPool* entryDevicePool()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+
+/*!
+    \internal
+    Sequential device over one entry of the archive.
+    The compressed data is read from the archive when the device is
+    created, so the archive may be closed afterwards. While the device
+    is open, the data is inflated into a bounded queue of chunks by
+    short jobs on a shared thread pool: a job stops when the queue is
+    full and the reader schedules the next one when it takes a chunk,
+    so no pool thread waits for a slow reader.
+*/
+class MQZipEntryDevice : public QIODevice
+{
+public:
+    MQZipEntryDevice(const QByteArray& compressed, int method, int uncompressedSize)
+        : m_compressed(compressed), m_method(method), m_size(uncompressedSize)
+    {
+    }
+
+    ~MQZipEntryDevice() override
+    {
+        close();
+    }
+
+    bool isSequential() const override { return true; }
+
+    bool open(OpenMode mode) override
+    {
+        if ((mode & QIODevice::WriteOnly) || isOpen()) {
+            return false;
+        }
+        m_chunks.clear();
+        m_offset = 0;
+        m_pos = 0;
+        m_finished = false;
+        m_failed = false;
+        m_abort = false;
+        if (m_method != CompressionMethodStored) {
+            memset(&m_stream, 0, sizeof(m_stream));
+            m_stream.next_in  = reinterpret_cast<Bytef*>(m_compressed.data());
+            m_stream.avail_in = uInt(m_compressed.size());
+            m_streamInitialized = inflateInit2(&m_stream, -MAX_WBITS) == Z_OK;
+            if (!m_streamInitialized) {
+                m_failed = true;
+                m_finished = true;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            schedule();
+        }
+        return QIODevice::open(mode | QIODevice::Unbuffered);
+    }
+
+    void close() override
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_abort = true;
+            m_cv.wait(lock, [this]() { return !m_scheduled; });
+        }
+        if (m_streamInitialized) {
+            inflateEnd(&m_stream);
+            m_streamInitialized = false;
+        }
+        QIODevice::close();
+    }
+
+    bool atEnd() const override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return !m_chunks.empty() || m_finished; });
+        return m_chunks.empty();
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        qint64 n = -m_offset;
+        for (const QByteArray& chunk : m_chunks) {
+            n += chunk.size();
+        }
+        return n + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        qint64 n = 0;
+        while (n < maxSize) {
+            // block only until there is something to return
+            if (n == 0) {
+                m_cv.wait(lock, [this]() { return !m_chunks.empty() || m_finished; });
+            }
+            if (m_chunks.empty()) {
                 break;
-            case Z_DATA_ERROR:
+            }
+            const QByteArray& chunk = m_chunks.front();
+            const qint64 k = qMin(maxSize - n, qint64(chunk.size() - m_offset));
+            memcpy(data + n, chunk.constData() + m_offset, k);
+            n        += k;
+            m_offset += int(k);
+            if (m_offset == chunk.size()) {
+                m_chunks.pop_front();
+                m_offset = 0;
+                schedule();
+            }
+        }
+        if (n == 0 && m_failed) {
+            return -1;
+        }
+        return n;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    static const int ChunkSize = 64 * 1024;
+    static const size_t MaxChunks = 16;
+
+    //! starts a job if there is room in the queue; m_mutex must be locked
+    void schedule()
+    {
+        if (m_scheduled || m_finished || m_abort || m_chunks.size() >= MaxChunks) {
+            return;
+        }
+        m_scheduled = true;
+        entryDevicePool()->start([this]() { run(); });
+    }
+
+    //! inflates the next chunk into \a chunk; returns false at the end of the data
+    bool inflateChunk(QByteArray& chunk, bool& failed)
+    {
+        if (m_method == CompressionMethodStored) {
+            const int size = qMin(m_compressed.size(), m_size);
+            if (m_pos >= size) {
+                return false;
+            }
+            chunk = m_compressed.mid(m_pos, qMin(ChunkSize, size - m_pos));
+            m_pos += chunk.size();
+            return true;
+        }
+        for (;;) {
+            chunk = QByteArray(ChunkSize, Qt::Uninitialized);
+            m_stream.next_out  = reinterpret_cast<Bytef*>(chunk.data());
+            m_stream.avail_out = ChunkSize;
+            const int res = ::inflate(&m_stream, Z_NO_FLUSH);
+            if (res != Z_OK && res != Z_STREAM_END) {
                 qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
-                break;
+                failed = true;
+                return false;
             }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
+            chunk.resize(ChunkSize - int(m_stream.avail_out));
+            if (!chunk.isEmpty()) {
+                return true;
+            }
+            if (res == Z_STREAM_END) {
+                return false;
+            }
+            if (m_stream.avail_in == 0) {
+                qWarning("QZip: Z_DATA_ERROR: Input data is truncated");
+                failed = true;
+                return false;
+            }
+        }
     }
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return QByteArray();
+    //! fills the queue; only one job runs at a time, so the stream needs no lock
+    void run()
+    {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_abort || m_chunks.size() >= MaxChunks) {
+                    m_scheduled = false;
+                    m_cv.notify_all();
+                    return;
+                }
+            }
+            QByteArray chunk;
+            bool failed = false;
+            const bool more = inflateChunk(chunk, failed);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (more) {
+                m_chunks.push_back(std::move(chunk));
+            } else {
+                m_failed = failed;
+                m_finished = true;
+                m_scheduled = false;
+            }
+            m_cv.notify_all();
+            if (!more) {
+                return;
+            }
+        }
+    }
+
+    QByteArray m_compressed;
+    int m_method;
+    int m_size;
+
+    z_stream m_stream;
+    bool m_streamInitialized = false;
+    int m_pos = 0;                    // read position in m_compressed for stored entries
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_cv;
+    std::deque<QByteArray> m_chunks;
+    int m_offset = 0;                 // read position in m_chunks.front()
+    bool m_scheduled = false;         // a job is queued or running
+    bool m_finished = false;
+    bool m_failed = false;
+    bool m_abort = false;
+};
+
+/*!
+    Returns a sequential device which delivers the uncompressed contents
+    of \a fileName while they are inflated on a shared thread pool, or \c nullptr
+    if the file cannot be extracted. The device is not open; the caller owns
+    it and may use it after the archive is closed.
+*/
+QIODevice* MQZipReader::fileDevice(const QString& fileName) const
+{
+    QByteArray compressed;
+    int compression_method;
+    int uncompressed_size;
+    if (!d->readEntry(fileName, &compressed, &compression_method, &uncompressed_size)) {
+        return nullptr;
+    }
+    return new MQZipEntryDevice(compressed, compression_method, uncompressed_size);
 }
 
 /*!
@@ -0,0 +1,73 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: GPL-3.0-only
+# MuseScore-CLA-applies
+#
+# MuseScore
+# Music Composition & Notation
+#
+# Copyright (C) 2021 MuseScore BVBA and others
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 3 as
+# published by the Free Software Foundation.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+echo "MuseScore Benchmark"
+
+HERE="$(dirname ${BASH_SOURCE[0]})"
+SCORES_DIRS="$HERE/scores $HERE/../mtest"
+ARTIFACTS_DIR=benchmark.artifacts
+MSCORE_BIN=build.release/install/bin/mscore
+BASELINE=""
+THRESHOLD=10
+
+while [[ "$#" -gt 0 ]]; do
+    case $1 in
+        -s|--scores) SCORES_DIRS="$2"; shift ;;
+        -a|--artifacts) ARTIFACTS_DIR="$2"; shift ;;
+        -m|--mscore) MSCORE_BIN="$2"; shift ;;
+        -b|--baseline) BASELINE="$2"; shift ;;
+        -t|--threshold) THRESHOLD="$2"; shift ;;
+        *) echo "Unknown parameter passed: $1"; exit 1 ;;
+    esac
+    shift
+done
+
+echo "SCORES_DIRS: $SCORES_DIRS"
+echo "ARTIFACTS_DIR: $ARTIFACTS_DIR"
+echo "MSCORE_BIN: $MSCORE_BIN"
+echo "BASELINE: $BASELINE"
+echo "THRESHOLD: $THRESHOLD"
+
+mkdir -p $ARTIFACTS_DIR
+
+JSON_FILE=$ARTIFACTS_DIR/benchmarkjob.json
+REPORT_FILE=$ARTIFACTS_DIR/benchmark.json
+LOG_FILE=$ARTIFACTS_DIR/benchmark.log
+
+echo "Generate JSON job file"
+rm -f $JSON_FILE
+echo "[" >> $JSON_FILE
+for dir in $SCORES_DIRS ; do
+    for score in $(find $dir -name "*.mscx" -o -name "*.mscz" | sort) ; do
+        echo "\"$score\"," >> $JSON_FILE;
+    done
+done
+echo "\"\"]" >> $JSON_FILE
+
+echo "Run benchmark"
+BASELINE_ARGS=""
+if [ -n "$BASELINE" ]; then BASELINE_ARGS="--benchmark-baseline $BASELINE --benchmark-threshold $THRESHOLD"; fi
+
+$MSCORE_BIN --benchmark $JSON_FILE -o $REPORT_FILE $BASELINE_ARGS >$LOG_FILE 2>&1
+code=$?
+
+grep "regression:" $LOG_FILE
+echo "Report: $REPORT_FILE"
+exit $code